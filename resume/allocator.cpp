@@ -0,0 +1,276 @@
+#include "allocator.hpp"
+
+#include "imgui.h"
+#include <float.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten/heap.h>
+#endif
+
+#include "../Utilities/defer.hpp"
+
+Allocator_Stats allocator_stats;
+
+// NOTE(WALKER): 16 bytes in front of every block keeps the user pointer 16 byte aligned (pages and malloc are) and tells
+//               free() where the block came from without any lookup.
+struct alignas(16) Block_Header {
+    uint64_t size;       // requested size
+    uint32_t size_class; // index into size_classes, or LARGE_BLOCK
+    uint32_t magic;
+};
+static_assert(sizeof(Block_Header) == 16, "block header must keep 16 byte alignment");
+
+static constexpr uint32_t LARGE_BLOCK  = 0xFFFFFFFFu;
+static constexpr uint32_t BLOCK_MAGIC  = 0x5A110C8Du;
+static constexpr uint32_t FREED_MAGIC  = 0xDEADB10Cu;
+
+// 16 byte steps up to 128, then 4 classes per power of two (<= 25% waste)
+static constexpr uint32_t size_classes[] = {
+    16, 32, 48, 64, 80, 96, 112, 128,
+    160, 192, 224, 256,
+    320, 384, 448, 512,
+    640, 768, 896, 1024,
+    1280, 1536, 1792, 2048,
+    2560, 3072, 3584, 4096,
+};
+static constexpr int SIZE_CLASS_COUNT = sizeof(size_classes) / sizeof(size_classes[0]);
+static_assert(size_classes[SIZE_CLASS_COUNT - 1] == POOL_MAX_BLOCK, "last size class must be POOL_MAX_BLOCK");
+
+struct Free_Block { Free_Block* next; };
+
+static Free_Block*      free_lists[SIZE_CLASS_COUNT];
+static uint8_t          class_lookup[POOL_MAX_BLOCK / 16 + 1]; // (size + 15) / 16 -> size class
+static std::atomic_flag pool_lock = ATOMIC_FLAG_INIT;          // ImGui allocates from the main thread, but IM_ALLOC() might not
+
+static void lock()   { while (pool_lock.test_and_set(std::memory_order_acquire)) {} }
+static void unlock() { pool_lock.clear(std::memory_order_release); }
+
+static void note_heap_alloc(size_t bytes) {
+    Allocator_Stats& s = allocator_stats;
+    ++s.frame_heap_allocs;
+    ++s.total_heap_allocs;
+    s.heap_bytes += bytes;
+    if (s.heap_bytes > s.peak_heap_bytes) s.peak_heap_bytes = s.heap_bytes;
+}
+
+static void note_heap_free(size_t bytes) {
+    allocator_stats.heap_bytes -= bytes;
+}
+
+// The arena is main thread only, but the heap counters are shared with the pool
+static void note_heap_alloc_locked(size_t bytes) { lock(); note_heap_alloc(bytes); unlock(); }
+static void note_heap_free_locked(size_t bytes)  { lock(); note_heap_free(bytes);  unlock(); }
+
+// Carves a fresh page into blocks of one class, called with the lock held
+static bool pool_grow(int size_class) {
+    void* page = malloc(POOL_PAGE_SIZE);
+    if (!page) return false;
+    note_heap_alloc(POOL_PAGE_SIZE);
+    ++allocator_stats.pool_pages;
+
+    const size_t block_size = sizeof(Block_Header) + size_classes[size_class];
+    const size_t count      = POOL_PAGE_SIZE / block_size;
+    char* p = (char*)page;
+    for (size_t i = 0; i < count; ++i, p += block_size) {
+        Free_Block* block = (Free_Block*)p;
+        block->next = free_lists[size_class];
+        free_lists[size_class] = block;
+    }
+    return true;
+}
+
+static void* pool_alloc(size_t size, void*) {
+    if (size == 0) size = 1;
+    lock();
+    defer { unlock(); };
+
+    Allocator_Stats& s = allocator_stats;
+    ++s.frame_allocs;
+    ++s.total_allocs;
+    s.frame_bytes += size;
+    s.total_bytes += size;
+
+    Block_Header* header = nullptr;
+    if (size <= POOL_MAX_BLOCK && s.pool_enabled) {
+        const int size_class = class_lookup[(size + 15) / 16];
+        if (!free_lists[size_class] && !pool_grow(size_class)) return nullptr;
+        Free_Block* block = free_lists[size_class];
+        free_lists[size_class] = block->next;
+        header = (Block_Header*)block;
+        header->size_class = (uint32_t)size_class;
+    } else {
+        header = (Block_Header*)malloc(sizeof(Block_Header) + size);
+        if (!header) return nullptr;
+        note_heap_alloc(sizeof(Block_Header) + size);
+        header->size_class = LARGE_BLOCK;
+    }
+    header->size  = size;
+    header->magic = BLOCK_MAGIC;
+
+    s.live_bytes += size;
+    if (s.live_bytes > s.peak_live_bytes) s.peak_live_bytes = s.live_bytes;
+    return header + 1;
+}
+
+static void pool_free(void* ptr, void*) {
+    if (!ptr) return;
+    Block_Header* header = (Block_Header*)ptr - 1;
+    IM_ASSERT(header->magic == BLOCK_MAGIC && "not ours, or freed twice");
+
+    lock();
+    defer { unlock(); };
+
+    Allocator_Stats& s = allocator_stats;
+    ++s.frame_frees;
+    s.live_bytes -= (size_t)header->size;
+    header->magic = FREED_MAGIC;
+
+    if (header->size_class == LARGE_BLOCK) {
+        note_heap_free(sizeof(Block_Header) + (size_t)header->size);
+        free(header);
+        return;
+    }
+    Free_Block* block = (Free_Block*)header;
+    block->next = free_lists[header->size_class];
+    free_lists[header->size_class] = block;
+}
+
+void allocator_install() {
+    static bool lookup_built = false;
+    if (!lookup_built) {
+        int size_class = 0;
+        for (size_t i = 0; i <= POOL_MAX_BLOCK / 16; ++i) {
+            while (size_classes[size_class] < i * 16) ++size_class;
+            class_lookup[i] = (uint8_t)size_class;
+        }
+        lookup_built = true;
+    }
+    ImGui::SetAllocatorFunctions(pool_alloc, pool_free, nullptr);
+}
+
+//-----------------------------------------------------------------------------
+// Frame arena
+//-----------------------------------------------------------------------------
+
+struct Arena_Overflow {
+    Arena_Overflow* next;
+    size_t          size;
+};
+
+static constexpr size_t ARENA_INITIAL_CAPACITY = 64 * 1024;
+
+static char*           arena_base      = nullptr;
+static Arena_Overflow* arena_overflows = nullptr; // chunks for this frame only, folded into the main block next frame
+
+void* frame_arena_alloc(size_t size, size_t alignment) {
+    Allocator_Stats& s = allocator_stats;
+    if (!arena_base) {
+        arena_base = (char*)malloc(ARENA_INITIAL_CAPACITY);
+        if (!arena_base) return nullptr;
+        note_heap_alloc_locked(ARENA_INITIAL_CAPACITY);
+        s.arena_capacity = ARENA_INITIAL_CAPACITY;
+    }
+
+    const size_t offset = (s.arena_used + alignment - 1) & ~(alignment - 1);
+    if (offset + size <= s.arena_capacity) {
+        s.arena_used = offset + size;
+        return arena_base + offset;
+    }
+
+    // Doesn't fit: give this request its own chunk, count it as used so the main block grows to fit next frame
+    ++s.arena_overflows;
+    const size_t chunk_size = sizeof(Arena_Overflow) + size + alignment;
+    Arena_Overflow* chunk = (Arena_Overflow*)malloc(chunk_size);
+    if (!chunk) return nullptr;
+    note_heap_alloc_locked(chunk_size);
+    chunk->next = arena_overflows;
+    chunk->size = chunk_size;
+    arena_overflows = chunk;
+    s.arena_used = offset + size;
+    const uintptr_t data = ((uintptr_t)(chunk + 1) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    return (void*)data;
+}
+
+static void frame_arena_reset() {
+    Allocator_Stats& s = allocator_stats;
+    s.arena_last_used = s.arena_used;
+    if (s.arena_used > s.arena_peak) s.arena_peak = s.arena_used;
+
+    if (arena_overflows) {
+        while (arena_overflows) {
+            Arena_Overflow* next = arena_overflows->next;
+            note_heap_free_locked(arena_overflows->size);
+            free(arena_overflows);
+            arena_overflows = next;
+        }
+        // One reallocation now instead of overflow chunks every frame from here on
+        size_t capacity = s.arena_capacity;
+        while (capacity < s.arena_used) capacity *= 2;
+        char* grown = (char*)malloc(capacity);
+        if (grown) {
+            free(arena_base);
+            note_heap_free_locked(s.arena_capacity);
+            note_heap_alloc_locked(capacity);
+            arena_base = grown;
+            s.arena_capacity = capacity;
+        }
+    }
+    s.arena_used = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Frames + UI
+//-----------------------------------------------------------------------------
+
+void allocator_new_frame() {
+    frame_arena_reset();
+
+    lock();
+    defer { unlock(); };
+    Allocator_Stats& s = allocator_stats;
+    if (s.frames > 0) {
+        if (s.frame_heap_allocs) { ++s.heap_alloc_frames; s.steady_frames = 0; }
+        else                     { ++s.steady_frames; }
+    }
+    s.last_allocs       = s.frame_allocs;
+    s.last_frees        = s.frame_frees;
+    s.last_bytes        = s.frame_bytes;
+    s.last_heap_allocs  = s.frame_heap_allocs;
+    s.frame_allocs      = 0;
+    s.frame_frees       = 0;
+    s.frame_bytes       = 0;
+    s.frame_heap_allocs = 0;
+
+    if (s.frames % ALLOCATOR_HISTORY_INTERVAL == 0) {
+        if (s.history_count == ALLOCATOR_HISTORY_SAMPLES) {
+            memmove(s.history, s.history + 1, sizeof(float) * (ALLOCATOR_HISTORY_SAMPLES - 1));
+            --s.history_count;
+        }
+        s.history[s.history_count++] = (float)((double)s.heap_bytes / 1024.0);
+    }
+    ++s.frames;
+}
+
+void allocator_show_menu() {
+    const Allocator_Stats& s = allocator_stats;
+    ImGui::Checkbox("Pooled ImGui allocations", &allocator_stats.pool_enabled);
+    ImGui::SetItemTooltip("Off: new allocations go straight to malloc, to compare against the pool");
+    ImGui::Text("Allocs/frame:    %u allocs, %u frees, %.1f KB, %u reached malloc", s.last_allocs, s.last_frees, s.last_bytes / 1024.0, s.last_heap_allocs);
+    ImGui::Text("Steady frames:   %llu in a row without malloc (%llu of %llu frames did malloc)", s.steady_frames, s.heap_alloc_frames, s.frames);
+    ImGui::Text("Live:            %.1f KB (peak %.1f KB), %llu allocs total", s.live_bytes / 1024.0, s.peak_live_bytes / 1024.0, s.total_allocs);
+    ImGui::Text("Heap held:       %.1f KB (peak %.1f KB), %zu pool pages", s.heap_bytes / 1024.0, s.peak_heap_bytes / 1024.0, s.pool_pages);
+    ImGui::Text("Frame arena:     %.1f / %.1f KB last frame (peak %.1f KB), %llu overflows", s.arena_last_used / 1024.0, s.arena_capacity / 1024.0, s.arena_peak / 1024.0, s.arena_overflows);
+#ifdef __EMSCRIPTEN__
+    ImGui::Text("Wasm memory:     %.1f MB", emscripten_get_heap_size() / (1024.0 * 1024.0));
+#endif
+    if (s.history_count > 1) {
+        char overlay[64];
+        snprintf(overlay, sizeof(overlay), "heap KB, %+.1f KB since first sample", s.history[s.history_count - 1] - s.history[0]);
+        ImGui::PlotLines("##heap history", s.history, s.history_count, 0, overlay, 0.0f, FLT_MAX, ImVec2(360, 50));
+    }
+}
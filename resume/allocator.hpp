@@ -0,0 +1,74 @@
+// NOTE(WALKER): Allocator layer for everything that goes through ImGui's allocator (ImGui itself, IM_ALLOC(), ImVector).
+//               allocator_install() hooks ImGui::SetAllocatorFunctions() up to:
+//                 - a size-class pool for blocks up to POOL_MAX_BLOCK bytes: 64 KB pages from malloc, carved into fixed size
+//                   blocks with one free list per class. Freed blocks go back on their list and pages are never given back,
+//                   so once the UI has warmed up ImGui's vector growth/shrink churn never reaches malloc again.
+//                 - malloc for anything bigger (font atlas pixels, the content buffer), with the same 16 byte header so
+//                   stats and frees work the same way.
+//               The frame arena is separate: a bump allocator for our own scratch memory that only has to live until the
+//               end of the frame (sort buffers, temporary copies). It's reset by allocator_new_frame() and grows once to fit
+//               the biggest frame seen, so steady-state frames do zero heap allocations.
+//               Every allocation is counted per frame and over the whole session (peak live bytes, heap bytes, heap growth),
+//               shown in the "Performance" menu, and checked by `resume_headless --soak`.
+
+#pragma once
+
+#include "imgui.h"
+#include <stddef.h>
+
+constexpr size_t POOL_MAX_BLOCK = 4096;
+constexpr size_t POOL_PAGE_SIZE = 64 * 1024;
+constexpr int    ALLOCATOR_HISTORY_SAMPLES = 240; // heap size samples for the growth plot
+constexpr int    ALLOCATOR_HISTORY_INTERVAL = 60; // frames between samples
+
+struct Allocator_Stats {
+    bool pool_enabled = true; // false -> every new allocation goes straight to malloc (frees still work either way)
+
+    // Current frame (reset by allocator_new_frame()) and the last complete frame
+    unsigned int frame_allocs      = 0; // ImGui allocator calls
+    unsigned int frame_frees       = 0;
+    size_t       frame_bytes       = 0; // bytes requested
+    unsigned int frame_heap_allocs = 0; // calls that reached malloc (new pool page, big block, arena growth)
+    unsigned int last_allocs       = 0;
+    unsigned int last_frees        = 0;
+    size_t       last_bytes        = 0;
+    unsigned int last_heap_allocs  = 0;
+
+    // Session
+    unsigned long long frames            = 0;
+    unsigned long long total_allocs      = 0;
+    unsigned long long total_bytes       = 0;
+    unsigned long long total_heap_allocs = 0;
+    unsigned long long heap_alloc_frames = 0; // frames that reached malloc at least once
+    unsigned long long steady_frames     = 0; // frames in a row that didn't
+    size_t live_bytes      = 0; // requested bytes currently handed out
+    size_t peak_live_bytes = 0;
+    size_t heap_bytes      = 0; // bytes currently held from malloc (pool pages + big blocks + arena)
+    size_t peak_heap_bytes = 0;
+    size_t pool_pages      = 0;
+
+    // Frame arena
+    size_t arena_capacity   = 0;
+    size_t arena_used       = 0;
+    size_t arena_last_used  = 0;
+    size_t arena_peak       = 0;
+    unsigned long long arena_overflows = 0;
+
+    float history[ALLOCATOR_HISTORY_SAMPLES] = {}; // heap_bytes in KB, oldest first once full
+    int   history_count = 0;
+};
+
+extern Allocator_Stats allocator_stats;
+
+// Before ImGui::CreateContext(). Safe to call again (e.g. one context per benchmark scenario).
+void allocator_install();
+
+// Once per rendered frame, before ImGui::NewFrame(): closes the frame's counters and resets the frame arena.
+void allocator_new_frame();
+
+// Bump allocation, valid until the next allocator_new_frame(). Main thread only.
+void* frame_arena_alloc(size_t size, size_t alignment = 16);
+template <typename T> T* frame_arena_alloc_array(int count) { return (T*)frame_arena_alloc(sizeof(T) * (size_t)count, alignof(T) > 16 ? alignof(T) : 16); }
+
+// Stats for the "Performance" menu
+void allocator_show_menu();
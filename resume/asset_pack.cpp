@@ -0,0 +1,165 @@
+#include "asset_pack.hpp"
+
+#include "imgui.h"
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+#include "../Utilities/defer.hpp"
+
+// NOTE(WALKER): No profiler.hpp, tools/atlas_baker links this (through fonts.cpp) without the rest of the app
+static double pack_now_ms() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool asset_pack_fail(const char* why) {
+    fprintf(stderr, "[asset_pack] invalid pack: %s\n", why);
+    return false;
+}
+
+static void asset_pack_account(Asset_Pack& pack, ptrdiff_t bytes) {
+    pack.heap_bytes = (size_t)((ptrdiff_t)pack.heap_bytes + bytes);
+    if (pack.heap_bytes > pack.heap_peak) pack.heap_peak = pack.heap_bytes;
+}
+
+bool asset_pack_load_from_memory(Asset_Pack& pack, const void* data, size_t size) {
+    const unsigned char* base = (const unsigned char*)data;
+    if (!data || size < sizeof(Pack_Header)) return asset_pack_fail("too small");
+    if (((uintptr_t)data & 3) != 0)          return asset_pack_fail("buffer not 4 byte aligned");
+
+    const Pack_Header* h = (const Pack_Header*)base;
+    if (h->magic != PACK_MAGIC)              return asset_pack_fail("bad magic");
+    if (h->version != PACK_VERSION)          return asset_pack_fail("version mismatch, rebuild with tools/asset_packer");
+    if (h->total_size != size)               return asset_pack_fail("size mismatch");
+    if ((uint64_t)sizeof(Pack_Header) + (uint64_t)h->entry_count * sizeof(Pack_Entry) > h->names_offset || h->names_offset > size)
+        return asset_pack_fail("index out of range");
+
+    const Pack_Entry* entries = (const Pack_Entry*)(base + sizeof(Pack_Header));
+    size_t raw_size = 0;
+    for (uint32_t i = 0; i < h->entry_count; ++i) {
+        const Pack_Entry& e = entries[i];
+        if ((uint64_t)h->names_offset + e.name_offset + e.name_length > size) return asset_pack_fail("name out of range");
+        if ((e.offset & 3) != 0 || (uint64_t)e.offset + e.packed_size > size) return asset_pack_fail("entry out of range");
+        if (e.codec > Pack_Codec_LZ)                                          return asset_pack_fail("unknown codec");
+        if (e.codec == Pack_Codec_Stored && e.packed_size != e.size)          return asset_pack_fail("bad stored entry");
+        raw_size += e.size;
+    }
+
+    pack.header   = h;
+    pack.entries  = entries;
+    pack.names    = (const char*)base + h->names_offset;
+    pack.items    = (Asset_Pack_Item*)IM_ALLOC(sizeof(Asset_Pack_Item) * (h->entry_count ? h->entry_count : 1));
+    for (uint32_t i = 0; i < h->entry_count; ++i) IM_PLACEMENT_NEW(&pack.items[i]) Asset_Pack_Item();
+    pack.size     = size;
+    pack.raw_size = raw_size;
+    return true;
+}
+
+bool asset_pack_load_file(Asset_Pack& pack, const char* path) {
+    const double start = pack_now_ms();
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "[asset_pack] can't open %s\n", path);
+        return false;
+    }
+    defer { fclose(f); };
+    fseek(f, 0, SEEK_END);
+    const long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size <= 0) return asset_pack_fail("empty file");
+
+    void* buffer = IM_ALLOC((size_t)size); // ImGui's allocator hands out pointer aligned memory
+    if (fread(buffer, 1, (size_t)size, f) != (size_t)size || !asset_pack_load_from_memory(pack, buffer, (size_t)size)) {
+        IM_FREE(buffer);
+        return false;
+    }
+    pack.owned   = buffer;
+    pack.load_ms = pack_now_ms() - start;
+    asset_pack_account(pack, (ptrdiff_t)size);
+    return true;
+}
+
+void asset_pack_free(Asset_Pack& pack) {
+    if (pack.items) {
+        for (uint32_t i = 0; i < pack.header->entry_count; ++i)
+            if (pack.entries[i].codec != Pack_Codec_Stored && pack.items[i].data) IM_FREE(pack.items[i].data);
+        IM_FREE(pack.items);
+    }
+    if (pack.owned) IM_FREE(pack.owned);
+    pack = Asset_Pack();
+}
+
+int asset_pack_find(const Asset_Pack& pack, const char* name) {
+    if (!pack.header) return -1;
+    const size_t length = strlen(name);
+    for (uint32_t i = 0; i < pack.header->entry_count; ++i) {
+        const Pack_Entry& e = pack.entries[i];
+        if (e.name_length == length && memcmp(pack.names + e.name_offset, name, length) == 0) return (int)i;
+    }
+    return -1;
+}
+
+const void* asset_pack_get(Asset_Pack& pack, int index, size_t* size) {
+    if (!pack.header || index < 0 || index >= (int)pack.header->entry_count) return nullptr;
+    const Pack_Entry& e = pack.entries[index];
+    Asset_Pack_Item& item = pack.items[index];
+    if (size) *size = e.size;
+    if (item.data || item.failed) return item.data;
+
+    const double start = pack_now_ms();
+    const uint8_t* src = (const uint8_t*)pack.header + e.offset;
+    void* data = (void*)src;
+    if (e.codec == Pack_Codec_LZ) {
+        data = IM_ALLOC(e.size ? e.size : 1);
+        if (!pack_lz_decompress(src, e.packed_size, (uint8_t*)data, e.size)) {
+            IM_FREE(data);
+            data = nullptr;
+        }
+    }
+    if (data && pack_checksum(data, e.size) != e.checksum) {
+        if (data != src) IM_FREE(data);
+        data = nullptr;
+    }
+    item.decompress_ms = pack_now_ms() - start;
+    if (!data) {
+        item.failed = true;
+        fprintf(stderr, "[asset_pack] entry %.*s is corrupt\n", (int)e.name_length, pack.names + e.name_offset);
+        return nullptr;
+    }
+
+    item.data = data;
+    ++pack.entries_loaded;
+    pack.decompress_ms += item.decompress_ms;
+    if (data != src) {
+        pack.decompressed += e.size;
+        asset_pack_account(pack, (ptrdiff_t)e.size);
+    }
+    return data;
+}
+
+static double asset_pack_kb(size_t bytes) { return bytes / 1024.0; }
+
+// NOTE(WALKER): Shown in the menu bar "Performance" menu (through fonts_show_menu() for the font pack)
+void asset_pack_show_menu(const Asset_Pack& pack) {
+    if (!pack.header) {
+        ImGui::TextDisabled("Asset pack:      none, files read one by one");
+        return;
+    }
+    ImGui::Text("Asset pack:      %.1f KB for %.1f KB of files (%.0f%%), %d/%d entries loaded",
+                asset_pack_kb(pack.size), asset_pack_kb(pack.raw_size), pack.raw_size ? 100.0 * pack.size / pack.raw_size : 100.0,
+                pack.entries_loaded, (int)pack.header->entry_count);
+    ImGui::Text("Decompression:   %.2f ms for %.1f KB (read %.2f ms)", pack.decompress_ms, asset_pack_kb(pack.decompressed), pack.load_ms);
+    ImGui::Text("Pack heap:       %.1f KB now, peak %.1f KB (raw files alone %.1f KB)",
+                asset_pack_kb(pack.heap_bytes), asset_pack_kb(pack.heap_peak), asset_pack_kb(pack.raw_size));
+    for (uint32_t i = 0; i < pack.header->entry_count; ++i) {
+        const Pack_Entry& e = pack.entries[i];
+        const Asset_Pack_Item& item = pack.items[i];
+        ImGui::BulletText("%.*s: %.1f -> %.1f KB %s, %s", (int)e.name_length, pack.names + e.name_offset,
+                          asset_pack_kb(e.packed_size), asset_pack_kb(e.size), e.codec == Pack_Codec_LZ ? "lz" : "stored",
+                          item.failed ? "corrupt" : item.data ? "loaded" : "not needed yet");
+        if (item.data && e.codec == Pack_Codec_LZ) {
+            ImGui::SameLine();
+            ImGui::Text("(%.2f ms)", item.decompress_ms);
+        }
+    }
+}
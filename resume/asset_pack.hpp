@@ -0,0 +1,53 @@
+// NOTE(WALKER): Asset pack reader (layout in asset_pack_format.hpp, written by tools/asset_packer).
+//               The pack is one buffer and stays one buffer: opening it only checks the index, nothing is copied out.
+//               asset_pack_get() decompresses an entry the first time it's asked for (stored entries are handed out in
+//               place) and keeps it until asset_pack_free(), so a face streamed in three frames later costs nothing before.
+//
+//               Stats for the "Performance" menu: what came over the wire, how long decompressing took, and the heap the
+//               pack has held at its peak (compressed buffer + everything decompressed so far), next to the raw size the
+//               same files would have taken as separate preloads.
+
+#pragma once
+
+#include "asset_pack_format.hpp"
+
+struct Asset_Pack_Item {
+    void*  data    = nullptr; // decompressed (owned) or pointing into the pack (stored entries)
+    bool   failed  = false;   // bad data or bad checksum, never retried
+    double decompress_ms = 0.0;
+};
+
+struct Asset_Pack {
+    const Pack_Header* header  = nullptr;
+    const Pack_Entry*  entries = nullptr;
+    const char*        names   = nullptr;
+    Asset_Pack_Item*   items   = nullptr; // one per entry
+    void*              owned   = nullptr; // set when asset_pack_load_file() allocated the buffer
+    size_t             size    = 0;
+
+    // Stats
+    size_t raw_size          = 0; // every entry decompressed
+    size_t decompressed      = 0; // bytes decompressed so far (not counting stored entries)
+    int    entries_loaded    = 0;
+    double decompress_ms     = 0.0;
+    size_t heap_bytes        = 0; // the buffer (when owned) + decompressed entries
+    size_t heap_peak         = 0;
+    double load_ms           = 0.0; // asset_pack_load_file(): reading the file into the buffer
+};
+
+// Validates the header and index in place, the buffer must outlive the pack.
+bool asset_pack_load_from_memory(Asset_Pack& pack, const void* data, size_t size);
+
+// Reads the whole file into one allocation and loads it in place.
+bool asset_pack_load_file(Asset_Pack& pack, const char* path);
+void asset_pack_free(Asset_Pack& pack);
+
+// Index of the entry called name, -1 when there's none
+int asset_pack_find(const Asset_Pack& pack, const char* name);
+
+// The entry's bytes, decompressed and checked on the first call. nullptr if it doesn't decompress or match its checksum.
+// The memory belongs to the pack.
+const void* asset_pack_get(Asset_Pack& pack, int index, size_t* size);
+
+// Pack stats for the "Performance" menu
+void asset_pack_show_menu(const Asset_Pack& pack);
@@ -0,0 +1,100 @@
+// NOTE(WALKER): Binary layout of an asset pack (gen/assets/fonts.pack): several files in one blob, each compressed on its own.
+//               Written by the build tool (tools/asset_packer.cpp) and read in place by asset_pack.cpp: the whole pack is
+//               one buffer, the index at the front says where every entry is, and an entry is only decompressed the first
+//               time somebody asks for it. No ImGui in here.
+//
+//               [Pack_Header][Pack_Entry * entry_count][names][entry data...]
+//
+//               Entry data is either stored as is or LZ compressed (Pack_Codec_LZ, below). The checksum is over the
+//               uncompressed bytes, so a bad decoder and a bad download are caught the same way.
+//               Everything is 4 byte aligned little endian PODs, entry data starts on a 4 byte boundary.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+constexpr uint32_t PACK_MAGIC   = 0x4B415052; // "RPAK"
+constexpr uint16_t PACK_VERSION = 1;
+
+enum Pack_Codec : uint8_t {
+    Pack_Codec_Stored = 0, // compressing didn't make it smaller
+    Pack_Codec_LZ     = 1,
+};
+
+struct Pack_Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t entry_count;
+    uint32_t total_size;
+    uint32_t names_offset;
+};
+
+struct Pack_Entry {
+    uint32_t name_offset;     // into the names, not 0 terminated
+    uint16_t name_length;
+    uint8_t  codec;
+    uint8_t  reserved;
+    uint32_t offset;          // from the start of the pack
+    uint32_t packed_size;     // bytes at offset
+    uint32_t size;            // once decompressed
+    uint32_t checksum;        // pack_checksum() of the decompressed bytes
+};
+
+static_assert(sizeof(Pack_Header) == 16, "Pack_Header layout changed, bump PACK_VERSION");
+static_assert(sizeof(Pack_Entry)  == 24, "Pack_Entry layout changed, bump PACK_VERSION");
+
+// FNV-1a, 32 bit
+inline uint32_t pack_checksum(const void* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (const uint8_t* p = (const uint8_t*)data, *end = p + size; p < end; ++p)
+        hash = (hash ^ *p) * 16777619u;
+    return hash;
+}
+
+// NOTE(WALKER): Pack_Codec_LZ is a byte oriented LZ77, the same sequence layout as an LZ4 block:
+//               [token][literal length bytes][literals][match offset, 2 bytes LE][match length bytes]
+//               token high nibble = literal count, low nibble = match length - PACK_LZ_MIN_MATCH, 15 in either means more
+//               length bytes follow (each adds 0..255, a byte under 255 ends it). The last sequence is literals only.
+//               No entropy coding, decoding is a copy loop: it's here to cut the download without costing frames.
+constexpr int PACK_LZ_MIN_MATCH  = 4;
+constexpr int PACK_LZ_MAX_OFFSET = 65535;
+
+// Returns false on anything malformed instead of reading or writing out of bounds (the pack comes over the network)
+inline bool pack_lz_decompress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size) {
+    const uint8_t* ip = src;
+    const uint8_t* const ip_end = src + src_size;
+    uint8_t* op = dst;
+    uint8_t* const op_end = dst + dst_size;
+    auto read_length = [&](size_t& length) {
+        if (length != 15) return true;
+        for (;;) {
+            if (ip >= ip_end) return false;
+            const uint8_t b = *ip++;
+            length += b;
+            if (b != 255) return true;
+        }
+    };
+    while (ip < ip_end) {
+        const uint8_t token = *ip++;
+        size_t literals = token >> 4;
+        if (!read_length(literals)) return false;
+        if ((size_t)(ip_end - ip) < literals || (size_t)(op_end - op) < literals) return false;
+        for (size_t i = 0; i < literals; ++i) op[i] = ip[i];
+        ip += literals;
+        op += literals;
+        if (ip == ip_end) break; // last sequence
+
+        if (ip_end - ip < 2) return false;
+        const size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        size_t match = token & 15;
+        if (!read_length(match)) return false;
+        match += PACK_LZ_MIN_MATCH;
+        if (offset == 0 || offset > (size_t)(op - dst) || (size_t)(op_end - op) < match) return false;
+        const uint8_t* from = op - offset;
+        for (size_t i = 0; i < match; ++i) op[i] = from[i]; // byte by byte, matches may overlap their own output
+        op += match;
+    }
+    return op == op_end;
+}
@@ -0,0 +1,568 @@
+#include "content.hpp"
+#include "text_layout_cache.hpp"
+#include "retained_draw.hpp"
+#include "profiler.hpp"
+#include "search.hpp"
+
+#include "imgui.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../Utilities/defer.hpp"
+
+static bool content_string_valid(const Content_Header* h, const char* strings, Content_String s) {
+    return (uint64_t)s.offset + s.length < h->string_bytes && strings[s.offset + s.length] == '\0';
+}
+
+static bool content_fail(const char* why) {
+    fprintf(stderr, "[content] invalid content file: %s\n", why);
+    return false;
+}
+
+bool content_load_from_memory(Content& content, const void* data, size_t size) {
+    const unsigned char* base = (const unsigned char*)data;
+    if (!data || size < sizeof(Content_Header))  return content_fail("too small");
+    if (((uintptr_t)data & 3) != 0)              return content_fail("buffer not 4 byte aligned");
+
+    const Content_Header* h = (const Content_Header*)base;
+    if (h->magic != CONTENT_MAGIC)               return content_fail("bad magic");
+    if (h->version != CONTENT_VERSION)           return content_fail("version mismatch, rebuild with tools/content_compiler");
+    if (h->total_size != size)                   return content_fail("size mismatch");
+
+    auto range_ok = [&](uint32_t offset, uint64_t count, size_t stride) {
+        return (offset & 3) == 0 && (uint64_t)offset + count * stride <= size;
+    };
+    if (!range_ok(h->section_offset, h->section_count, sizeof(Content_Section))) return content_fail("sections out of range");
+    if (!range_ok(h->node_offset,    h->node_count,    sizeof(Content_Node)))    return content_fail("nodes out of range");
+    if (!range_ok(h->span_offset,    h->span_count,    sizeof(Content_Span)))    return content_fail("spans out of range");
+    if ((uint64_t)h->string_offset + h->string_bytes > size)                     return content_fail("strings out of range");
+
+    const Content_Section* sections = (const Content_Section*)(base + h->section_offset);
+    const Content_Node*    nodes    = (const Content_Node*)(base + h->node_offset);
+    const Content_Span*    spans    = (const Content_Span*)(base + h->span_offset);
+    const char*            strings  = (const char*)(base + h->string_offset);
+
+    // NOTE(WALKER): Validate everything once here so the renderer never has to bounds check
+    for (uint32_t i = 0; i < h->section_count; ++i) {
+        const auto& s = sections[i];
+        if (!content_string_valid(h, strings, s.name) || s.first_node > s.end_node || s.end_node > h->node_count)
+            return content_fail("bad section");
+    }
+    for (uint32_t i = 0; i < h->node_count; ++i) {
+        const auto& n = nodes[i];
+        if (n.kind > Content_Kind_NewLine || n.end <= i || n.end > h->node_count)         return content_fail("bad node");
+        if ((uint64_t)n.first_span + n.span_count > h->span_count)                        return content_fail("bad node spans");
+        if (n.kind == Content_Kind_Node && !content_string_valid(h, strings, n.label))    return content_fail("bad node label");
+    }
+    for (uint32_t i = 0; i < h->span_count; ++i) {
+        const auto& s = spans[i];
+        if (s.kind > Content_Span_Link || !content_string_valid(h, strings, s.text))      return content_fail("bad span");
+        if (s.kind == Content_Span_Link && !content_string_valid(h, strings, s.url))      return content_fail("bad span url");
+    }
+
+    content.header   = h;
+    content.sections = sections;
+    content.nodes    = nodes;
+    content.spans    = spans;
+    content.strings  = strings;
+    content.size     = size;
+    return true;
+}
+
+bool content_load_file(Content& content, const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "[content] can't open %s\n", path);
+        return false;
+    }
+    defer { fclose(f); };
+    fseek(f, 0, SEEK_END);
+    const long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size <= 0) return content_fail("empty file");
+
+    void* buffer = IM_ALLOC((size_t)size); // ImGui's allocator hands out pointer aligned memory
+    if (fread(buffer, 1, (size_t)size, f) != (size_t)size || !content_load_from_memory(content, buffer, (size_t)size)) {
+        IM_FREE(buffer);
+        return false;
+    }
+    content.owned = buffer;
+    return true;
+}
+
+void content_free(Content& content) {
+    if (content.owned) IM_FREE(content.owned);
+    content = Content();
+}
+
+// NOTE(WALKER): Copies of a section's node range keep their shape (end is relative), every node copy gets its own spans so
+//               first_span stays monotonic like the compiler writes it. The string blob is shared by every copy.
+bool content_load_repeated(Content& content, const Content& src, int copies) {
+    if (!src.header || copies < 1) return false;
+    const Content_Header& sh = *src.header;
+    uint64_t node_count = 0, span_count = 0;
+    for (uint32_t s = 0; s < sh.section_count; ++s)
+        for (uint32_t i = src.sections[s].first_node; i < src.sections[s].end_node; ++i) {
+            ++node_count;
+            span_count += src.nodes[i].span_count;
+        }
+    node_count *= (uint64_t)copies;
+    span_count *= (uint64_t)copies;
+
+    Content_Header h = sh;
+    h.node_count     = (uint32_t)node_count;
+    h.span_count     = (uint32_t)span_count;
+    h.section_offset = sizeof(Content_Header);
+    h.node_offset    = h.section_offset + h.section_count * (uint32_t)sizeof(Content_Section);
+    h.span_offset    = h.node_offset + h.node_count * (uint32_t)sizeof(Content_Node);
+    h.string_offset  = h.span_offset + h.span_count * (uint32_t)sizeof(Content_Span);
+    const uint64_t total = ((uint64_t)h.string_offset + h.string_bytes + 3) & ~(uint64_t)3;
+    if (total > 0x7FFFFFFF) return content_fail("repeated content too large");
+    h.total_size = (uint32_t)total;
+
+    unsigned char* base = (unsigned char*)IM_ALLOC((size_t)total);
+    memset(base, 0, (size_t)total);
+    memcpy(base, &h, sizeof(h));
+    Content_Section* sections = (Content_Section*)(base + h.section_offset);
+    Content_Node*    nodes    = (Content_Node*)(base + h.node_offset);
+    Content_Span*    spans    = (Content_Span*)(base + h.span_offset);
+    memcpy(base + h.string_offset, src.strings, sh.string_bytes);
+
+    uint32_t node = 0, span = 0;
+    for (uint32_t s = 0; s < sh.section_count; ++s) {
+        const Content_Section& section = src.sections[s];
+        sections[s] = section;
+        sections[s].first_node = node;
+        for (int copy = 0; copy < copies; ++copy) {
+            for (uint32_t i = section.first_node; i < section.end_node; ++i) {
+                Content_Node n = src.nodes[i];
+                n.end        = node + (n.end - i);
+                n.first_span = span;
+                memcpy(spans + span, src.spans + src.nodes[i].first_span, sizeof(Content_Span) * n.span_count);
+                span += n.span_count;
+                nodes[node++] = n;
+            }
+        }
+        sections[s].end_node = node;
+    }
+
+    if (!content_load_from_memory(content, base, (size_t)total)) {
+        IM_FREE(base);
+        return false;
+    }
+    content.owned = base;
+    return true;
+}
+
+// NOTE(WALKER): Same widgets the hand written tabs used: bullet, then the first text span wrapped, then links/text on the same line.
+//               TextUnformatted() with explicit ends means no printf formatting and no copies, straight out of the buffer.
+//               The wrapped first span goes through the layout cache so it is not re-wrapped every frame.
+static void content_draw_spans(const Content& c, const Content_Node& node, void (*open_link)(const char*)) {
+    if (node.kind == Content_Kind_Bullet) {
+        ImGui::BulletText("");
+        ImGui::SameLine();
+    }
+    for (uint32_t k = 0; k < node.span_count; ++k) {
+        const Content_Span& span = c.spans[node.first_span + k];
+        const char* text = content_string(c, span.text);
+        if (k > 0) ImGui::SameLine();
+        if (span.kind == Content_Span_Link) {
+            const bool clicked = ImGui::Button(text);
+            retained_draw_note_item();
+            if (clicked && open_link)
+                open_link(content_string(c, span.url));
+        } else if (k == 0) {
+            text_layout_cache_text_wrapped(text, text + span.text.length); // strings live in the content buffer, stable addresses
+        } else {
+            ImGui::TextUnformatted(text, text + span.text.length);
+        }
+    }
+    if (node.span_count == 0 && node.kind == Content_Kind_Text)
+        ImGui::NewLine();
+}
+
+// Search hits get the text selection color over their item rect
+static void content_highlight_last_item() {
+    ImGui::GetWindowDrawList()->AddRectFilled(ImGui::GetItemRectMin(), ImGui::GetItemRectMax(), ImGui::GetColorU32(ImGuiCol_TextSelectedBg),
+                                              ImGui::GetStyle().FrameRounding);
+}
+
+// What a draw pass needs from the search: which nodes to draw/highlight, and whether to open the tree nodes holding matches
+struct Content_Filter {
+    const uint8_t* node_flags = nullptr; // Search_Node_Flags, nullptr draws everything
+    bool           open_matches = false;
+};
+
+static void content_draw_nodes(const Content& c, uint32_t first, uint32_t end, int open_action, const Content_Filter& filter,
+                               void (*open_link)(const char*)) {
+    for (uint32_t i = first; i < end;) {
+        const Content_Node& node = c.nodes[i];
+        const uint8_t flags = filter.node_flags ? filter.node_flags[i] : (uint8_t)Search_Node_Visible;
+        if (!(flags & Search_Node_Visible)) { // nothing in this subtree matched
+            i = node.end;
+            continue;
+        }
+        switch (node.kind) {
+        case Content_Kind_Node: {
+            if (open_action != -1)
+                ImGui::SetNextItemOpen(open_action != 0);
+            else if (filter.open_matches && (flags & Search_Node_Open))
+                ImGui::SetNextItemOpen(true);
+            const bool open = ImGui::TreeNode(content_string(c, node.label));
+            retained_draw_note_item();
+            if (flags & Search_Node_Match)
+                content_highlight_last_item();
+            if (open) {
+                defer { ImGui::TreePop(); };
+                content_draw_nodes(c, i + 1, node.end, open_action, filter, open_link);
+            }
+        } break;
+        case Content_Kind_Text:
+        case Content_Kind_Bullet: {
+            if (flags & Search_Node_Match) {
+                ImGui::BeginGroup();
+                content_draw_spans(c, node, open_link);
+                ImGui::EndGroup();
+                content_highlight_last_item();
+            } else {
+                content_draw_spans(c, node, open_link);
+            }
+            if (node.end > i + 1) {
+                ImGui::Indent();
+                defer { ImGui::Unindent(); };
+                content_draw_nodes(c, i + 1, node.end, open_action, filter, open_link);
+            }
+        } break;
+        case Content_Kind_NewLine: {
+            ImGui::NewLine();
+        } break;
+        }
+        i = node.end;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Virtualized scroll sections
+//-----------------------------------------------------------------------------
+
+Content_View_Stats content_view_stats;
+
+struct Content_Row {
+    uint32_t node;
+    int      parent; // row index, -1 at the top of the section
+    float    y;      // from the top of the first row
+    float    height; // including item spacing, measured or estimated
+    bool     open;   // tree node open when the list was built
+};
+
+struct Content_Rows {
+    ImVector<Content_Row> rows;
+    float                 total_height = 0.0f;
+    uint32_t              search_generation = 0;
+    bool                  searching = false;
+    bool                  dirty = true;
+};
+
+static ImVector<Content_Rows*> section_rows;
+static ImVector<float>         node_heights;       // own row height per node (children not included), < 0 until measured
+static const Content*          rows_content = nullptr;
+static ImVec2                  heights_key;        // (content width, font size) the heights were measured at
+
+// Until a row has been drawn once: wrapped lines from the average glyph width, a frame high line for link buttons
+static float content_estimate_height(const Content& c, const Content_Node& node, float wrap_width, float char_width) {
+    const ImGuiStyle& style = ImGui::GetStyle();
+    const float line = ImGui::GetTextLineHeight();
+    if (node.kind != Content_Kind_Text && node.kind != Content_Kind_Bullet) return line + style.ItemSpacing.y;
+    if (node.span_count == 0) return line + style.ItemSpacing.y;
+    const Content_Span& first = c.spans[node.first_span];
+    if (first.kind == Content_Span_Link) return ImGui::GetFrameHeight() + style.ItemSpacing.y;
+    const float width = (float)first.text.length * char_width;
+    const int lines = wrap_width > char_width ? (int)(width / wrap_width) + 1 : 1;
+    return (float)lines * line + style.ItemSpacing.y;
+}
+
+static void content_rows_layout(Content_Rows& r) {
+    float y = 0.0f;
+    for (Content_Row& row : r.rows) {
+        row.y = y;
+        y += row.height;
+    }
+    r.total_height = y;
+}
+
+// NOTE(WALKER): Walks the tree the way content_draw_nodes() would, but only reads the open state: TreeNode(label) keys it on
+//               GetID(label) under the labels of the tree nodes above it (TreePush() is PushID(label)), so the same PushID()
+//               chain gives the same ids. "Open all"/"Close all" and search results are written straight into that storage,
+//               which is what SetNextItemOpen() would have done for the nodes the walk reaches.
+static void content_rows_build(Content_Rows& r, const Content& c, uint32_t first, uint32_t end, int parent, int depth,
+                               int open_action, const Content_Filter& filter, float wrap_width, float char_width) {
+    ImGuiStorage* storage = ImGui::GetStateStorage();
+    const float indent = ImGui::GetStyle().IndentSpacing;
+    for (uint32_t i = first; i < end;) {
+        const Content_Node& node = c.nodes[i];
+        const uint8_t flags = filter.node_flags ? filter.node_flags[i] : (uint8_t)Search_Node_Visible;
+        if (!(flags & Search_Node_Visible)) {
+            i = node.end;
+            continue;
+        }
+        Content_Row row;
+        row.node   = i;
+        row.parent = parent;
+        row.y      = 0.0f;
+        row.height = node_heights[(int)i] >= 0.0f ? node_heights[(int)i]
+                                                  : content_estimate_height(c, node, wrap_width - indent * (float)depth, char_width);
+        row.open   = false;
+        const int index = r.rows.Size;
+        if (node.kind == Content_Kind_Node) {
+            const char* label = content_string(c, node.label);
+            const ImGuiID id = ImGui::GetID(label);
+            if (open_action != -1)
+                storage->SetInt(id, open_action);
+            else if (filter.open_matches && (flags & Search_Node_Open))
+                storage->SetInt(id, 1);
+            row.open = storage->GetInt(id, 0) != 0;
+            r.rows.push_back(row);
+            if (row.open) {
+                ImGui::PushID(label);
+                content_rows_build(r, c, i + 1, node.end, index, depth + 1, open_action, filter, wrap_width, char_width);
+                ImGui::PopID();
+            }
+        } else {
+            r.rows.push_back(row);
+            if (node.end > i + 1)
+                content_rows_build(r, c, i + 1, node.end, index, depth + 1, open_action, filter, wrap_width, char_width);
+        }
+        i = node.end;
+    }
+}
+
+// Rows whose children are being drawn: tree nodes were TreePush()ed by TreeNode(), bullets/text Indent()ed
+static void content_rows_push(const Content& c, const Content_Row& row, bool tree_push) {
+    const Content_Node& node = c.nodes[row.node];
+    if (node.kind == Content_Kind_Node) { if (tree_push) ImGui::TreePush(content_string(c, node.label)); }
+    else ImGui::Indent();
+}
+static void content_rows_pop(const Content& c, const Content_Row& row) {
+    if (c.nodes[row.node].kind == Content_Kind_Node) ImGui::TreePop();
+    else ImGui::Unindent();
+}
+
+// Stands in for rows that are not submitted, Dummy() adds the item spacing the measured heights already include
+static void content_rows_skip(float height) {
+    const float spacing = ImGui::GetStyle().ItemSpacing.y;
+    if (height > spacing) ImGui::Dummy(ImVec2(0.0f, height - spacing));
+}
+
+static void content_draw_rows(Content_Rows& r, const Content& c, const Content_Filter& filter, void (*open_link)(const char*)) {
+    if (r.rows.Size == 0) return;
+    const float start_y  = ImGui::GetCursorPosY();
+    const float view_min = ImGui::GetScrollY() - start_y;
+    const float view_max = view_min + ImGui::GetWindowHeight();
+
+    // First row reaching into the view, then re-enter the tree nodes/bullets it sits in
+    int lo = 0, hi = r.rows.Size;
+    while (lo < hi) {
+        const int mid = (lo + hi) / 2;
+        if (r.rows[mid].y + r.rows[mid].height <= view_min) lo = mid + 1;
+        else hi = mid;
+    }
+    const int first = lo < r.rows.Size ? lo : r.rows.Size - 1;
+    content_rows_skip(r.rows[first].y);
+
+    static ImVector<int> stack; // rows whose children are being drawn, outermost first (kept to not allocate every frame)
+    stack.resize(0);
+    for (int p = r.rows[first].parent; p >= 0; p = r.rows[p].parent) stack.push_back(p);
+    for (int a = 0, b = stack.Size - 1; a < b; ++a, --b) {
+        const int t = stack[a];
+        stack[a] = stack[b];
+        stack[b] = t;
+    }
+    for (int p : stack) content_rows_push(c, r.rows[p], true);
+
+    bool     heights_changed = false;
+    uint32_t skip_until = 0; // descendants of a tree node that closed this frame
+    int      drawn = 0;
+    int      i = first;
+    for (; i < r.rows.Size && r.rows[i].y < view_max; ++i) {
+        Content_Row& row = r.rows[i];
+        if (row.node < skip_until) continue;
+        while (stack.Size && stack.back() != row.parent) {
+            content_rows_pop(c, r.rows[stack.back()]);
+            stack.pop_back();
+        }
+
+        const Content_Node& node = c.nodes[row.node];
+        const uint8_t flags = filter.node_flags ? filter.node_flags[row.node] : (uint8_t)Search_Node_Visible;
+        const float before = ImGui::GetCursorPosY();
+        bool open_children = false, draw_children_now = false;
+        switch (node.kind) {
+        case Content_Kind_Node: {
+            const bool open = ImGui::TreeNode(content_string(c, node.label));
+            retained_draw_note_item();
+            if (flags & Search_Node_Match)
+                content_highlight_last_item();
+            if (open != row.open) { // toggled this frame, the list catches up next frame
+                r.dirty = true;
+                if (open) draw_children_now = true;
+                else skip_until = node.end;
+            } else {
+                open_children = open;
+            }
+        } break;
+        case Content_Kind_Text:
+        case Content_Kind_Bullet: {
+            if (flags & Search_Node_Match) {
+                ImGui::BeginGroup();
+                content_draw_spans(c, node, open_link);
+                ImGui::EndGroup();
+                content_highlight_last_item();
+            } else {
+                content_draw_spans(c, node, open_link);
+            }
+            open_children = i + 1 < r.rows.Size && r.rows[i + 1].parent == i;
+        } break;
+        case Content_Kind_NewLine: {
+            ImGui::NewLine();
+        } break;
+        }
+        ++drawn;
+
+        const float height = ImGui::GetCursorPosY() - before;
+        node_heights[(int)row.node] = height;
+        if (fabsf(height - row.height) > 0.5f) {
+            row.height = height;
+            heights_changed = true;
+        }
+        if (draw_children_now) {
+            content_draw_nodes(c, row.node + 1, node.end, -1, filter, open_link);
+            ImGui::TreePop();
+        } else if (open_children) {
+            content_rows_push(c, row, false);
+            stack.push_back(i);
+        }
+    }
+    while (stack.Size) {
+        content_rows_pop(c, r.rows[stack.back()]);
+        stack.pop_back();
+    }
+    if (i < r.rows.Size)
+        content_rows_skip(r.total_height - r.rows[i].y);
+
+    // NOTE(WALKER): Newly measured rows move everything below them, applied once for the next frame
+    if (heights_changed) content_rows_layout(r);
+    content_view_stats.frame_rows  += r.rows.Size;
+    content_view_stats.frame_drawn += drawn;
+}
+
+// Drop-in for content_draw_nodes() over a whole section inside its scroll child
+static void content_draw_section_virtual(const Content& c, uint32_t s, int open_action, const Content_Filter& filter, const Search* search,
+                                         void (*open_link)(const char*)) {
+    if (rows_content != &c || node_heights.Size != (int)c.header->node_count) {
+        content_view_clear();
+        rows_content = &c;
+        node_heights.resize((int)c.header->node_count);
+        for (float& h : node_heights) h = -1.0f;
+    }
+    while (section_rows.Size < (int)c.header->section_count) section_rows.push_back(IM_NEW(Content_Rows)());
+    Content_Rows& r = *section_rows[(int)s];
+
+    const float  wrap_width = ImGui::GetContentRegionAvail().x;
+    const ImVec2 key(wrap_width, ImGui::GetFontSize());
+    if (key.x != heights_key.x || key.y != heights_key.y) { // every measured height is stale (resize, font size)
+        heights_key = key;
+        for (float& h : node_heights) h = -1.0f;
+        for (Content_Rows* rows : section_rows) rows->dirty = true;
+    }
+    const bool     searching  = filter.node_flags != nullptr;
+    const uint32_t generation = search ? search->generation : 0;
+    if (r.dirty || open_action != -1 || filter.open_matches || r.searching != searching || (searching && r.search_generation != generation)) {
+        const Content_Section& section = c.sections[s];
+        const float char_width = ImGui::CalcTextSize("abcdefghijklmnopqrstuvwxyz ").x / 27.0f;
+        r.rows.resize(0);
+        content_rows_build(r, c, section.first_node, section.end_node, -1, 0, open_action, filter, wrap_width, char_width);
+        content_rows_layout(r);
+        r.dirty             = false;
+        r.searching         = searching;
+        r.search_generation = generation;
+        ++content_view_stats.rebuilds;
+    }
+    content_draw_rows(r, c, filter, open_link);
+}
+
+void content_view_end_frame() {
+    auto& s = content_view_stats;
+    s.rows        = s.frame_rows;
+    s.rows_drawn  = s.frame_drawn;
+    s.frame_rows  = s.frame_drawn = 0;
+}
+
+void content_view_clear() {
+    for (Content_Rows* r : section_rows) IM_DELETE(r);
+    section_rows.clear();
+    node_heights.clear();
+    rows_content = nullptr;
+    heights_key  = ImVec2(0.0f, 0.0f);
+}
+
+void content_view_show_menu() {
+    auto& s = content_view_stats;
+    if (ImGui::Checkbox("Virtualize scroll sections", &s.enabled))
+        for (Content_Rows* r : section_rows) r->dirty = true; // open states may have changed in the meantime
+    ImGui::Text("Section rows:    %d drawn of %d, %llu list rebuilds", s.rows_drawn, s.rows, s.rebuilds);
+}
+
+void content_draw_tab_items(const Content& c, void (*open_link)(const char*), Search* search) {
+    if (!c.header) {
+        if (ImGui::BeginTabItem("About", nullptr, ImGuiTabItemFlags_None)) {
+            defer { ImGui::EndTabItem(); };
+            ImGui::TextWrapped("The resume content failed to load, please try reloading the page.");
+        }
+        return;
+    }
+    const bool searching = search && search->active && search->node_flags.Size == (int)c.header->node_count;
+    for (uint32_t s = 0; s < c.header->section_count; ++s) {
+        const Content_Section& section = c.sections[s];
+        const ImGuiTabItemFlags tab_flags = search && search->select_section == (int)s ? ImGuiTabItemFlags_SetSelected : ImGuiTabItemFlags_None;
+        if (!ImGui::BeginTabItem(content_string(c, section.name), nullptr, tab_flags))
+            continue;
+        defer { ImGui::EndTabItem(); };
+        PROFILE_ZONE(content_string(c, section.name)); // tab names live in the content buffer, fine as zone names
+
+        Content_Filter filter;
+        ImGuiID search_key = 0;
+        if (search) search->current_section = (int)s;
+        if (searching) {
+            filter.node_flags   = search->node_flags.Data;
+            filter.open_matches = search->section_open[(int)s];
+            search->section_open[(int)s] = false; // once per result set, the user can close them again
+            search_key = search->generation << 2;
+            if (search->section_matches[(int)s] == 0)
+                ImGui::TextDisabled("No matches for \"%s\" in this tab.", search->query);
+        }
+
+        int open_action = -1;
+        if (section.flags & Content_Section_OpenAll) {
+            if (ImGui::Button("Open all"))
+                open_action = 1;
+            ImGui::SameLine();
+            if (ImGui::Button("Close all"))
+                open_action = 0;
+        }
+        if (section.flags & Content_Section_Scroll) {
+            ImGui::BeginChild("Scroll");
+            defer { ImGui::EndChild(); };
+            // NOTE(WALKER): Replays last frame's geometry when nothing that affects it changed (see retained_draw.hpp)
+            if (!retained_draw_begin((ImGuiID)(open_action + 1) | search_key)) {
+                if (content_view_stats.enabled)
+                    content_draw_section_virtual(c, s, open_action, filter, search, open_link);
+                else
+                    content_draw_nodes(c, section.first_node, section.end_node, open_action, filter, open_link);
+                retained_draw_end();
+            }
+        } else {
+            content_draw_nodes(c, section.first_node, section.end_node, open_action, filter, open_link);
+        }
+    }
+    if (search) search->select_section = -1;
+}
@@ -0,0 +1,55 @@
+// NOTE(WALKER): Runtime side of the data driven resume content (layout in content_format.hpp).
+//               The compiled file is read into ONE buffer and used in place, no per-string allocations,
+//               and a generic renderer walks it to draw every tab.
+
+#pragma once
+
+#include "content_format.hpp"
+#include <stddef.h>
+
+struct Content {
+    const Content_Header*  header   = nullptr;
+    const Content_Section* sections = nullptr;
+    const Content_Node*    nodes    = nullptr;
+    const Content_Span*    spans    = nullptr;
+    const char*            strings  = nullptr;
+    void*                  owned    = nullptr; // set when content_load_file() allocated the buffer
+    size_t                 size     = 0;
+};
+
+// Validates the buffer and points the arrays into it, the buffer must outlive the Content.
+bool content_load_from_memory(Content& content, const void* data, size_t size);
+
+// Reads the whole file into one allocation and loads it in place.
+bool content_load_file(Content& content, const char* path);
+void content_free(Content& content);
+
+// Synthetic large content for benchmarks: a copy of src with every section's nodes repeated `copies` times (strings shared).
+bool content_load_repeated(Content& content, const Content& src, int copies);
+
+inline const char* content_string(const Content& content, Content_String s) { return content.strings + s.offset; }
+
+struct Search;
+
+// NOTE(WALKER): Scroll sections are virtualized: their visible rows (every node the open tree nodes and the search let through)
+//               are flattened into a list with one height each, measured the first time a row is drawn and estimated until
+//               then, so a frame only lays out and submits the rows inside the scroll view and steps over the rest in O(log n).
+struct Content_View_Stats {
+    bool               enabled     = true;
+    int                rows        = 0; // flattened rows of the sections drawn last frame
+    int                rows_drawn  = 0; // of which were submitted
+    unsigned long long rebuilds    = 0; // row lists rebuilt (open/close, search, resize)
+    int                frame_rows  = 0; // current frame, rolled into rows/rows_drawn by content_view_end_frame()
+    int                frame_drawn = 0;
+};
+
+extern Content_View_Stats content_view_stats;
+
+void content_view_end_frame();
+void content_view_clear();
+void content_view_show_menu();
+
+// Draws one BeginTabItem() per section, call between BeginTabBar()/EndTabBar().
+// open_link is called with the (NUL terminated) url when an inline link button is clicked.
+// With an active search (search.hpp) only matching nodes and their context are drawn, matches highlighted.
+void content_draw_tab_items(const Content& content, void (*open_link)(const char* url), Search* search = nullptr);
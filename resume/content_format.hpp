@@ -0,0 +1,78 @@
+// NOTE(WALKER): Binary layout of the compiled resume content (gen/content/resume.bin).
+//               Shared by the build tool (tools/content_compiler.cpp) and the runtime loader (content.cpp), no ImGui in here.
+//
+//               [Content_Header][Content_Section * section_count][Content_Node * node_count][Content_Span * span_count][strings]
+//
+//               Everything is 4 byte aligned little endian PODs, so the runtime uses the file buffer in place: the arrays are
+//               just pointers into it, and every string is NUL terminated inside the string blob so it can go straight to ImGui.
+//               Nodes are stored in pre-order, each one knows the index one past its last descendant (end), so a closed
+//               tree node skips its whole subtree in O(1).
+
+#pragma once
+
+#include <stdint.h>
+
+constexpr uint32_t CONTENT_MAGIC   = 0x4D555352; // "RSUM"
+constexpr uint16_t CONTENT_VERSION = 1;
+
+enum Content_Kind : uint8_t {
+    Content_Kind_Text    = 0, // wrapped paragraph made of spans
+    Content_Kind_Bullet  = 1, // bullet + wrapped spans, children are drawn indented
+    Content_Kind_Node    = 2, // TreeNode(label), children are drawn when open
+    Content_Kind_NewLine = 3,
+};
+
+enum Content_Span_Kind : uint8_t {
+    Content_Span_Text = 0,
+    Content_Span_Link = 1, // button with text as label, opens url
+};
+
+enum Content_Section_Flags : uint16_t {
+    Content_Section_Scroll  = 1 << 0, // content goes in a "Scroll" child window
+    Content_Section_OpenAll = 1 << 1, // "Open all"/"Close all" buttons
+};
+
+struct Content_String {
+    uint32_t offset; // into the string blob
+    uint32_t length; // not counting the NUL terminator
+};
+
+struct Content_Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t total_size;
+    uint32_t section_count, section_offset;
+    uint32_t node_count,    node_offset;
+    uint32_t span_count,    span_offset;
+    uint32_t string_bytes,  string_offset;
+};
+
+struct Content_Section {
+    Content_String name;
+    uint16_t       flags;
+    uint16_t       reserved;
+    uint32_t       first_node;
+    uint32_t       end_node;
+};
+
+struct Content_Node {
+    uint8_t        kind;
+    uint8_t        depth;      // nesting level inside its section, 0 = top level
+    uint16_t       span_count;
+    uint32_t       first_span;
+    Content_String label;      // Content_Kind_Node only
+    uint32_t       end;        // one past the last descendant
+};
+
+struct Content_Span {
+    uint8_t        kind;
+    uint8_t        reserved[3];
+    Content_String text;
+    Content_String url;        // Content_Span_Link only
+};
+
+static_assert(sizeof(Content_Header)  == 44, "Content_Header layout changed, bump CONTENT_VERSION");
+static_assert(sizeof(Content_Section) == 20, "Content_Section layout changed, bump CONTENT_VERSION");
+static_assert(sizeof(Content_Node)    == 20, "Content_Node layout changed, bump CONTENT_VERSION");
+static_assert(sizeof(Content_Span)    == 20, "Content_Span layout changed, bump CONTENT_VERSION");
@@ -0,0 +1,276 @@
+#include "damage.hpp"
+
+#include "imgui.h"
+#include "imgui_internal.h" // ImMin(), ImMax()
+#include <string.h>
+#include <chrono>
+
+Damage_Tracker damage_tracker;
+
+static double damage_now_ms() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static inline uint64_t damage_mix(uint64_t h, uint64_t v) {
+    h ^= v;
+    h *= 0x9E3779B97F4A7C15ull;
+    return h ^ (h >> 29);
+}
+
+static inline uint64_t damage_mix_float(uint64_t h, float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return damage_mix(h, bits);
+}
+
+void damage_invalidate(Damage_Tracker& d, const char* reason) {
+    if (d.invalid) return; // keep the first reason
+    d.invalid        = true;
+    d.invalid_reason = reason;
+}
+
+static void damage_finish(Damage_Tracker& d, bool full, const char* reason) {
+    d.full        = full;
+    d.full_reason = full ? reason : "";
+    if (full) {
+        d.rect_count = 0;
+        d.redrawn    = 1.0f;
+        ++d.full_frames;
+    } else if (d.rect_count) {
+        ++d.partial_frames;
+    } else {
+        ++d.clean_frames;
+    }
+    ++d.frames;
+    d.damaged_sum += d.damaged;
+    d.redrawn_sum += d.redrawn;
+    d.prev_hash.swap(d.tile_hash);
+}
+
+// Merges the changed tiles into rectangles: runs along each tile row, a run with the same span as one ending on the row above
+// extends it down. More rectangles than DAMAGE_MAX_RECTS become their bounding box.
+static void damage_merge(Damage_Tracker& d) {
+    Damage_Rect tiles[DAMAGE_MAX_RECTS]; // in tiles
+    Damage_Rect bounds = { d.tiles_x, d.tiles_y, 0, 0 };
+    int  count    = 0;
+    int  changed  = 0;
+    bool overflow = false;
+    for (int ty = 0; ty < d.tiles_y; ++ty) {
+        const uint64_t* now  = d.tile_hash.Data + ty * d.tiles_x;
+        const uint64_t* prev = d.prev_hash.Data + ty * d.tiles_x;
+        for (int tx = 0; tx < d.tiles_x;) {
+            if (now[tx] == prev[tx]) { ++tx; continue; }
+            const int start = tx;
+            while (tx < d.tiles_x && now[tx] != prev[tx]) ++tx;
+            changed += tx - start;
+            bounds.x0 = ImMin(bounds.x0, start); bounds.x1 = ImMax(bounds.x1, tx);
+            bounds.y0 = ImMin(bounds.y0, ty);    bounds.y1 = ImMax(bounds.y1, ty + 1);
+            if (overflow) continue;
+            int open = -1;
+            for (int i = 0; i < count && open < 0; ++i)
+                if (tiles[i].x0 == start && tiles[i].x1 == tx && tiles[i].y1 == ty) open = i;
+            if (open >= 0)                     tiles[open].y1 = ty + 1;
+            else if (count < DAMAGE_MAX_RECTS) tiles[count++] = { start, ty, tx, ty + 1 };
+            else                               overflow = true;
+        }
+    }
+    if (overflow) {
+        tiles[0] = bounds;
+        count = 1;
+    }
+
+    const float area = (float)d.width * (float)d.height;
+    d.damaged    = (float)changed * DAMAGE_TILE * DAMAGE_TILE / area;
+    d.rect_count = count;
+    double redrawn = 0.0;
+    for (int i = 0; i < count; ++i) {
+        Damage_Rect& r = d.rects[i];
+        r.x0 = tiles[i].x0 * DAMAGE_TILE;
+        r.y0 = tiles[i].y0 * DAMAGE_TILE;
+        r.x1 = ImMin(tiles[i].x1 * DAMAGE_TILE, d.width);
+        r.y1 = ImMin(tiles[i].y1 * DAMAGE_TILE, d.height);
+        redrawn += (double)(r.x1 - r.x0) * (double)(r.y1 - r.y0);
+    }
+    if (d.damaged > 1.0f) d.damaged = 1.0f; // edge tiles hang over the framebuffer
+    d.redrawn = (float)(redrawn / area);
+}
+
+void damage_track(Damage_Tracker& d, const ImDrawData* draw_data) {
+    const double start = damage_now_ms();
+    const ImVec2 offset = draw_data->DisplayPos;
+    const ImVec2 scale  = draw_data->FramebufferScale;
+    const int width  = (int)(draw_data->DisplaySize.x * scale.x);
+    const int height = (int)(draw_data->DisplaySize.y * scale.y);
+    if (width <= 0 || height <= 0) return;
+    if (width != d.width || height != d.height) {
+        d.width   = width;
+        d.height  = height;
+        d.tiles_x = (width + DAMAGE_TILE - 1) / DAMAGE_TILE;
+        d.tiles_y = (height + DAMAGE_TILE - 1) / DAMAGE_TILE;
+        d.prev_hash.resize(d.tiles_x * d.tiles_y);
+        damage_invalidate(d, "framebuffer resized");
+    }
+    d.tile_hash.resize(d.tiles_x * d.tiles_y);
+    for (uint64_t& h : d.tile_hash) h = 0x84222325CBF29CE4ull;
+
+    uint64_t state = damage_mix_float(damage_mix_float(0, offset.x), offset.y);
+    state = damage_mix_float(damage_mix_float(state, scale.x), scale.y);
+    for (int n = 0; n < draw_data->CmdListsCount; ++n) {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        for (const ImDrawCmd& cmd : cmd_list->CmdBuffer) {
+            if (cmd.UserCallback) { // GL state nobody can see from here: any change redraws everything
+                state = damage_mix(damage_mix(state, (uint64_t)(uintptr_t)cmd.UserCallback), (uint64_t)(uintptr_t)cmd.UserCallbackData);
+                continue;
+            }
+            const float clip_x0 = ImMax(0.0f, (cmd.ClipRect.x - offset.x) * scale.x), clip_x1 = ImMin((float)width,  (cmd.ClipRect.z - offset.x) * scale.x);
+            const float clip_y0 = ImMax(0.0f, (cmd.ClipRect.y - offset.y) * scale.y), clip_y1 = ImMin((float)height, (cmd.ClipRect.w - offset.y) * scale.y);
+            if (clip_x1 <= clip_x0 || clip_y1 <= clip_y0) continue;
+
+            uint64_t cmd_hash = damage_mix(0, (uint64_t)(uintptr_t)cmd.GetTexID());
+            cmd_hash = damage_mix_float(damage_mix_float(cmd_hash, clip_x0), clip_y0);
+            cmd_hash = damage_mix_float(damage_mix_float(cmd_hash, clip_x1), clip_y1);
+            const ImDrawIdx*  idx = cmd_list->IdxBuffer.Data + cmd.IdxOffset;
+            const ImDrawVert* vtx = cmd_list->VtxBuffer.Data + cmd.VtxOffset;
+            for (unsigned int i = 0; i + 2 < cmd.ElemCount; i += 3) {
+                // NOTE(WALKER): Hashed by value, not by index: a widget gaining 4 vertices shifts every index after it, the
+                //               triangles after it are still the same pixels
+                uint64_t h = cmd_hash;
+                float min_x = 1e30f, min_y = 1e30f, max_x = -1e30f, max_y = -1e30f;
+                for (int k = 0; k < 3; ++k) {
+                    const ImDrawVert& v = vtx[idx[i + k]];
+                    uint64_t words[3] = {};
+                    memcpy(words, &v, sizeof(ImDrawVert) < sizeof(words) ? sizeof(ImDrawVert) : sizeof(words));
+                    h = damage_mix(damage_mix(damage_mix(h, words[0]), words[1]), words[2]);
+                    min_x = ImMin(min_x, v.pos.x); max_x = ImMax(max_x, v.pos.x);
+                    min_y = ImMin(min_y, v.pos.y); max_y = ImMax(max_y, v.pos.y);
+                }
+                // Pixels the triangle can touch, whole pixels out so a sliver on a tile edge counts
+                const float x0 = ImMax(clip_x0, (min_x - offset.x) * scale.x), x1 = ImMin(clip_x1, (max_x - offset.x) * scale.x);
+                const float y0 = ImMax(clip_y0, (min_y - offset.y) * scale.y), y1 = ImMin(clip_y1, (max_y - offset.y) * scale.y);
+                if (x1 < x0 || y1 < y0) continue;
+                const int tx0 = (int)x0 / DAMAGE_TILE, tx1 = ImMin(d.tiles_x - 1, (int)x1 / DAMAGE_TILE);
+                const int ty0 = (int)y0 / DAMAGE_TILE, ty1 = ImMin(d.tiles_y - 1, (int)y1 / DAMAGE_TILE);
+                for (int ty = ty0; ty <= ty1; ++ty)
+                    for (int tx = tx0; tx <= tx1; ++tx) {
+                        uint64_t& tile = d.tile_hash[ty * d.tiles_x + tx];
+                        tile = damage_mix(tile, h);
+                    }
+            }
+        }
+    }
+
+    const bool state_changed = state != d.state_hash;
+    d.state_hash = state;
+    if (state_changed) damage_invalidate(d, "render state changed");
+    if (d.invalid) {
+        const char* reason = d.invalid_reason;
+        d.invalid = false;
+        d.damaged = 1.0f;
+        d.track_ms = damage_now_ms() - start;
+        d.track_ms_sum += d.track_ms;
+        damage_finish(d, true, reason);
+        return;
+    }
+    damage_merge(d);
+    d.track_ms = damage_now_ms() - start;
+    d.track_ms_sum += d.track_ms;
+    damage_finish(d, d.redrawn > d.max_fraction, "too much damage");
+}
+
+//-----------------------------------------------------------------------------
+// Clipping the draw data to the damage
+//-----------------------------------------------------------------------------
+
+void damage_clip_begin(Damage_Clip& clip, ImDrawData* draw_data, const Damage_Tracker& d) {
+    const ImVec2 offset = draw_data->DisplayPos;
+    const ImVec2 scale  = draw_data->FramebufferScale;
+    const int    fb_height = (int)(draw_data->DisplaySize.y * scale.y);
+    while (clip.buffers.Size < draw_data->CmdListsCount) clip.buffers.push_back(IM_NEW(ImVector<ImDrawCmd>)());
+
+    for (int n = 0; n < draw_data->CmdListsCount; ++n) {
+        ImDrawList* cmd_list = draw_data->CmdLists[n];
+        ImVector<ImDrawCmd>& out = *clip.buffers[n];
+        out.resize(0);
+        for (const ImDrawCmd& cmd : cmd_list->CmdBuffer) {
+            if (cmd.UserCallback) {
+                out.push_back(cmd);
+                continue;
+            }
+            // NOTE(WALKER): The scissor the backends would set for the whole frame (imgui_impl_opengl3's glScissor(), y
+            //               counted from the bottom), cut to each rectangle in whole pixels. The new ClipRect sits a fraction
+            //               of a pixel off those pixel edges so the same truncation lands on them exactly, whatever the float
+            //               error of going back through FramebufferScale.
+            const float min_x = (cmd.ClipRect.x - offset.x) * scale.x, max_x = (cmd.ClipRect.z - offset.x) * scale.x;
+            const float min_y = (cmd.ClipRect.y - offset.y) * scale.y, max_y = (cmd.ClipRect.w - offset.y) * scale.y;
+            if (max_x <= min_x || max_y <= min_y) continue;
+            const int sx0 = (int)min_x, sx1 = sx0 + (int)(max_x - min_x);
+            const int sy1 = fb_height - (int)((float)fb_height - max_y), sy0 = sy1 - (int)(max_y - min_y);
+            for (int i = 0; i < d.rect_count; ++i) {
+                const Damage_Rect& r = d.rects[i];
+                const int x0 = ImMax(sx0, r.x0), x1 = ImMin(sx1, r.x1);
+                const int y0 = ImMax(sy0, r.y0), y1 = ImMin(sy1, r.y1);
+                if (x1 <= x0 || y1 <= y0) continue;
+                out.push_back(cmd);
+                out.back().ClipRect = ImVec4(((float)x0 + 0.5f) / scale.x + offset.x, ((float)y0 - 0.75f) / scale.y + offset.y,
+                                             ((float)x1 + 0.75f) / scale.x + offset.x, ((float)y1 - 0.5f) / scale.y + offset.y);
+            }
+        }
+        cmd_list->CmdBuffer.swap(out);
+    }
+    clip.swapped = draw_data->CmdListsCount;
+}
+
+void damage_clip_end(Damage_Clip& clip, ImDrawData* draw_data) {
+    for (int n = 0; n < clip.swapped; ++n)
+        draw_data->CmdLists[n]->CmdBuffer.swap(*clip.buffers[n]);
+    clip.swapped = 0;
+}
+
+void damage_clip_free(Damage_Clip& clip) {
+    for (ImVector<ImDrawCmd>* buffer : clip.buffers) IM_DELETE(buffer);
+    clip.buffers.clear();
+    clip.swapped = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Menu
+//-----------------------------------------------------------------------------
+
+// On the thread that owns the tracker, with each frame's copy of the menu's settings
+void damage_apply_settings(Damage_Tracker& d, const Damage_Settings& settings) {
+    if (d.enabled != settings.enabled) damage_invalidate(d, "toggled");
+    d.enabled      = settings.enabled;
+    d.max_fraction = settings.max_fraction;
+}
+
+// On the thread that owns the tracker, after the frame: what the menu shows
+void damage_fill_report(const Damage_Tracker& d, Damage_Report& out) {
+    out.full           = d.full;
+    out.full_reason    = d.full_reason;
+    out.damaged        = d.damaged;
+    out.redrawn        = d.redrawn;
+    out.rect_count     = d.rect_count;
+    out.frames         = d.frames;
+    out.full_frames    = d.full_frames;
+    out.partial_frames = d.partial_frames;
+    out.clean_frames   = d.clean_frames;
+    out.damaged_sum    = d.damaged_sum;
+    out.redrawn_sum    = d.redrawn_sum;
+    out.track_ms_sum   = d.track_ms_sum;
+}
+
+// NOTE(WALKER): Shown in the menu bar "Performance" menu
+void damage_show_menu(Damage_Settings& settings, const Damage_Report& d) {
+    ImGui::Checkbox("Redraw only what changed", &settings.enabled);
+    ImGui::SetItemTooltip("Keep the last frame in an offscreen target and only redraw the rectangles whose draw commands changed");
+    if (!settings.enabled) return;
+    ImGui::SliderFloat("Full redraw over", &settings.max_fraction, 0.05f, 1.0f, "%.2f of the screen");
+    const double frames = d.frames ? (double)d.frames : 1.0;
+    if (d.full)
+        ImGui::Text("Damage:          full frame (%s)", d.full_reason);
+    else
+        ImGui::Text("Damage:          %.1f%% changed, %.1f%% redrawn in %d rectangle(s)", d.damaged * 100.0f, d.redrawn * 100.0f, d.rect_count);
+    ImGui::Text("Average:         %.1f%% changed, %.1f%% redrawn per frame, tracked in %.3f ms", d.damaged_sum / frames * 100.0,
+                d.redrawn_sum / frames * 100.0, d.track_ms_sum / frames);
+    ImGui::Text("Frames:          %llu partial, %llu full, %llu unchanged (of %llu)", d.partial_frames, d.full_frames, d.clean_frames, d.frames);
+}
@@ -0,0 +1,108 @@
+// NOTE(WALKER): Damage tracking: redraw only the parts of the screen that changed.
+//               A hover highlight changes a handful of vertex colors, yet every frame clears and fills the whole canvas again.
+//               damage_track() cuts the framebuffer into DAMAGE_TILE sized tiles and hashes, per tile, every triangle that
+//               lands on it in draw order (resolved vertices, texture, clip rect). A tile whose hash is the same as last
+//               frame's would come out pixel for pixel the same, everything else is damage. Damaged tiles are merged into at
+//               most DAMAGE_MAX_RECTS rectangles; past max_fraction of the screen the frame is simply drawn in full.
+//
+//               Drawing only the damage needs last frame's pixels around it, which a swapped back buffer doesn't keep: the app
+//               draws into a persistent offscreen target and blits it to the window (resume.cpp, damage_target_*()).
+//               damage_clip_begin() narrows every draw command's ClipRect to each damage rectangle (one copy of the command
+//               per rectangle it touches), so either backend draws only there with its own scissoring and nothing else changes.
+//
+//               Anything the hashes can't see forces a full frame through damage_invalidate(): the font texture re-uploaded,
+//               the renderer switched, the target recreated.
+
+#pragma once
+
+#include "imgui.h"
+#include <stdint.h>
+
+constexpr int DAMAGE_TILE      = 32; // framebuffer pixels
+constexpr int DAMAGE_MAX_RECTS = 8;
+
+// Framebuffer pixels, top-left origin, max exclusive
+struct Damage_Rect {
+    int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+};
+
+struct Damage_Tracker {
+    bool  enabled      = false; // "Performance" menu, headless --damage
+    float max_fraction = 0.5f; // more damage than this and the frame is drawn in full
+
+    // This frame, set by damage_track()
+    bool        full        = true;
+    const char* full_reason = "first frame";
+    float       damaged     = 1.0f; // fraction of the framebuffer in changed tiles
+    float       redrawn     = 1.0f; // fraction that gets drawn: the rectangles, or 1 for a full frame
+    Damage_Rect rects[DAMAGE_MAX_RECTS];
+    int         rect_count  = 0;
+
+    // Last frame
+    bool               invalid    = true;
+    const char*        invalid_reason = "first frame";
+    int                width      = 0;
+    int                height     = 0;
+    int                tiles_x    = 0;
+    int                tiles_y    = 0;
+    uint64_t           state_hash = 0; // callbacks, display position and scale: anything that isn't per tile
+    ImVector<uint64_t> tile_hash;
+    ImVector<uint64_t> prev_hash;
+
+    // Stats
+    unsigned long long frames         = 0;
+    unsigned long long full_frames    = 0;
+    unsigned long long partial_frames = 0;
+    unsigned long long clean_frames   = 0; // nothing changed, only the blit
+    double             damaged_sum    = 0.0;
+    double             redrawn_sum    = 0.0;
+    double             track_ms       = 0.0; // last damage_track()
+    double             track_ms_sum   = 0.0;
+};
+
+extern Damage_Tracker damage_tracker; // the app's (resume.cpp, damage_target.hpp), only touched by the thread that renders
+
+// The next damage_track() draws a full frame
+void damage_invalidate(Damage_Tracker& d, const char* reason);
+
+// Diffs the frame against the last tracked one and fills full/rects/damaged/redrawn
+void damage_track(Damage_Tracker& d, const ImDrawData* draw_data);
+
+// The command buffers of draw_data cut to the damage rectangles, swapped in by damage_clip_begin() and back by damage_clip_end()
+struct Damage_Clip {
+    ImVector<ImVector<ImDrawCmd>*> buffers; // owned, one per command list, reused from frame to frame
+    int                            swapped = 0;
+};
+
+void damage_clip_begin(Damage_Clip& clip, ImDrawData* draw_data, const Damage_Tracker& d);
+void damage_clip_end(Damage_Clip& clip, ImDrawData* draw_data);
+void damage_clip_free(Damage_Clip& clip);
+
+// NOTE(WALKER): Where the tracker belongs to a render thread, the menu edits settings that go to it with each frame and reads a
+//               report of the tracker that comes back (resume.cpp, Render_Handoff)
+struct Damage_Settings {
+    bool  enabled      = false;
+    float max_fraction = 0.5f;
+};
+
+struct Damage_Report {
+    bool               full           = true;
+    const char*        full_reason    = "first frame"; // string literals only, safe to hand across
+    float              damaged        = 1.0f;
+    float              redrawn        = 1.0f;
+    int                rect_count     = 0;
+    unsigned long long frames         = 0;
+    unsigned long long full_frames    = 0;
+    unsigned long long partial_frames = 0;
+    unsigned long long clean_frames   = 0;
+    double             damaged_sum    = 0.0;
+    double             redrawn_sum    = 0.0;
+    double             track_ms_sum   = 0.0;
+};
+
+// Takes the settings, a toggle invalidates
+void damage_apply_settings(Damage_Tracker& d, const Damage_Settings& settings);
+void damage_fill_report(const Damage_Tracker& d, Damage_Report& out);
+
+// Settings and stats for the "Performance" menu
+void damage_show_menu(Damage_Settings& settings, const Damage_Report& report);
@@ -0,0 +1,167 @@
+// NOTE(WALKER): The GL side of damage tracking (damage.hpp): a full resolution offscreen target that keeps the last frame.
+//               A swapped back buffer is undefined after the swap (and WebGL clears it unless the context was created with
+//               preserveDrawingBuffer, which costs the same copy on every browser composite), so the frame is drawn into a
+//               renderbuffer of our own, only the damage rectangles cleared and redrawn, and the whole of it blitted to the window.
+//               The blit is one bandwidth bound copy, next to blending the whole UI again.
+//
+//               Needs glBlitFramebuffer() (GL 3.0 / WebGL2) like render_scale_target.hpp, the WebGL1 build gets the stubs at the
+//               bottom and always draws full frames. Drawn below full resolution, render_scale_target.hpp owns the frame and
+//               damage tracking sits it out (the next full resolution frame is drawn in full).
+//
+//               damage_tracker and damage_target belong to the thread that renders (the render thread when pipelined). The main
+//               thread only has damage_settings, handed to damage_target_begin() with each frame, and damage_target_report, the
+//               copy of the last frame's outcome resume.cpp hands back (Render_Handoff).
+
+#pragma once
+
+#include "imgui.h"
+#include "damage.hpp"
+#include "profiler.hpp"
+#include <stdio.h>
+
+struct Damage_Target_Report {
+    bool          available = true;
+    int           width     = 0; // 0 = no target
+    int           height    = 0;
+    Damage_Report damage;
+};
+
+static Damage_Settings      damage_settings;      // main thread, the menu's
+static Damage_Target_Report damage_target_report; // main thread, as of the last frame handed back
+
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+
+#if defined(IMGUI_IMPL_OPENGL_ES3)
+#include <GLES3/gl3.h>
+#else
+#ifndef GL_GLEXT_PROTOTYPES
+#define GL_GLEXT_PROTOTYPES
+#endif
+#include <GL/gl.h>
+#include <GL/glext.h>
+#endif
+
+// Only touched by the thread that renders (render_pipeline.hpp)
+struct Damage_Target {
+    bool   available   = true;
+    GLuint framebuffer = 0;
+    GLuint color       = 0; // renderbuffer, blitted to the window every frame
+    int    width       = 0;
+    int    height      = 0;
+    int    renderer    = -1; // the backends don't draw exactly the same pixels, a switch redraws everything
+};
+
+static Damage_Target damage_target;
+static Damage_Clip   damage_clip;
+
+static void damage_target_shutdown() {
+    auto& t = damage_target;
+    if (t.framebuffer) glDeleteFramebuffers(1, &t.framebuffer);
+    if (t.color)       glDeleteRenderbuffers(1, &t.color);
+    damage_clip_free(damage_clip);
+    t = Damage_Target();
+}
+
+// Binds the target, works out the damage and clears what is going to be redrawn: all of it, or only the damage rectangles
+// (draw_data's commands are then cut to them until damage_target_present()). False when damage tracking is off or has no
+// target, the frame is drawn to the window as before. settings are the main thread's as of this frame.
+static bool damage_target_begin(ImDrawData* draw_data, int renderer, ImVec4 clear, const Damage_Settings& settings) {
+    auto& t = damage_target;
+    auto& d = damage_tracker;
+    damage_apply_settings(d, settings);
+    if (!d.enabled || !t.available) {
+        damage_invalidate(d, d.enabled ? "no offscreen target" : "disabled");
+        return false;
+    }
+    const int width  = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+    const int height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+    if (width <= 0 || height <= 0) return false;
+
+    if (!t.framebuffer) {
+        glGenFramebuffers(1, &t.framebuffer);
+        glGenRenderbuffers(1, &t.color);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, t.framebuffer);
+    if (width != t.width || height != t.height) {
+        glBindRenderbuffer(GL_RENDERBUFFER, t.color);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, t.color);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        t.width  = width;
+        t.height = height;
+        damage_invalidate(d, "target resized");
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            fprintf(stderr, "[damage] offscreen target %dx%d incomplete, drawing full frames\n", width, height);
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            damage_target_shutdown();
+            damage_target.available = false;
+            return false;
+        }
+    }
+    if (renderer != t.renderer) {
+        t.renderer = renderer;
+        damage_invalidate(d, "renderer switched");
+    }
+
+    {
+        PROFILE_ZONE("damage_track");
+        damage_track(d, draw_data);
+    }
+    glClearColor(clear.x * clear.w, clear.y * clear.w, clear.z * clear.w, clear.w);
+    if (d.full) {
+        glClear(GL_COLOR_BUFFER_BIT);
+        return true;
+    }
+    glEnable(GL_SCISSOR_TEST);
+    for (int i = 0; i < d.rect_count; ++i) {
+        const Damage_Rect& r = d.rects[i];
+        glScissor(r.x0, height - r.y1, r.x1 - r.x0, r.y1 - r.y0); // GL's origin is the bottom left
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+    glDisable(GL_SCISSOR_TEST);
+    damage_clip_begin(damage_clip, draw_data, d);
+    return true;
+}
+
+// Puts draw_data's commands back and copies the target to the window
+static void damage_target_present(ImDrawData* draw_data) {
+    auto& t = damage_target;
+    damage_clip_end(damage_clip, draw_data);
+    PROFILE_ZONE("damage present");
+    glDisable(GL_SCISSOR_TEST); // blits are scissored
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, t.framebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, t.width, t.height, 0, 0, t.width, t.height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+// On the thread that renders, after the frame
+static void damage_target_fill_report(Damage_Target_Report& out) {
+    const auto& t = damage_target;
+    out.available = t.available;
+    out.width     = t.framebuffer ? t.width : 0;
+    out.height    = t.framebuffer ? t.height : 0;
+    damage_fill_report(damage_tracker, out.damage);
+}
+
+#else
+
+// NOTE(WALKER): WebGL1 / ES2 build, no glBlitFramebuffer(): always full frames
+static void damage_target_shutdown() {}
+static bool damage_target_begin(ImDrawData*, int, ImVec4, const Damage_Settings&) {
+    damage_invalidate(damage_tracker, "needs GL 3.0 / WebGL2");
+    return false;
+}
+static void damage_target_present(ImDrawData*) {}
+static void damage_target_fill_report(Damage_Target_Report& out) { out.available = false; }
+
+#endif
+
+// NOTE(WALKER): Shown in the menu bar "Performance" menu
+static void damage_target_show_menu() {
+    if (!damage_target_report.available) {
+        ImGui::TextDisabled("Damage tracking: full frames only (needs GL 3.0 / WebGL2)");
+        return;
+    }
+    damage_show_menu(damage_settings, damage_target_report.damage);
+}
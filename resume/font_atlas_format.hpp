@@ -0,0 +1,62 @@
+// NOTE(WALKER): Binary layout of the pre-baked font atlas (gen/atlas/fonts.atlas).
+//               Written by the build tool (tools/atlas_baker.cpp), which runs the exact same fonts_load() as the runtime
+//               natively, and read by fonts_load_baked() (fonts.cpp), which puts it straight into an ImFontAtlas: no
+//               FreeType, no rasterizing, no SDF conversion on the client. No ImGui in here.
+//
+//               [Atlas_Header][Atlas_Bucket * bucket_count] then per bucket, at its offset:
+//               [Atlas_Font * font_count][Atlas_Glyph * glyph_count][Alpha8 pixels, tex_width * tex_height]
+//
+//               A bucket is one complete atlas: the SDF one (scales freely) or a raster one baked at one display size.
+//               The runtime only reads the bucket it picked. Everything is 4 byte aligned little endian PODs.
+
+#pragma once
+
+#include <stdint.h>
+
+constexpr uint32_t ATLAS_MAGIC   = 0x544E4652; // "RFNT"
+constexpr uint16_t ATLAS_VERSION = 1;
+
+enum Atlas_Mode : uint8_t {
+    Atlas_Mode_Raster = 0, // same values as Font_Mode
+    Atlas_Mode_SDF    = 1,
+};
+
+struct Atlas_Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t bucket_count;
+    uint32_t total_size;
+    uint32_t bucket_offset;
+};
+
+struct Atlas_Bucket {
+    uint8_t  mode;
+    uint8_t  reserved;
+    uint16_t font_count;
+    float    bake_size;
+    uint16_t tex_width, tex_height;
+    float    white_u, white_v; // ImFontAtlas::TexUvWhitePixel
+    uint32_t glyph_count;
+    uint32_t offset;           // fonts, then glyphs, then pixels
+    uint32_t size;
+};
+
+struct Atlas_Font {
+    char     name[40];         // ImFontConfig::Name, what GetDebugName() returns
+    float    size;
+    float    ascent, descent;
+    uint32_t first_glyph;      // into this bucket's glyphs
+    uint32_t glyph_count;
+};
+
+struct Atlas_Glyph {
+    uint32_t codepoint;
+    float    advance_x;
+    float    x0, y0, x1, y1;
+    float    u0, v0, u1, v1;
+};
+
+static_assert(sizeof(Atlas_Header) == 16, "Atlas_Header layout changed, bump ATLAS_VERSION");
+static_assert(sizeof(Atlas_Bucket) == 32, "Atlas_Bucket layout changed, bump ATLAS_VERSION");
+static_assert(sizeof(Atlas_Font)   == 60, "Atlas_Font layout changed, bump ATLAS_VERSION");
+static_assert(sizeof(Atlas_Glyph)  == 40, "Atlas_Glyph layout changed, bump ATLAS_VERSION");
@@ -0,0 +1,765 @@
+#include "fonts.hpp"
+#include "font_atlas_format.hpp"
+#include "asset_pack.hpp"
+
+#include "imgui.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+#include "../Utilities/defer.hpp"
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#endif
+
+// NOTE(WALKER): Generated by tools/collect_glyphs (see Makefile), the exact codepoints the subset fonts in gen/fonts still contain
+#if __has_include("glyph_ranges.h")
+#include "glyph_ranges.h"
+#define FONT_GLYPH_RANGES RESUME_GLYPH_RANGES
+#else
+#define FONT_GLYPH_RANGES nullptr // ImGui's default Basic Latin + Latin Supplement
+#endif
+
+Font_State font_state;
+
+// NOTE(WALKER): The first face is the default font and the only one preloaded (see Makefile), the rest are streamed in.
+//               Atlas order always follows this list, whatever order the faces arrive in.
+static const char* FONT_FILES[] = {
+    "fonts/JetBrainsMono-Regular.ttf",
+    "fonts/LiberationSans-Regular.ttf",
+    "fonts/LinLibertine_RBah.ttf",
+    "fonts/times new roman.ttf",
+    "fonts/ProggyClean.ttf",
+};
+static constexpr int FONT_COUNT = (int)(sizeof(FONT_FILES) / sizeof(FONT_FILES[0]));
+
+enum Face_State {
+    Face_Pending,  // not requested yet (native or in the font pack: read by fonts_update(), one per frame)
+    Face_Fetching, // web: download in flight
+    Face_Arrived,  // TTF bytes in memory, not in io.Fonts yet
+    Face_In_Atlas,
+    Face_Failed,
+};
+
+// TTF bytes are ours (FontDataOwnedByAtlas = false) so the live atlas and the one being built next can share them
+struct Font_Face {
+    Face_State state = Face_Pending;
+    void*      data  = nullptr;
+    int        size  = 0;
+    bool       from_pack = false; // data belongs to font_pack, not us
+};
+static Font_Face faces[FONT_COUNT];
+
+// NOTE(WALKER): Set by fonts_open_pack(). Faces in it are looked up by their FONT_FILES path and decompressed when read (one
+//               per frame like the native files), faces that aren't fall back to the file system / fetch.
+//               Face data from the pack belongs to the pack, which stays open as long as any atlas might use it.
+static Asset_Pack font_pack;
+
+// Atlas being built in the background: FreeType build in one go, then the SDF conversion sliced across frames
+struct Sdf_Job {
+    ImFontAtlas*   atlas    = nullptr;
+    unsigned char* coverage = nullptr;
+    int            font     = 0;
+    int            glyph    = 0;
+};
+
+struct Staging_Atlas {
+    ImFontAtlas* atlas = nullptr;
+    float        bake_size = 0.0f;
+    Sdf_Job      sdf;
+    bool         included[FONT_COUNT] = {};
+    int          frames = 0;
+    double       start_ms = 0.0;
+};
+static Staging_Atlas staging;
+
+static constexpr double FONT_STREAM_BUDGET_MS = 4.0; // SDF conversion time per frame for a staging atlas
+
+// NOTE(WALKER): Atlases we switched away from, by mode + quantized bake size, so going back to a size (un-maximizing,
+//               dragging the window back to the other monitor) is a pointer swap instead of a rebuild.
+//               io.Fonts itself is never in here, and an entry with fewer faces than io.Fonts is stale.
+struct Cached_Atlas {
+    ImFontAtlas* atlas     = nullptr;
+    Font_Mode    mode      = Font_Mode_SDF;
+    float        bake_size = 0.0f;
+    int          faces     = 0;
+    unsigned     last_used = 0;
+};
+static constexpr int FONT_ATLAS_CACHE_SIZE = 4;
+static Cached_Atlas atlas_cache[FONT_ATLAS_CACHE_SIZE];
+static unsigned     atlas_cache_clock = 0;
+
+static constexpr float  FONT_SCALE_QUANTUM    = 1.0f;   // raster atlases are baked at whole pixel sizes, FontGlobalScale does the rest
+static constexpr double FONT_RESCALE_DELAY_MS = 250.0;  // wait for a window drag-resize to settle before rebuilding
+static double rescale_request_ms = 0.0;
+
+static double now_ms() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+float fonts_sdf_smoothing(float scale) {
+    // One atlas pixel moves the field by 1/(2*SPREAD), one screen pixel is 1/scale atlas pixels.
+    // A ramp one screen pixel wide is +/- half of that around the 0.5 iso line.
+    if (scale <= 0.0f) scale = 1.0f;
+    const float smoothing = 0.5f / (2.0f * SDF_SPREAD * scale);
+    return smoothing > 0.5f ? 0.5f : smoothing;
+}
+
+static void sdf_job_begin(Sdf_Job& job, ImFontAtlas* atlas) {
+    unsigned char* pixels = nullptr;
+    int tex_w = 0, tex_h = 0;
+    atlas->GetTexDataAsAlpha8(&pixels, &tex_w, &tex_h);
+    job = Sdf_Job();
+    job.atlas = atlas;
+    if (!pixels) return;
+
+    // NOTE(WALKER): Work from a copy of the coverage so the field we write never feeds back into itself
+    const size_t tex_size = (size_t)tex_w * (size_t)tex_h;
+    job.coverage = (unsigned char*)IM_ALLOC(tex_size);
+    memcpy(job.coverage, pixels, tex_size);
+}
+
+static void sdf_convert_glyph(ImFontGlyph& glyph, unsigned char* pixels, const unsigned char* coverage, int tex_w, int tex_h) {
+    const int spread = SDF_SPREAD;
+    const int radius = spread + 1;
+
+    // Glyph pixel rect in the atlas
+    const int gx0 = (int)roundf(glyph.U0 * tex_w);
+    const int gy0 = (int)roundf(glyph.V0 * tex_h);
+    const int gx1 = (int)roundf(glyph.U1 * tex_w);
+    const int gy1 = (int)roundf(glyph.V1 * tex_h);
+
+    // Field rect: grown by the spread, which lands inside this glyph's own padding
+    const int fx0 = gx0 - spread > 0 ? gx0 - spread : 0, fy0 = gy0 - spread > 0 ? gy0 - spread : 0;
+    const int fx1 = gx1 + spread < tex_w ? gx1 + spread : tex_w, fy1 = gy1 + spread < tex_h ? gy1 + spread : tex_h;
+
+    for (int y = fy0; y < fy1; ++y) {
+        for (int x = fx0; x < fx1; ++x) {
+            const bool in_glyph = x >= gx0 && x < gx1 && y >= gy0 && y < gy1;
+            const int  c = in_glyph ? coverage[y * tex_w + x] : 0;
+
+            float signed_dist;
+            if (c > 0 && c < 255) {
+                // Partially covered pixel, coverage is already a sub-pixel distance to the edge
+                signed_dist = (float)c / 255.0f - 0.5f;
+            } else {
+                const bool inside = c >= 128;
+                int best_sq = radius * radius * 2;
+                for (int dy = -radius; dy <= radius; ++dy) {
+                    const int sy = y + dy;
+                    for (int dx = -radius; dx <= radius; ++dx) {
+                        const int sx = x + dx;
+                        const bool s_in_glyph = sx >= gx0 && sx < gx1 && sy >= gy0 && sy < gy1;
+                        const int  sc = s_in_glyph ? coverage[sy * tex_w + sx] : 0;
+                        if ((sc >= 128) != inside) {
+                            const int d_sq = dx * dx + dy * dy;
+                            if (d_sq < best_sq) best_sq = d_sq;
+                        }
+                    }
+                }
+                const float dist = sqrtf((float)best_sq) - 0.5f;
+                signed_dist = inside ? dist : -dist;
+            }
+
+            float value = 0.5f + signed_dist / (2.0f * spread);
+            value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+            pixels[y * tex_w + x] = (unsigned char)(value * 255.0f + 0.5f);
+        }
+    }
+
+    // Grow the quad so the shader sees the whole field (metrics/advance stay untouched so layout is identical)
+    const float grow_x = (float)(gx0 - fx0), grow_y = (float)(gy0 - fy0);
+    const float grow_x1 = (float)(fx1 - gx1), grow_y1 = (float)(fy1 - gy1);
+    glyph.X0 -= grow_x;  glyph.Y0 -= grow_y;
+    glyph.X1 += grow_x1; glyph.Y1 += grow_y1;
+    glyph.U0 = (float)fx0 / tex_w; glyph.V0 = (float)fy0 / tex_h;
+    glyph.U1 = (float)fx1 / tex_w; glyph.V1 = (float)fy1 / tex_h;
+}
+
+// Converts glyphs until the budget runs out (budget_ms < 0: all of them). Returns true once the whole atlas is done.
+static bool sdf_job_step(Sdf_Job& job, double budget_ms) {
+    if (!job.coverage) return true;
+    unsigned char* pixels = job.atlas->TexPixelsAlpha8;
+    const int tex_w = job.atlas->TexWidth, tex_h = job.atlas->TexHeight;
+    const double start = now_ms();
+
+    for (; job.font < job.atlas->Fonts.Size; ++job.font, job.glyph = 0) {
+        ImFont* font = job.atlas->Fonts[job.font];
+        for (; job.glyph < font->Glyphs.Size; ++job.glyph) {
+            if (budget_ms >= 0.0 && now_ms() - start >= budget_ms) return false;
+            ImFontGlyph& glyph = font->Glyphs[job.glyph];
+            if (glyph.Visible) sdf_convert_glyph(glyph, pixels, job.coverage, tex_w, tex_h);
+        }
+    }
+
+    IM_FREE(job.coverage);
+    job.coverage = nullptr;
+    return true;
+}
+
+void fonts_convert_atlas_to_sdf(ImFontAtlas* atlas) {
+    Sdf_Job job;
+    sdf_job_begin(job, atlas);
+    sdf_job_step(job, -1.0);
+}
+
+//-----------------------------------------------------------------------------
+// Faces
+//-----------------------------------------------------------------------------
+
+static void face_set_data(int index, const void* data, int size) {
+    Font_Face& face = faces[index];
+    face.data = IM_ALLOC((size_t)size);
+    memcpy(face.data, data, (size_t)size);
+    face.size  = size;
+    face.state = Face_Arrived;
+    face.from_pack = false;
+}
+
+static bool face_read_pack(int index, int entry) {
+    size_t size = 0;
+    const void* data = asset_pack_get(font_pack, entry, &size);
+    if (!data || size > 0x7FFFFFFF) {
+        fprintf(stderr, "[fonts] failed to load %s from the font pack\n", FONT_FILES[index]);
+        faces[index].state = Face_Failed;
+        return false;
+    }
+    faces[index].data  = (void*)data; // read only, FontDataOwnedByAtlas = false
+    faces[index].size  = (int)size;
+    faces[index].state = Face_Arrived;
+    faces[index].from_pack = true;
+    if (font_pack.entries_loaded == (int)font_pack.header->entry_count)
+        printf("[fonts] font pack fully read: %.1f KB decompressed in %.2f ms, peak %.1f KB of heap (the TTFs alone: %.1f KB)\n",
+               font_pack.decompressed / 1024.0, font_pack.decompress_ms, font_pack.heap_peak / 1024.0, font_pack.raw_size / 1024.0);
+    return true;
+}
+
+static bool face_read_file(int index) {
+    if (font_pack.header) {
+        const int entry = asset_pack_find(font_pack, FONT_FILES[index]);
+        if (entry >= 0) return face_read_pack(index, entry);
+    }
+    FILE* f = fopen(FONT_FILES[index], "rb");
+    if (!f) {
+        fprintf(stderr, "[fonts] failed to load %s\n", FONT_FILES[index]);
+        faces[index].state = Face_Failed;
+        return false;
+    }
+    fseek(f, 0, SEEK_END);
+    const long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    void* data = size > 0 ? IM_ALLOC((size_t)size) : nullptr;
+    const bool ok = data && fread(data, 1, (size_t)size, f) == (size_t)size;
+    fclose(f);
+    if (!ok) {
+        if (data) IM_FREE(data);
+        fprintf(stderr, "[fonts] failed to read %s\n", FONT_FILES[index]);
+        faces[index].state = Face_Failed;
+        return false;
+    }
+    faces[index].data  = data;
+    faces[index].size  = (int)size;
+    faces[index].state = Face_Arrived;
+    return true;
+}
+
+#ifdef __EMSCRIPTEN__
+static void face_fetched(void* arg, void* buffer, int size) {
+    const int index = (int)(intptr_t)arg;
+    face_set_data(index, buffer, size); // emscripten frees buffer when we return
+    printf("[fonts] %s arrived (%.1f KB)\n", FONT_FILES[index], size / 1024.0);
+}
+
+static void face_fetch_failed(void* arg) {
+    const int index = (int)(intptr_t)arg;
+    faces[index].state = Face_Failed;
+    fprintf(stderr, "[fonts] failed to fetch %s\n", FONT_FILES[index]);
+}
+
+// NOTE(WALKER): Same relative path as the file system one, served next to resume.html (spaces need escaping in a URL)
+static void face_fetch(int index) {
+    char url[256];
+    size_t n = 0;
+    for (const char* c = FONT_FILES[index]; *c && n + 4 < sizeof(url); ++c) {
+        if (*c == ' ') { memcpy(url + n, "%20", 3); n += 3; }
+        else url[n++] = *c;
+    }
+    url[n] = 0;
+    faces[index].state = Face_Fetching;
+    emscripten_async_wget_data(url, (void*)(intptr_t)index, face_fetched, face_fetch_failed);
+}
+#endif
+
+// True when face_read_file() can have the face right away: native files, or the font pack on the web (no fetch needed)
+static bool face_local(int index) {
+#ifdef __EMSCRIPTEN__
+    return asset_pack_find(font_pack, FONT_FILES[index]) >= 0;
+#else
+    (void)index;
+    return true;
+#endif
+}
+
+// Starts loading every face that isn't on its way yet
+static void faces_request_all() {
+    for (int i = 1; i < FONT_COUNT; ++i) {
+        if (faces[i].state != Face_Pending || face_local(i)) continue;
+#ifdef __EMSCRIPTEN__
+        face_fetch(i);
+#endif
+    }
+}
+
+static const char* face_name(int index) {
+    const char* slash = strrchr(FONT_FILES[index], '/');
+    return slash ? slash + 1 : FONT_FILES[index];
+}
+
+// Adds every face that's in memory (list order) and runs the FreeType build, no SDF conversion yet
+static bool fonts_build_atlas(ImFontAtlas* atlas, bool included[FONT_COUNT], float bake_size) {
+    atlas->Clear();
+
+    // NOTE(WALKER): No baked AA lines/cursor images, only the 2x2 white pixel rect, which always packs at the atlas origin
+    //               and therefore can never sit inside a glyph's distance field padding.
+    if (font_state.mode == Font_Mode_SDF) {
+        atlas->Flags |= ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_NoMouseCursors;
+        atlas->TexGlyphPadding = 2 * SDF_SPREAD;
+    } else {
+        atlas->Flags &= ~(ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_NoMouseCursors);
+        atlas->TexGlyphPadding = 1;
+    }
+
+    for (int i = 0; i < FONT_COUNT; ++i) {
+        included[i] = false;
+        if (faces[i].state != Face_Arrived && faces[i].state != Face_In_Atlas) continue;
+        ImFontConfig config;
+        config.FontDataOwnedByAtlas = false;
+        snprintf(config.Name, sizeof(config.Name), "%s, %.0fpx", face_name(i), bake_size);
+        included[i] = atlas->AddFontFromMemoryTTF(faces[i].data, faces[i].size, bake_size, &config, FONT_GLYPH_RANGES) != nullptr;
+    }
+    if (atlas->Fonts.Size == 0)
+        atlas->AddFontDefault();
+    return atlas->Build();
+}
+
+static void faces_mark_in_atlas(const bool included[FONT_COUNT]) {
+    font_state.faces_in_atlas = 0;
+    for (int i = 0; i < FONT_COUNT; ++i) {
+        if (included[i]) faces[i].state = Face_In_Atlas;
+        if (faces[i].state == Face_In_Atlas) ++font_state.faces_in_atlas;
+    }
+}
+
+static void staging_cancel() {
+    if (!staging.atlas) return;
+    if (staging.sdf.coverage) IM_FREE(staging.sdf.coverage);
+    IM_DELETE(staging.atlas);
+    staging = Staging_Atlas();
+}
+
+static float fonts_quantize(float display_size) {
+    const float size = roundf(display_size / FONT_SCALE_QUANTUM) * FONT_SCALE_QUANTUM;
+    return size < 6.0f ? 6.0f : size;
+}
+
+static void cache_flush() {
+    for (Cached_Atlas& c : atlas_cache) {
+        if (c.atlas) IM_DELETE(c.atlas);
+        c = Cached_Atlas();
+    }
+}
+
+// Empty slot first, otherwise the least recently used one goes
+static void cache_put(ImFontAtlas* atlas, Font_Mode mode, float bake_size, int faces) {
+    Cached_Atlas* slot = &atlas_cache[0];
+    for (Cached_Atlas& c : atlas_cache) {
+        if (!c.atlas) { slot = &c; break; }
+        if (c.last_used < slot->last_used) slot = &c;
+    }
+    if (slot->atlas) IM_DELETE(slot->atlas);
+    slot->atlas     = atlas;
+    slot->mode      = mode;
+    slot->bake_size = bake_size;
+    slot->faces     = faces;
+    slot->last_used = ++atlas_cache_clock;
+}
+
+static ImFontAtlas* cache_take(Font_Mode mode, float bake_size) {
+    for (Cached_Atlas& c : atlas_cache) {
+        if (!c.atlas || c.mode != mode || c.bake_size != bake_size || c.faces != font_state.faces_in_atlas) continue;
+        ImFontAtlas* atlas = c.atlas;
+        c = Cached_Atlas();
+        return atlas;
+    }
+    return nullptr;
+}
+
+// Makes atlas io.Fonts between frames. The previous one goes to the cache, or away when the new one has more faces
+// (then every cached atlas is stale too). Nothing holds on to ImFont pointers except io.FontDefault, remapped by name.
+static void fonts_swap_atlas(ImGuiIO& io, ImFontAtlas* atlas, float bake_size, int faces) {
+    ImFont* new_default = nullptr;
+    if (io.FontDefault) {
+        for (ImFont* font : atlas->Fonts)
+            if (strcmp(font->GetDebugName(), io.FontDefault->GetDebugName()) == 0) new_default = font;
+    }
+    ImFontAtlas* old_atlas = io.Fonts;
+    io.Fonts       = atlas;
+    io.FontDefault = new_default;
+    if (faces > font_state.faces_in_atlas) {
+        IM_DELETE(old_atlas);
+        cache_flush();
+    } else {
+        cache_put(old_atlas, font_state.mode, font_state.bake_size, font_state.faces_in_atlas);
+    }
+    font_state.bake_size = bake_size;
+    io.FontGlobalScale   = font_state.display_size / bake_size;
+    ++font_state.atlas_switches;
+    ++font_state.atlas_builds; // new ImFont pointers and UVs as far as the text caches are concerned
+}
+
+// Synchronous (re)build of io.Fonts with whatever faces are in memory
+static bool fonts_build(ImGuiIO& io) {
+    const double start = now_ms();
+    staging_cancel(); // anything it had is in this build too
+    cache_flush();    // and might have more faces than any cached atlas
+    bool included[FONT_COUNT];
+    if (!fonts_build_atlas(io.Fonts, included, font_state.bake_size))
+        return false;
+
+    if (font_state.mode == Font_Mode_SDF)
+        fonts_convert_atlas_to_sdf(io.Fonts);
+
+    faces_mark_in_atlas(included);
+    ++font_state.atlas_builds;
+    font_state.last_build_ms     = now_ms() - start;
+    font_state.last_build_frames = 1;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Pre-baked atlas (font_atlas_format.hpp)
+//-----------------------------------------------------------------------------
+
+#ifdef RESUME_BAKED_FONTS
+static constexpr const char* BAKED_ATLAS_PATH = "fonts/fonts.atlas";
+#endif
+
+// Bucket table of the blob io.Fonts came from, kept so a display size change can tell if it needs another bucket
+static Atlas_Bucket baked_buckets[16];
+static int          baked_bucket_count = 0;
+static int          baked_bucket       = -1;
+static const char*  baked_path         = nullptr;
+
+static bool read_at(FILE* f, uint32_t offset, void* out, size_t size) {
+    return fseek(f, (long)offset, SEEK_SET) == 0 && fread(out, 1, size, f) == size;
+}
+
+// The SDF bucket, or the raster bucket baked closest to the display size
+static int baked_pick_bucket(Font_Mode mode, float display_size) {
+    int best = -1;
+    for (int i = 0; i < baked_bucket_count; ++i) {
+        if (baked_buckets[i].mode != (uint8_t)mode) continue;
+        if (best < 0 || fabsf(baked_buckets[i].bake_size - display_size) < fabsf(baked_buckets[best].bake_size - display_size)) best = i;
+    }
+    return best;
+}
+
+static bool baked_fail(const char* path, const char* msg) {
+    fprintf(stderr, "[fonts] %s: %s\n", path, msg);
+    return false;
+}
+
+static bool baked_read_table(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return baked_fail(path, "can't open");
+    defer { fclose(f); };
+
+    Atlas_Header header;
+    if (!read_at(f, 0, &header, sizeof(header)) || header.magic != ATLAS_MAGIC || header.version != ATLAS_VERSION)
+        return baked_fail(path, "not a font atlas, or an older version (rebuild it)");
+    if (header.bucket_count > IM_ARRAYSIZE(baked_buckets) || !read_at(f, header.bucket_offset, baked_buckets, header.bucket_count * sizeof(Atlas_Bucket)))
+        return baked_fail(path, "bad bucket table");
+    for (int i = 0; i < header.bucket_count; ++i) {
+        if (baked_buckets[i].offset + (size_t)baked_buckets[i].size > header.total_size)
+            return baked_fail(path, "bucket out of bounds");
+    }
+    baked_bucket_count = header.bucket_count;
+    baked_path         = path;
+    return true;
+}
+
+// Reads and checks everything first, atlas is only touched once the bucket is known good
+static bool baked_load_bucket(ImFontAtlas* atlas, int pick) {
+    const char* path = baked_path;
+    const Atlas_Bucket& bucket = baked_buckets[pick];
+    const size_t table_size = bucket.font_count * sizeof(Atlas_Font) + bucket.glyph_count * sizeof(Atlas_Glyph);
+    const size_t pixel_size = (size_t)bucket.tex_width * bucket.tex_height;
+    if (table_size + pixel_size > bucket.size || pixel_size == 0)
+        return baked_fail(path, "bucket out of bounds");
+
+    FILE* f = fopen(path, "rb");
+    if (!f) return baked_fail(path, "can't open");
+    defer { fclose(f); };
+
+    // NOTE(WALKER): The pixels are read straight into the buffer the atlas ends up owning (ClearTexData() IM_FREEs it)
+    void*          table  = IM_ALLOC(table_size);
+    unsigned char* pixels = (unsigned char*)IM_ALLOC(pixel_size);
+    defer { IM_FREE(table); };
+    if (!read_at(f, bucket.offset, table, table_size) || !read_at(f, bucket.offset + (uint32_t)table_size, pixels, pixel_size)) {
+        IM_FREE(pixels);
+        return baked_fail(path, "truncated bucket");
+    }
+    const Atlas_Font*  fonts  = (const Atlas_Font*)table;
+    const Atlas_Glyph* glyphs = (const Atlas_Glyph*)(fonts + bucket.font_count);
+    for (int i = 0; i < bucket.font_count; ++i) {
+        if ((size_t)fonts[i].first_glyph + fonts[i].glyph_count > bucket.glyph_count) {
+            IM_FREE(pixels);
+            return baked_fail(path, "glyph range out of bounds");
+        }
+    }
+
+    atlas->Clear();
+    atlas->Flags |= ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_NoMouseCursors; // only what the blob has
+    atlas->TexGlyphPadding = bucket.mode == Atlas_Mode_SDF ? 2 * SDF_SPREAD : 1;
+
+    // Configs first: fonts point into ConfigData, which must not grow after that
+    atlas->ConfigData.reserve(bucket.font_count);
+    for (int i = 0; i < bucket.font_count; ++i) {
+        ImFontConfig config;
+        config.FontDataOwnedByAtlas = false; // there is no TTF data, only the name for GetDebugName()
+        config.SizePixels = fonts[i].size;
+        memcpy(config.Name, fonts[i].name, sizeof(config.Name));
+        config.Name[sizeof(config.Name) - 1] = 0;
+        atlas->ConfigData.push_back(config);
+    }
+    for (int i = 0; i < bucket.font_count; ++i) {
+        ImFont* font = IM_NEW(ImFont)();
+        atlas->Fonts.push_back(font);
+        atlas->ConfigData[i].DstFont = font;
+        font->ContainerAtlas  = atlas;
+        font->ConfigData      = &atlas->ConfigData[i];
+        font->ConfigDataCount = 1;
+        font->FontSize        = fonts[i].size;
+        font->Ascent          = fonts[i].ascent;
+        font->Descent         = fonts[i].descent;
+        for (uint32_t g = fonts[i].first_glyph; g < fonts[i].first_glyph + fonts[i].glyph_count; ++g) {
+            const Atlas_Glyph& glyph = glyphs[g];
+            // No config: the blob already has the final (snapped, SDF-grown) quads
+            font->AddGlyph(nullptr, (ImWchar)glyph.codepoint, glyph.x0, glyph.y0, glyph.x1, glyph.y1, glyph.u0, glyph.v0, glyph.u1, glyph.v1, glyph.advance_x);
+        }
+        font->BuildLookupTable();
+    }
+    atlas->TexPixelsAlpha8 = pixels;
+    atlas->TexWidth        = bucket.tex_width;
+    atlas->TexHeight       = bucket.tex_height;
+    atlas->TexUvScale      = ImVec2(1.0f / bucket.tex_width, 1.0f / bucket.tex_height);
+    atlas->TexUvWhitePixel = ImVec2(bucket.white_u, bucket.white_v);
+    atlas->TexReady        = true;
+    return true;
+}
+
+bool fonts_load_baked(ImGuiIO& io, const char* path, Font_Mode mode, float display_size) {
+    const double start = now_ms();
+    if (!baked_read_table(path)) return false;
+    const int pick = baked_pick_bucket(mode, display_size);
+    if (pick < 0) return baked_fail(path, mode == Font_Mode_SDF ? "no SDF bucket" : "no raster bucket");
+
+    staging_cancel();
+    cache_flush();
+    if (!baked_load_bucket(io.Fonts, pick)) return false;
+
+    const Atlas_Bucket& bucket = baked_buckets[pick];
+    baked_bucket = pick;
+    font_state.mode              = mode;
+    font_state.display_size      = display_size;
+    font_state.bake_size         = bucket.bake_size;
+    font_state.target_bake_size  = bucket.bake_size;
+    font_state.baked             = true;
+    font_state.faces_in_atlas    = bucket.font_count;
+    font_state.faces_total       = FONT_COUNT;
+    font_state.last_build_ms     = now_ms() - start;
+    font_state.last_build_frames = 1;
+    ++font_state.atlas_builds;
+    io.FontGlobalScale = display_size / bucket.bake_size;
+    return true;
+}
+
+bool fonts_open_pack(const char* path) {
+    if (font_pack.header) return true;
+    if (!asset_pack_load_file(font_pack, path)) return false;
+    printf("[fonts] faces come from %s (%.1f KB for %.1f KB of TTFs, read in %.2f ms)\n",
+           path, font_pack.size / 1024.0, font_pack.raw_size / 1024.0, font_pack.load_ms);
+    return true;
+}
+
+bool fonts_load(ImGuiIO& io, Font_Mode mode, float display_size) {
+#ifdef RESUME_BAKED_FONTS
+    if (fonts_load_baked(io, BAKED_ATLAS_PATH, mode, display_size)) return true;
+    // NOTE(WALKER): This build ships no TTFs and no FreeType, there's nothing to build the real faces from. Every face is
+    //               marked failed (no fetches that can only 404) and fonts_build() falls back to ImGui's built-in font.
+    fprintf(stderr, "[fonts] no usable baked atlas at %s and no TTFs in this build, falling back to ImGui's default font\n", BAKED_ATLAS_PATH);
+    for (Font_Face& face : faces) face.state = Face_Failed;
+#endif
+    font_state.baked        = false;
+    font_state.mode         = mode;
+    font_state.display_size = display_size;
+    font_state.bake_size    = mode == Font_Mode_SDF ? SDF_BAKE_SIZE : fonts_quantize(display_size);
+    font_state.target_bake_size = font_state.bake_size;
+    font_state.faces_total  = FONT_COUNT;
+    io.FontGlobalScale      = font_state.display_size / font_state.bake_size;
+
+    // NOTE(WALKER): Only the default face gates the first frame, everything else streams in through fonts_update()
+    if (faces[0].state == Face_Pending)
+        face_read_file(0);
+    faces_request_all();
+    return fonts_build(io);
+}
+
+bool fonts_has_pending_work() {
+    if (font_state.baked) return false;
+    if (staging.atlas || font_state.target_bake_size != font_state.bake_size) return true;
+    for (const Font_Face& face : faces)
+        if (face.state == Face_Arrived) return true;
+    for (int i = 0; i < FONT_COUNT; ++i)
+        if (faces[i].state == Face_Pending && face_local(i)) return true;
+    return false;
+}
+
+bool fonts_update(ImGuiIO& io) {
+    if (font_state.baked) return false; // every face is in the blob
+    // Native stand-in for the background fetches, and the font pack's lazy decompression: one face per frame
+    for (int i = 1; i < FONT_COUNT; ++i) {
+        if (faces[i].state != Face_Pending || !face_local(i)) continue;
+        face_read_file(i);
+        break;
+    }
+
+    if (!staging.atlas) {
+        bool arrived = false;
+        for (const Font_Face& face : faces)
+            arrived |= face.state == Face_Arrived;
+        const bool rescale = font_state.target_bake_size != font_state.bake_size;
+        if (!arrived && !rescale) return false;
+        if (!arrived && now_ms() - rescale_request_ms < FONT_RESCALE_DELAY_MS) return false; // still resizing
+
+        // Everything in memory right now goes into one new atlas, faces arriving meanwhile wait for the next one
+        staging.atlas     = IM_NEW(ImFontAtlas)();
+        staging.bake_size = font_state.target_bake_size;
+        staging.start_ms  = now_ms();
+        if (!fonts_build_atlas(staging.atlas, staging.included, staging.bake_size)) {
+            fprintf(stderr, "[fonts] staging atlas build failed\n");
+            for (int i = 0; i < FONT_COUNT; ++i)
+                if (staging.included[i] && faces[i].state == Face_Arrived) faces[i].state = Face_Failed;
+            staging_cancel();
+            font_state.target_bake_size = font_state.bake_size; // don't retry a size that can't be built every frame
+            return false;
+        }
+        if (font_state.mode == Font_Mode_SDF)
+            sdf_job_begin(staging.sdf, staging.atlas);
+    }
+
+    ++staging.frames;
+    if (!sdf_job_step(staging.sdf, FONT_STREAM_BUDGET_MS))
+        return false;
+
+    int staged_faces = 0;
+    for (bool included : staging.included)
+        staged_faces += included;
+    fonts_swap_atlas(io, staging.atlas, staging.bake_size, staged_faces);
+    faces_mark_in_atlas(staging.included);
+    font_state.last_build_ms     = now_ms() - staging.start_ms;
+    font_state.last_build_frames = staging.frames;
+    printf("[fonts] atlas now has %d/%d faces at %.0fpx (built over %d frames, %.1f ms)\n",
+           font_state.faces_in_atlas, FONT_COUNT, font_state.bake_size, staging.frames, font_state.last_build_ms);
+    staging = Staging_Atlas();
+    return true;
+}
+
+void fonts_finish_streaming(ImGuiIO& io) {
+    if (font_state.baked) return;
+    for (int i = 1; i < FONT_COUNT; ++i)
+        if (faces[i].state == Face_Pending && face_local(i)) face_read_file(i);
+    bool arrived = staging.atlas != nullptr || font_state.target_bake_size != font_state.bake_size;
+    for (const Font_Face& face : faces)
+        arrived |= face.state == Face_Arrived;
+    if (!arrived) return;
+    font_state.bake_size = font_state.target_bake_size;
+    io.FontGlobalScale   = font_state.display_size / font_state.bake_size;
+    fonts_build(io);
+}
+
+void fonts_shutdown() {
+    staging_cancel();
+    cache_flush();
+    // NOTE(WALKER): Every atlas built from the pack borrows its TTF bytes (FontDataOwnedByAtlas = false), the live one included:
+    //               cleared here so nothing points into the pack once it's freed. DestroyContext() deletes the empty atlas.
+    //               The pack's faces go back to pending, a context created after this (headless runs one per scenario) reads
+    //               them again from whatever pack is opened then.
+    if (ImGui::GetCurrentContext()) ImGui::GetIO().Fonts->Clear();
+    for (Font_Face& face : faces)
+        if (face.from_pack) face = Font_Face();
+    asset_pack_free(font_pack);
+}
+
+bool fonts_set_display_size(ImGuiIO& io, float display_size) {
+    font_state.display_size = display_size;
+    io.FontGlobalScale      = display_size / font_state.bake_size; // NOTE(WALKER): Until another atlas is in, the current one scales
+    if (font_state.mode == Font_Mode_SDF) return false;
+
+    // Raster: the nearest baked bucket, or the quantized size built from the TTFs
+    int   pick      = -1;
+    float bake_size = fonts_quantize(display_size);
+    if (font_state.baked) {
+        pick = baked_pick_bucket(Font_Mode_Raster, display_size);
+        if (pick < 0) return false;
+        bake_size = baked_buckets[pick].bake_size;
+    }
+    if (bake_size == font_state.bake_size) {
+        font_state.target_bake_size = bake_size;
+        if (staging.atlas && staging.bake_size != bake_size && !font_state.baked) staging_cancel(); // went back before it finished
+        return false;
+    }
+
+    ImFontAtlas* atlas = cache_take(font_state.mode, bake_size);
+    if (!atlas && font_state.baked) {
+        // A bucket is a file read, no rasterizing, so there's nothing worth deferring
+        atlas = IM_NEW(ImFontAtlas)();
+        if (!baked_load_bucket(atlas, pick)) {
+            IM_DELETE(atlas);
+            return false;
+        }
+    }
+    if (atlas) {
+        if (font_state.baked) baked_bucket = pick;
+        fonts_swap_atlas(io, atlas, bake_size, font_state.faces_in_atlas);
+        font_state.target_bake_size = bake_size;
+        return true;
+    }
+
+    // Not cached: fonts_update() builds it once the size has settled, the old atlas stays in until then
+    if (staging.atlas && staging.bake_size != bake_size) staging_cancel();
+    font_state.target_bake_size = bake_size;
+    rescale_request_ms = now_ms();
+    return false;
+}
+
+void fonts_show_menu() {
+    const ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    ImGui::Text("Font mode:       %s", font_state.mode == Font_Mode_SDF ? "SDF" : "Raster");
+    ImGui::Text("Atlas source:    %s", font_state.baked ? "pre-baked blob (no rasterizing)" : font_pack.header ? "TTFs from the font pack, built on this machine" : "TTFs, built on this machine");
+    ImGui::Text("Display size:    %.1fpx (baked at %.1fpx)", font_state.display_size, font_state.bake_size);
+    ImGui::Text("Atlas:           %dx%d, %d fonts", atlas->TexWidth, atlas->TexHeight, atlas->Fonts.Size);
+    ImGui::Text("Atlas builds:    %d (last %.1fms over %d frames)", font_state.atlas_builds, font_state.last_build_ms, font_state.last_build_frames);
+    ImGui::Text("Faces:           %d/%d in the atlas%s", font_state.faces_in_atlas, font_state.faces_total, staging.atlas ? ", next atlas building" : "");
+    int cached = 0;
+    for (const Cached_Atlas& c : atlas_cache)
+        cached += c.atlas != nullptr;
+    ImGui::Text("Atlas cache:     %d/%d atlases, %d switches", cached, FONT_ATLAS_CACHE_SIZE, font_state.atlas_switches);
+    for (const Cached_Atlas& c : atlas_cache)
+        if (c.atlas) ImGui::BulletText("%s %.0fpx, %dx%d", c.mode == Font_Mode_SDF ? "SDF" : "raster", c.bake_size, c.atlas->TexWidth, c.atlas->TexHeight);
+    if (font_state.target_bake_size != font_state.bake_size)
+        ImGui::Text("Rescale pending: %.0fpx", font_state.target_bake_size);
+    if (!font_state.baked) asset_pack_show_menu(font_pack);
+}
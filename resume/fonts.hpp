@@ -0,0 +1,89 @@
+// NOTE(WALKER): Font loading for the resume.
+//               All five faces in fonts/ go into the one ImFontAtlas. In SDF mode each face is baked ONCE at a fixed
+//               bake size, the coverage atlas is converted into a signed distance field, and the actual display size is
+//               just a scale factor (io.FontGlobalScale) that the SDF shader keeps crisp. Raster mode is the old behavior
+//               (FreeType rasterizes at the exact display size) and is kept around as a fallback.
+//
+//               Only the default face is read before the first frame. The others stream in afterwards (web: fetched
+//               next to resume.html instead of being in resume.data, native: read one per frame), are built into a
+//               staging atlas whose SDF conversion is spread over frames, and that atlas replaces io.Fonts between frames.
+//               With a font pack open (fonts_open_pack(), asset_pack.hpp) the faces in it are decompressed from the one
+//               preloaded buffer instead, the default face before the first frame and the others one per frame after.
+//               Unless the atlas was pre-baked at build time (fonts_load_baked()), then none of the above runs on the client.
+
+#pragma once
+
+#include "imgui.h"
+
+enum Font_Mode {
+    Font_Mode_Raster = 0, // rasterize at the display size, any size change is a full atlas rebuild
+    Font_Mode_SDF    = 1, // bake once at SDF_BAKE_SIZE, scale freely in the shader
+};
+
+// NOTE(WALKER): Bake parameters, in atlas pixels. SPREAD is how far the distance field reaches outside the glyph outline.
+//               The atlas glyph padding is 2*SPREAD so neighbouring glyph fields never overlap.
+constexpr float SDF_BAKE_SIZE = 32.0f;
+constexpr int   SDF_SPREAD    = 4;
+
+struct Font_State {
+    Font_Mode mode         = Font_Mode_SDF;
+    float     display_size = 13.0f; // what the user actually sees, in framebuffer pixels
+    float     bake_size    = 13.0f; // what the atlas was built at
+    float     target_bake_size = 13.0f; // what a display size change asked for, != bake_size while that atlas is on its way
+    int       atlas_builds = 0;     // bumped whenever io.Fonts changes (rebuilt or swapped), text caches key on it
+    double    last_build_ms = 0.0;  // first FreeType build -> atlas in use
+    int       last_build_frames = 0;
+    int       faces_in_atlas = 0;
+    int       faces_total    = 0;
+    bool      baked          = false; // io.Fonts came from a pre-baked blob (fonts_load_baked()), not from the TTFs
+    int       atlas_switches = 0;     // io.Fonts replaced by another (new or cached) atlas
+};
+
+extern Font_State font_state;
+
+// Builds io.Fonts (SDF-converted in Font_Mode_SDF) from the default face plus any face already streamed in, and starts
+// streaming the rest. Must be called before the renderer backend uploads the font texture (i.e. before the first
+// ImGui_ImplOpenGL3_NewFrame()).
+bool fonts_load(ImGuiIO& io, Font_Mode mode, float display_size);
+
+// Loads one bucket of a blob written by tools/atlas_baker (layout in font_atlas_format.hpp) into io.Fonts: the SDF bucket,
+// or the raster one baked closest to display_size. No FreeType and no rasterizing, the pixels and glyph tables go in as is.
+// fonts_load() tries this first in a RESUME_BAKED_FONTS build (see Makefile, BAKED_FONTS). That build ships no TTFs and no
+// FreeType, so when the blob can't be loaded fonts_load() ends up on ImGui's built-in default font, not the real faces.
+bool fonts_load_baked(ImGuiIO& io, const char* path, Font_Mode mode, float display_size);
+
+// Reads faces from an asset pack (tools/asset_packer, entries named like fonts/JetBrainsMono-Regular.ttf) from now on instead
+// of one file / fetch per face. Call before fonts_load(). Faces missing from the pack still come from the file system.
+bool fonts_open_pack(const char* path);
+
+// Call once per frame, before NewFrame(). Advances the staging atlas by a few milliseconds of work and swaps it into
+// io.Fonts when done. Returns true on a swap: the old atlas is gone and the backend texture needs a re-upload.
+bool fonts_update(ImGuiIO& io);
+
+// True while fonts_update() has something to do (keep frames coming). Downloads in flight don't count, their arrival does.
+bool fonts_has_pending_work();
+
+// Blocks until every face that can be loaded is in io.Fonts (native only, the web can't wait on a fetch).
+// For the headless benchmarks, which must measure the final atlas and not whatever had streamed in so far.
+void fonts_finish_streaming(ImGuiIO& io);
+
+// Changes the on-screen font size, cheap enough to call on every resize event. Returns true when io.Fonts was replaced
+// and the backend texture needs a re-upload (never in SDF mode, the one atlas just scales).
+// Raster atlases are kept per quantized size (a baked bucket, or a whole pixel size built from the TTFs): a cached one is
+// swapped in right away, otherwise the current atlas is scaled until fonts_update() has built the new one in the
+// background, once the size stopped changing.
+bool fonts_set_display_size(ImGuiIO& io, float display_size);
+
+// Frees the cached and half-built atlases, clears io.Fonts and frees the font pack, before ImGui::DestroyContext() (which
+// deletes the cleared io.Fonts). After the renderer's shutdown, the font texture goes with the atlas.
+void fonts_shutdown();
+
+// Converts the Alpha8 coverage atlas into a distance field in place and grows every glyph quad by SDF_SPREAD.
+// Exposed separately so offline tools can bake exactly what the runtime would.
+void fonts_convert_atlas_to_sdf(ImFontAtlas* atlas);
+
+// Edge smoothing for the SDF shader at the current scale (half-width of the coverage ramp, in distance-field units).
+float fonts_sdf_smoothing(float scale);
+
+// Atlas stats for the "Performance" menu
+void fonts_show_menu();
@@ -0,0 +1,177 @@
+// NOTE(WALKER): Render-on-demand for the main loop.
+//               The resume is static text 99% of the time, so there is no reason to run NewFrame/Render/SwapBuffers at vsync rate
+//               while the page just sits there. Input/resize/focus callbacks wake the pacer, and after every wake we keep rendering
+//               for a short "linger" window so ImGui can settle (hover highlights, tooltip delays, menu open delays, nav fades, etc.)
+//               Anything that animates on its own (text input caret, held mouse buttons, async work) calls frame_pacer_request_frames().
+
+#pragma once
+
+#include "imgui.h"
+#include <stdio.h>
+#include <GLFW/glfw3.h>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#include <emscripten/html5.h>
+#endif
+
+struct Frame_Pacer {
+    bool   enabled          = true;  // false -> render every frame like the original loop did
+    bool   hidden           = false; // browser tab hidden (or window iconified on native)
+    int    pending_frames   = 3;     // minimum number of frames still owed (first frames always render)
+    double linger_seconds   = 1.0;   // keep rendering this long after the last event (covers ImGui's hover/tooltip delays)
+    double last_wake_time   = 0.0;
+    double report_interval  = 10.0;  // seconds between console reports, 0 to disable
+    double last_report_time = 0.0;
+
+    unsigned long long frames_rendered = 0;
+    unsigned long long frames_skipped  = 0;
+    unsigned long long last_report_rendered = 0;
+    unsigned long long last_report_skipped  = 0;
+
+    // Previously installed GLFW callbacks (we chain to them, same as imgui_impl_glfw does):
+    GLFWwindowsizefun      prev_window_size      = nullptr;
+    GLFWframebuffersizefun prev_framebuffer_size = nullptr;
+    GLFWwindowiconifyfun   prev_iconify          = nullptr;
+    GLFWwindowrefreshfun   prev_refresh          = nullptr;
+};
+
+static Frame_Pacer frame_pacer;
+
+static inline void frame_pacer_wake() {
+    frame_pacer.last_wake_time = glfwGetTime();
+    if (frame_pacer.pending_frames < 2) frame_pacer.pending_frames = 2;
+}
+
+// NOTE(WALKER): For things that animate without user input (async loads finishing, etc.)
+static inline void frame_pacer_request_frames(int count = 1) {
+    if (frame_pacer.pending_frames < count) frame_pacer.pending_frames = count;
+}
+
+static inline void frame_pacer_set_hidden(bool hidden) {
+    if (frame_pacer.hidden == hidden) return;
+    frame_pacer.hidden = hidden;
+#ifdef __EMSCRIPTEN__
+    // Throttle hard when the tab is hidden: one tick a second is plenty to keep the counters/report alive.
+    if (hidden) emscripten_set_main_loop_timing(EM_TIMING_SETTIMEOUT, 1000);
+    else        emscripten_set_main_loop_timing(EM_TIMING_RAF, 1);
+#endif
+    if (!hidden) frame_pacer_wake();
+}
+
+// ImGui's GLFW backend chains to whatever callbacks were installed before ImGui_ImplGlfw_InitForOpenGL(),
+// so the input callbacks only need to wake us up, ImGui still gets every event:
+static void frame_pacer_cursor_pos_callback(GLFWwindow*, double, double)       { frame_pacer_wake(); }
+static void frame_pacer_mouse_button_callback(GLFWwindow*, int, int, int)      { frame_pacer_wake(); }
+static void frame_pacer_scroll_callback(GLFWwindow*, double, double)           { frame_pacer_wake(); }
+static void frame_pacer_key_callback(GLFWwindow*, int, int, int, int)          { frame_pacer_wake(); }
+static void frame_pacer_char_callback(GLFWwindow*, unsigned int)               { frame_pacer_wake(); }
+static void frame_pacer_cursor_enter_callback(GLFWwindow*, int)                { frame_pacer_wake(); }
+static void frame_pacer_focus_callback(GLFWwindow*, int)                       { frame_pacer_wake(); }
+
+// These ones ImGui does not install, so we chain ourselves:
+static void frame_pacer_window_size_callback(GLFWwindow* window, int w, int h) {
+    frame_pacer_wake();
+    if (frame_pacer.prev_window_size) frame_pacer.prev_window_size(window, w, h);
+}
+static void frame_pacer_framebuffer_size_callback(GLFWwindow* window, int w, int h) {
+    frame_pacer_wake();
+    if (frame_pacer.prev_framebuffer_size) frame_pacer.prev_framebuffer_size(window, w, h);
+}
+static void frame_pacer_iconify_callback(GLFWwindow* window, int iconified) {
+    frame_pacer_set_hidden(iconified != 0);
+    if (frame_pacer.prev_iconify) frame_pacer.prev_iconify(window, iconified);
+}
+static void frame_pacer_refresh_callback(GLFWwindow* window) {
+    frame_pacer_wake();
+    if (frame_pacer.prev_refresh) frame_pacer.prev_refresh(window);
+}
+
+#ifdef __EMSCRIPTEN__
+static EM_BOOL frame_pacer_visibility_callback(int, const EmscriptenVisibilityChangeEvent* e, void*) {
+    frame_pacer_set_hidden(e->hidden != 0);
+    return EM_FALSE;
+}
+#endif
+
+// NOTE(WALKER): Must be called BEFORE ImGui_ImplGlfw_InitForOpenGL() so the ImGui backend chains to our input callbacks
+static void frame_pacer_install(GLFWwindow* window) {
+    glfwSetCursorPosCallback(window, frame_pacer_cursor_pos_callback);
+    glfwSetMouseButtonCallback(window, frame_pacer_mouse_button_callback);
+    glfwSetScrollCallback(window, frame_pacer_scroll_callback);
+    glfwSetKeyCallback(window, frame_pacer_key_callback);
+    glfwSetCharCallback(window, frame_pacer_char_callback);
+    glfwSetCursorEnterCallback(window, frame_pacer_cursor_enter_callback);
+    glfwSetWindowFocusCallback(window, frame_pacer_focus_callback);
+    frame_pacer.prev_window_size      = glfwSetWindowSizeCallback(window, frame_pacer_window_size_callback);
+    frame_pacer.prev_framebuffer_size = glfwSetFramebufferSizeCallback(window, frame_pacer_framebuffer_size_callback);
+    frame_pacer.prev_iconify          = glfwSetWindowIconifyCallback(window, frame_pacer_iconify_callback);
+    frame_pacer.prev_refresh          = glfwSetWindowRefreshCallback(window, frame_pacer_refresh_callback);
+#ifdef __EMSCRIPTEN__
+    emscripten_set_visibilitychange_callback(nullptr, EM_FALSE, frame_pacer_visibility_callback);
+#endif
+    frame_pacer.last_wake_time   = glfwGetTime();
+    frame_pacer.last_report_time = frame_pacer.last_wake_time;
+}
+
+static void frame_pacer_report(double now) {
+    if (frame_pacer.report_interval <= 0.0 || now - frame_pacer.last_report_time < frame_pacer.report_interval) return;
+    const auto rendered = frame_pacer.frames_rendered - frame_pacer.last_report_rendered;
+    const auto skipped  = frame_pacer.frames_skipped  - frame_pacer.last_report_skipped;
+    if (rendered + skipped > 0) {
+        printf("[frame_pacer] last %.0fs: rendered %llu, skipped %llu (%.1f%% idle) | total rendered %llu, skipped %llu\n",
+               now - frame_pacer.last_report_time, rendered, skipped, 100.0 * (double)skipped / (double)(rendered + skipped),
+               frame_pacer.frames_rendered, frame_pacer.frames_skipped);
+    }
+    frame_pacer.last_report_time     = now;
+    frame_pacer.last_report_rendered = frame_pacer.frames_rendered;
+    frame_pacer.last_report_skipped  = frame_pacer.frames_skipped;
+}
+
+// NOTE(WALKER): Called once per main loop iteration after polling events.
+//               Returns true when this iteration should build and present a frame.
+static bool frame_pacer_should_render() {
+    const double now = glfwGetTime();
+    frame_pacer_report(now);
+
+    bool render = !frame_pacer.enabled || frame_pacer.pending_frames > 0;
+    if (!render && !frame_pacer.hidden) {
+        // "Pending ImGui work" from the last frame we built:
+        const ImGuiIO& io = ImGui::GetIO();
+        render = (now - frame_pacer.last_wake_time) < frame_pacer.linger_seconds // settle after input
+              || io.WantTextInput                                                // caret blink
+              || ImGui::IsAnyItemActive()                                         // dragging a slider/scrollbar
+              || ImGui::IsMouseDown(ImGuiMouseButton_Left) || ImGui::IsMouseDown(ImGuiMouseButton_Right);
+    }
+
+    if (render) {
+        if (frame_pacer.pending_frames > 0) --frame_pacer.pending_frames;
+        ++frame_pacer.frames_rendered;
+    } else {
+        ++frame_pacer.frames_skipped;
+    }
+    return render;
+}
+
+// NOTE(WALKER): On native there is no browser driving the loop, so block on events instead of spinning when idle
+static void frame_pacer_wait_events() {
+#ifndef __EMSCRIPTEN__
+    if (frame_pacer.enabled && frame_pacer.pending_frames == 0 && glfwGetTime() - frame_pacer.last_wake_time >= frame_pacer.linger_seconds)
+        glfwWaitEventsTimeout(frame_pacer.hidden ? 1.0 : frame_pacer.report_interval);
+    else
+        glfwPollEvents();
+#else
+    glfwPollEvents();
+#endif
+}
+
+// NOTE(WALKER): Shown in the menu bar "Performance" menu
+static void frame_pacer_show_menu() {
+    if (ImGui::Checkbox("Render on demand", &frame_pacer.enabled))
+        frame_pacer_wake();
+    ImGui::SetItemTooltip("Skip frames when there is no input, resize, or pending UI work");
+    ImGui::Text("Frames rendered: %llu", frame_pacer.frames_rendered);
+    ImGui::Text("Frames skipped:  %llu", frame_pacer.frames_skipped);
+    const auto total = frame_pacer.frames_rendered + frame_pacer.frames_skipped;
+    ImGui::Text("Idle ratio:      %.1f%%", total ? 100.0 * (double)frame_pacer.frames_skipped / (double)total : 0.0);
+}
@@ -0,0 +1,196 @@
+#include "glyph_batch.hpp"
+#include "profiler.hpp"
+
+#include "imgui.h"
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+// Occupancy grid
+//-----------------------------------------------------------------------------
+
+static void grid_reset(Glyph_Batch& b, ImVec2 display_size) {
+    const int columns = (int)(display_size.x / GLYPH_BATCH_CELL) + 1;
+    b.grid_words = (columns + 63) / 64;
+    b.grid_rows  = (int)(display_size.y / GLYPH_BATCH_CELL) + 1;
+    b.grid.resize(b.grid_words * b.grid_rows);
+    memset(b.grid.Data, 0, (size_t)b.grid.Size * sizeof(uint64_t));
+    b.grid_min_row = b.grid_rows;
+    b.grid_max_row = -1;
+}
+
+static void grid_clear(Glyph_Batch& b) {
+    if (b.grid_max_row < b.grid_min_row) return;
+    memset(b.grid.Data + b.grid_min_row * b.grid_words, 0, (size_t)(b.grid_max_row - b.grid_min_row + 1) * b.grid_words * sizeof(uint64_t));
+    b.grid_min_row = b.grid_rows;
+    b.grid_max_row = -1;
+}
+
+// Cell range covered by [x0, x1] x [y0, y1], false when it is off the grid
+static bool grid_cells(const Glyph_Batch& b, float x0, float y0, float x1, float y1, int& c0, int& r0, int& c1, int& r1) {
+    c0 = (int)(x0 / GLYPH_BATCH_CELL); r0 = (int)(y0 / GLYPH_BATCH_CELL);
+    c1 = (int)(x1 / GLYPH_BATCH_CELL); r1 = (int)(y1 / GLYPH_BATCH_CELL);
+    if (c0 < 0) c0 = 0;
+    if (r0 < 0) r0 = 0;
+    if (c1 >= b.grid_words * 64) c1 = b.grid_words * 64 - 1;
+    if (r1 >= b.grid_rows) r1 = b.grid_rows - 1;
+    return c0 <= c1 && r0 <= r1;
+}
+
+static uint64_t grid_word_mask(int word, int c0, int c1) {
+    const int lo = c0 > word * 64 ? c0 - word * 64 : 0;
+    const int hi = c1 < word * 64 + 63 ? c1 - word * 64 : 63;
+    return (hi == 63 ? ~0ull : ((1ull << (hi + 1)) - 1)) & ~((1ull << lo) - 1);
+}
+
+static void grid_mark(Glyph_Batch& b, float x0, float y0, float x1, float y1) {
+    int c0, r0, c1, r1;
+    if (!grid_cells(b, x0, y0, x1, y1, c0, r0, c1, r1)) return;
+    for (int r = r0; r <= r1; ++r)
+        for (int w = c0 / 64; w <= c1 / 64; ++w)
+            b.grid[r * b.grid_words + w] |= grid_word_mask(w, c0, c1);
+    if (r0 < b.grid_min_row) b.grid_min_row = r0;
+    if (r1 > b.grid_max_row) b.grid_max_row = r1;
+}
+
+static bool grid_test(const Glyph_Batch& b, float x0, float y0, float x1, float y1) {
+    int c0, r0, c1, r1;
+    if (b.grid_max_row < b.grid_min_row || !grid_cells(b, x0, y0, x1, y1, c0, r0, c1, r1)) return false;
+    if (r0 < b.grid_min_row) r0 = b.grid_min_row;
+    if (r1 > b.grid_max_row) r1 = b.grid_max_row;
+    for (int r = r0; r <= r1; ++r)
+        for (int w = c0 / 64; w <= c1 / 64; ++w)
+            if (b.grid[r * b.grid_words + w] & grid_word_mask(w, c0, c1)) return true;
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+// Batching
+//-----------------------------------------------------------------------------
+
+// NOTE(WALKER): Exactly what ImDrawList::PrimRectUV() writes (every glyph goes through it or the same pattern in
+//               ImFont::RenderText()): corners a b c d clockwise from the top left, indices a b c a c d, one color.
+static bool is_quad(const ImDrawIdx* idx, const ImDrawVert* vtx, Glyph_Instance& out) {
+    const unsigned int a = idx[0];
+    if (idx[1] != a + 1 || idx[2] != a + 2 || idx[3] != a || idx[4] != a + 2 || idx[5] != a + 3) return false;
+    const ImDrawVert& v0 = vtx[a];
+    const ImDrawVert& v1 = vtx[a + 1];
+    const ImDrawVert& v2 = vtx[a + 2];
+    const ImDrawVert& v3 = vtx[a + 3];
+    if (v0.col != v1.col || v0.col != v2.col || v0.col != v3.col) return false;
+    if (v0.pos.y != v1.pos.y || v1.pos.x != v2.pos.x || v2.pos.y != v3.pos.y || v3.pos.x != v0.pos.x) return false;
+    if (v0.uv.y  != v1.uv.y  || v1.uv.x  != v2.uv.x  || v2.uv.y  != v3.uv.y  || v3.uv.x  != v0.uv.x)  return false;
+    out = { v0.pos.x, v0.pos.y, v2.pos.x, v2.pos.y, v0.uv.x, v0.uv.y, v2.uv.x, v2.uv.y, v0.col };
+    return true;
+}
+
+static float min3(float a, float b, float c) { return a < b ? (a < c ? a : c) : (b < c ? b : c); }
+static float max3(float a, float b, float c) { return a > b ? (a > c ? a : c) : (b > c ? b : c); }
+static bool same_clip(const ImVec4& a, const ImVec4& b) { return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w; }
+
+struct Batch_Builder {
+    Glyph_Batch&       b;
+    Glyph_Batch_Stats& stats;
+    ImVec2             origin;
+    Glyph_Draw         current;
+    bool               open = false;
+
+    void flush() {
+        if (open && (current.index_count || current.instance_count)) {
+            b.draws.push_back(current);
+            stats.draws += (current.index_count > 0) + (current.instance_count > 0);
+        }
+        open = false;
+        grid_clear(b);
+    }
+    void begin(ImTextureID texture, const ImVec4& clip_rect) {
+        flush();
+        current = Glyph_Draw();
+        current.texture        = texture;
+        current.clip_rect      = clip_rect;
+        current.first_index    = b.indices.Size;
+        current.first_instance = b.instances.Size;
+        open = true;
+    }
+};
+
+void glyph_batch_build(Glyph_Batch& b, const ImDrawData* dd, Glyph_Batch_Stats& stats) {
+    PROFILE_ZONE("glyph_batch_build");
+    stats = Glyph_Batch_Stats();
+    b.instances.resize(0);
+    b.vertices.resize(0);
+    b.indices.resize(0);
+    b.draws.resize(0);
+    if (!dd || dd->CmdListsCount == 0) return;
+    grid_reset(b, dd->DisplaySize);
+
+    Batch_Builder builder = { b, stats, dd->DisplayPos };
+    for (int n = 0; n < dd->CmdListsCount; ++n) {
+        const ImDrawList* list = dd->CmdLists[n];
+        b.remap.resize(list->VtxBuffer.Size);
+        memset(b.remap.Data, 0xFF, (size_t)b.remap.Size * sizeof(int));
+        stats.stock_upload_bytes += list->VtxBuffer.Size * (int)sizeof(ImDrawVert) + list->IdxBuffer.Size * (int)sizeof(ImDrawIdx);
+
+        for (const ImDrawCmd& cmd : list->CmdBuffer) {
+            if (cmd.UserCallback) {
+                builder.flush();
+                Glyph_Draw call;
+                call.callback      = cmd.UserCallback;
+                call.callback_list = list;
+                call.callback_cmd  = &cmd;
+                b.draws.push_back(call);
+                continue;
+            }
+            if (cmd.ElemCount == 0) continue;
+            ++stats.stock_draws;
+            if (!builder.open || builder.current.texture != cmd.GetTexID() || !same_clip(builder.current.clip_rect, cmd.ClipRect))
+                builder.begin(cmd.GetTexID(), cmd.ClipRect);
+
+            const ImDrawIdx*  idx = list->IdxBuffer.Data + cmd.IdxOffset;
+            const ImDrawVert* vtx = list->VtxBuffer.Data + cmd.VtxOffset;
+            for (unsigned int k = 0; k + 3 <= cmd.ElemCount;) {
+                Glyph_Instance quad;
+                if (k + 6 <= cmd.ElemCount && is_quad(idx + k, vtx, quad)) {
+                    b.instances.push_back(quad);
+                    ++builder.current.instance_count;
+                    grid_mark(b, quad.x0 - builder.origin.x, quad.y0 - builder.origin.y, quad.x1 - builder.origin.x, quad.y1 - builder.origin.y);
+                    k += 6;
+                    continue;
+                }
+
+                const ImDrawVert& t0 = vtx[idx[k]];
+                const ImDrawVert& t1 = vtx[idx[k + 1]];
+                const ImDrawVert& t2 = vtx[idx[k + 2]];
+                const float x0 = min3(t0.pos.x, t1.pos.x, t2.pos.x) - builder.origin.x;
+                const float y0 = min3(t0.pos.y, t1.pos.y, t2.pos.y) - builder.origin.y;
+                const float x1 = max3(t0.pos.x, t1.pos.x, t2.pos.x) - builder.origin.x;
+                const float y1 = max3(t0.pos.y, t1.pos.y, t2.pos.y) - builder.origin.y;
+                if (builder.current.instance_count && grid_test(b, x0, y0, x1, y1)) { // would be drawn under a quad it covers
+                    builder.begin(cmd.GetTexID(), cmd.ClipRect);
+                    ++stats.overlap_splits;
+                }
+                for (int j = 0; j < 3; ++j) {
+                    const unsigned int source = cmd.VtxOffset + idx[k + j];
+                    int& mapped = b.remap[(int)source];
+                    if (mapped < 0) {
+                        mapped = b.vertices.Size;
+                        b.vertices.push_back(list->VtxBuffer.Data[source]);
+                    }
+                    b.indices.push_back((unsigned int)mapped);
+                }
+                builder.current.index_count += 3;
+                k += 3;
+            }
+        }
+    }
+    builder.flush();
+
+    stats.instances    = b.instances.Size;
+    stats.vertices     = b.vertices.Size;
+    stats.indices      = b.indices.Size;
+    stats.upload_bytes = b.instances.Size * (int)sizeof(Glyph_Instance) + b.vertices.Size * (int)sizeof(ImDrawVert)
+                       + b.indices.Size * (int)sizeof(unsigned int);
+}
+
+void glyph_batch_free(Glyph_Batch& b) {
+    b = Glyph_Batch();
+}
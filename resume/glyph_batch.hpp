@@ -0,0 +1,65 @@
+// NOTE(WALKER): CPU half of the instanced renderer (glyph_renderer.hpp), no GL in here so the headless build can report what
+//               it would upload next to what the stock backend uploads.
+//               The stock backend re-uploads every vertex and index ImGui produced, and text is almost all of it: one glyph
+//               is 4 ImDrawVert + 6 ImDrawIdx = 92 bytes. Every axis aligned, single color, textured quad (glyphs, and the
+//               unrounded rects drawn with the white pixel) becomes one 36 byte Glyph_Instance instead, expanded to a quad by
+//               the vertex shader. Everything else (rounded frames, circles, anti-aliased lines) stays triangles, compacted to
+//               the vertices those triangles actually use.
+//
+//               A draw is [triangles, then instances] for one texture + clip rect. Consecutive commands with the same
+//               texture and clip rect are merged into one draw, even across draw lists. Drawing the triangles first is only
+//               wrong where a triangle is painted over an earlier quad of the same draw, so quads mark a coarse occupancy
+//               grid and a triangle landing on a marked cell starts a new draw.
+
+#pragma once
+
+#include "imgui.h"
+#include <stdint.h>
+
+struct Glyph_Instance {
+    float x0, y0, x1, y1; // corners, in draw data coordinates
+    float u0, v0, u1, v1;
+    ImU32 col;
+};
+
+struct Glyph_Draw {
+    ImTextureID       texture        = 0;
+    ImVec4            clip_rect;            // like ImDrawCmd::ClipRect
+    int               first_index    = 0;   // into Glyph_Batch::indices, drawn first
+    int               index_count    = 0;
+    int               first_instance = 0;   // into Glyph_Batch::instances, drawn over the triangles
+    int               instance_count = 0;
+    ImDrawCallback    callback       = nullptr; // a user callback instead of geometry (or ImDrawCallback_ResetRenderState)
+    const ImDrawList* callback_list  = nullptr;
+    const ImDrawCmd*  callback_cmd   = nullptr;
+};
+
+struct Glyph_Batch_Stats {
+    int instances        = 0;
+    int vertices         = 0; // triangle vertices after compaction
+    int indices          = 0;
+    int draws            = 0; // GL draw calls: a Glyph_Draw with both triangles and instances is two
+    int overlap_splits   = 0; // draws started because a triangle landed on an earlier quad
+    int upload_bytes     = 0;
+    int stock_draws      = 0; // what ImGui_ImplOpenGL3_RenderDrawData() would do with the same draw data
+    int stock_upload_bytes = 0;
+};
+
+struct Glyph_Batch {
+    ImVector<Glyph_Instance> instances;
+    ImVector<ImDrawVert>     vertices;
+    ImVector<unsigned int>   indices;   // 32 bit: the whole frame's triangles share one vertex array
+    ImVector<Glyph_Draw>     draws;
+
+    // scratch, kept between frames so a steady frame doesn't allocate
+    ImVector<int>            remap;     // draw list vertex -> index in vertices, -1 if not copied yet
+    ImVector<uint64_t>       grid;      // one bit per GLYPH_BATCH_CELL sized cell
+    int                      grid_words = 0, grid_rows = 0;
+    int                      grid_min_row = 0, grid_max_row = -1;
+};
+
+constexpr float GLYPH_BATCH_CELL = 8.0f;
+
+// Fills the batch from this frame's draw data, stats are this frame's
+void glyph_batch_build(Glyph_Batch& batch, const ImDrawData* draw_data, Glyph_Batch_Stats& stats);
+void glyph_batch_free(Glyph_Batch& batch);
@@ -0,0 +1,137 @@
+#include "glyph_emit.hpp"
+
+#include "imgui.h"
+#include <stddef.h>
+#include <string.h>
+#include <chrono>
+
+Glyph_Emit_Stats glyph_emit_stats;
+
+static_assert(sizeof(Glyph_Quad) == 32, "Glyph_Quad is loaded as two 16 byte vectors");
+static_assert(sizeof(ImDrawVert) == 20 && offsetof(ImDrawVert, pos) == 0 && offsetof(ImDrawVert, uv) == 8 && offsetof(ImDrawVert, col) == 16,
+              "glyph_emit_quads_simd() writes the stock ImDrawVert layout (pos, uv, col)");
+
+void glyph_emit_quads_scalar(const Glyph_Quad* quads, int count, ImVec2 origin, ImU32 col, ImDrawVert* vtx, ImDrawIdx* idx, unsigned int vtx_index) {
+    for (int i = 0; i < count; ++i) {
+        const Glyph_Quad& q = quads[i];
+        const float x0 = origin.x + q.x0, y0 = origin.y + q.y0, x1 = origin.x + q.x1, y1 = origin.y + q.y1;
+        idx[0] = (ImDrawIdx)vtx_index; idx[1] = (ImDrawIdx)(vtx_index + 1); idx[2] = (ImDrawIdx)(vtx_index + 2);
+        idx[3] = (ImDrawIdx)vtx_index; idx[4] = (ImDrawIdx)(vtx_index + 2); idx[5] = (ImDrawIdx)(vtx_index + 3);
+        vtx[0].pos.x = x0; vtx[0].pos.y = y0; vtx[0].col = col; vtx[0].uv.x = q.u0; vtx[0].uv.y = q.v0;
+        vtx[1].pos.x = x1; vtx[1].pos.y = y0; vtx[1].col = col; vtx[1].uv.x = q.u1; vtx[1].uv.y = q.v0;
+        vtx[2].pos.x = x1; vtx[2].pos.y = y1; vtx[2].col = col; vtx[2].uv.x = q.u1; vtx[2].uv.y = q.v1;
+        vtx[3].pos.x = x0; vtx[3].pos.y = y1; vtx[3].col = col; vtx[3].uv.x = q.u0; vtx[3].uv.y = q.v1;
+        vtx += 4; idx += 6; vtx_index += 4;
+    }
+}
+
+#if GLYPH_EMIT_SIMD
+typedef float     f32x4 __attribute__((vector_size(16)));
+typedef uint32_t  u32x4 __attribute__((vector_size(16)));
+typedef ImDrawIdx idx_vec __attribute__((vector_size(16)));
+constexpr int IDX_LANES = 16 / (int)sizeof(ImDrawIdx);
+
+// NOTE(WALKER): Unaligned on purpose, ImDrawVert/ImDrawIdx buffers are only 4 (2) byte aligned. memcpy is one movups/vld1/v128.load.
+template <typename T> static inline T load16(const void* p) { T v; memcpy(&v, p, 16); return v; }
+template <typename T> static inline void store16(void* p, T v) { memcpy(p, &v, 16); }
+
+// Four quads' indices relative to their first vertex: 24 indices, which is a whole number of vectors for 16 and 32 bit ImDrawIdx
+static const ImDrawIdx QUAD4_INDICES[24] = { 0, 1, 2, 0, 2, 3,  4, 5, 6, 4, 6, 7,  8, 9, 10, 8, 10, 11,  12, 13, 14, 12, 14, 15 };
+
+void glyph_emit_quads_simd(const Glyph_Quad* quads, int count, ImVec2 origin, ImU32 col, ImDrawVert* vtx, ImDrawIdx* idx, unsigned int vtx_index) {
+    // Indices: the pattern + base vertex, four quads per step
+    idx_vec pattern[24 / IDX_LANES];
+    for (int v = 0; v < 24 / IDX_LANES; ++v) pattern[v] = load16<idx_vec>(QUAD4_INDICES + v * IDX_LANES);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const ImDrawIdx base = (ImDrawIdx)(vtx_index + 4 * i);
+        for (int v = 0; v < 24 / IDX_LANES; ++v)
+            store16(idx + 6 * i + v * IDX_LANES, pattern[v] + base); // the scalar is splat across the lanes
+    }
+    for (; i < count; ++i) {
+        const unsigned int a = vtx_index + 4 * i;
+        ImDrawIdx* out = idx + 6 * i;
+        out[0] = (ImDrawIdx)a; out[1] = (ImDrawIdx)(a + 1); out[2] = (ImDrawIdx)(a + 2);
+        out[3] = (ImDrawIdx)a; out[4] = (ImDrawIdx)(a + 2); out[5] = (ImDrawIdx)(a + 3);
+    }
+
+    // Vertices: 4 * 20 bytes = five vectors per quad, lanes below as (pos, uv, col) per vertex
+    const f32x4 offset = { origin.x, origin.y, origin.x, origin.y };
+    const u32x4 c = { col, col, col, col };
+    for (i = 0; i < count; ++i) {
+        const u32x4 p = (u32x4)(load16<f32x4>(&quads[i].x0) + offset); // x0 y0 x1 y1
+        const u32x4 u = load16<u32x4>(&quads[i].u0);                    // u0 v0 u1 v1
+        const u32x4 p_hi = __builtin_shufflevector(p, u, 2, 1, 6, 7);   // x1 y0 u1 v1
+        const u32x4 v_c  = __builtin_shufflevector(u, c, 1, 4, 1, 4);   // v0 col
+        const u32x4 uv_c = __builtin_shufflevector(u, c, 2, 3, 4, 4);   // u1 v1 col
+        const u32x4 y_uv = __builtin_shufflevector(p, u, 3, 4, 7, 7);   // y1 u0 v1
+        float* out = &vtx[4 * i].pos.x;
+        store16(out +  0, __builtin_shufflevector(p, u, 0, 1, 4, 5));           // x0 y0 u0 v0
+        store16(out +  4, __builtin_shufflevector(c, p_hi, 0, 4, 5, 6));        // col | x1 y0 u1
+        store16(out +  8, __builtin_shufflevector(v_c, p, 0, 1, 6, 7));         // v0 col | x1 y1
+        store16(out + 12, __builtin_shufflevector(uv_c, p, 0, 1, 2, 4));        // u1 v1 col | x0
+        store16(out + 16, __builtin_shufflevector(y_uv, c, 0, 1, 2, 4));        // y1 u0 v1 col
+    }
+}
+
+const char* glyph_emit_simd_name() {
+#if defined(__wasm_simd128__)
+    return "wasm simd128";
+#elif defined(__SSE2__)
+    return "SSE2";
+#else
+    return "NEON";
+#endif
+}
+#else
+void glyph_emit_quads_simd(const Glyph_Quad* quads, int count, ImVec2 origin, ImU32 col, ImDrawVert* vtx, ImDrawIdx* idx, unsigned int vtx_index) {
+    glyph_emit_quads_scalar(quads, count, origin, col, vtx, idx, vtx_index);
+}
+
+const char* glyph_emit_simd_name() { return "none in this build"; }
+#endif
+
+void glyph_emit_quads(const Glyph_Quad* quads, int count, ImVec2 origin, ImU32 col, ImDrawVert* vtx, ImDrawIdx* idx, unsigned int vtx_index) {
+    glyph_emit_stats.quads += (unsigned long long)count;
+    if (GLYPH_EMIT_SIMD && glyph_emit_stats.simd)
+        glyph_emit_quads_simd(quads, count, origin, col, vtx, idx, vtx_index);
+    else
+        glyph_emit_quads_scalar(quads, count, origin, col, vtx, idx, vtx_index);
+}
+
+static double emit_now_ms() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Glyph_Emit_Bench glyph_emit_bench(const Glyph_Quad* quads, int count, int passes) {
+    Glyph_Emit_Bench result;
+    result.quads  = count;
+    result.passes = passes;
+    if (count <= 0 || passes <= 0) return result;
+
+    ImVector<ImDrawVert> vtx[2];
+    ImVector<ImDrawIdx>  idx[2];
+    for (int k = 0; k < 2; ++k) {
+        vtx[k].resize(count * 4);
+        idx[k].resize(count * 6);
+        memset((void*)vtx[k].Data, 0, (size_t)vtx[k].size_in_bytes());
+        memset(idx[k].Data, 0, (size_t)idx[k].size_in_bytes());
+    }
+    const ImVec2 origin(17.0f, 230.0f);
+    const ImU32  col = IM_COL32(230, 230, 230, 255);
+    double best[2] = { 1e30, 1e30 };
+    for (int pass = 0; pass < passes; ++pass) {
+        for (int k = 0; k < 2; ++k) { // alternating, so neither always runs on a cold cache
+            const double start = emit_now_ms();
+            if (k == 0) glyph_emit_quads_scalar(quads, count, origin, col, vtx[k].Data, idx[k].Data, 0);
+            else        glyph_emit_quads_simd(quads, count, origin, col, vtx[k].Data, idx[k].Data, 0);
+            const double ms = emit_now_ms() - start;
+            if (ms < best[k]) best[k] = ms;
+        }
+    }
+    result.scalar_ns = best[0] * 1e6 / count;
+    result.simd_ns   = best[1] * 1e6 / count;
+    result.identical = memcmp(vtx[0].Data, vtx[1].Data, (size_t)vtx[0].size_in_bytes()) == 0
+                    && memcmp(idx[0].Data, idx[1].Data, (size_t)idx[0].size_in_bytes()) == 0;
+    return result;
+}
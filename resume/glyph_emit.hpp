@@ -0,0 +1,55 @@
+// NOTE(WALKER): Glyph quads -> ImDrawList vertices and indices, for the text we lay out ourselves (text_layout_cache.hpp).
+//               Every visible glyph of a wrapped paragraph is 4 ImDrawVert + 6 ImDrawIdx written per frame, which is most of
+//               what a frame of this UI writes. The scalar loop does that one float at a time: 20 stores for the vertices.
+//               The SIMD one does a quad as two 16 byte loads, a few shuffles and five 16 byte stores, with the indices of
+//               four quads at a time as a fixed pattern plus the base vertex.
+//
+//               Written with GCC/Clang vector extensions instead of intrinsics, so the one implementation is SSE2 on x86-64,
+//               NEON on arm64 and simd128 in a `make SIMD=1` wasm build. Without 128 bit vectors (the default wasm build, MSVC,
+//               old GCC) GLYPH_EMIT_SIMD is 0 and the SIMD entry point is the scalar loop. Both write the exact same bytes,
+//               the "Performance" menu switches between them and runs glyph_emit_bench() on the resume's own text.
+
+#pragma once
+
+#include "imgui.h"
+
+#if (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 12)) && (defined(__SSE2__) || defined(__ARM_NEON) || defined(__wasm_simd128__))
+#define GLYPH_EMIT_SIMD 1
+#else
+#define GLYPH_EMIT_SIMD 0
+#endif
+
+// Glyph quad relative to the text origin
+struct Glyph_Quad {
+    float x0, y0, x1, y1;
+    float u0, v0, u1, v1;
+};
+
+struct Glyph_Emit_Stats {
+    bool               simd  = GLYPH_EMIT_SIMD != 0; // menu checkbox, ignored when the build has no SIMD path
+    unsigned long long quads = 0;
+};
+
+extern Glyph_Emit_Stats glyph_emit_stats;
+
+// Writes count quads at origin: 4 * count vertices to vtx, 6 * count indices to idx starting at vertex vtx_index.
+// Same corner and index order as ImDrawList::PrimRectUV().
+void glyph_emit_quads_scalar(const Glyph_Quad* quads, int count, ImVec2 origin, ImU32 col, ImDrawVert* vtx, ImDrawIdx* idx, unsigned int vtx_index);
+void glyph_emit_quads_simd(const Glyph_Quad* quads, int count, ImVec2 origin, ImU32 col, ImDrawVert* vtx, ImDrawIdx* idx, unsigned int vtx_index);
+
+// Whichever the menu picked
+void glyph_emit_quads(const Glyph_Quad* quads, int count, ImVec2 origin, ImU32 col, ImDrawVert* vtx, ImDrawIdx* idx, unsigned int vtx_index);
+
+// Name of the vector instructions glyph_emit_quads_simd() compiles to
+const char* glyph_emit_simd_name();
+
+struct Glyph_Emit_Bench {
+    int    quads     = 0;   // per pass
+    int    passes    = 0;
+    double scalar_ns = 0.0; // per quad, best pass
+    double simd_ns   = 0.0;
+    bool   identical = false; // both wrote the same bytes
+};
+
+// Times both paths writing the same quads into one scratch buffer, best of `passes`
+Glyph_Emit_Bench glyph_emit_bench(const Glyph_Quad* quads, int count, int passes);
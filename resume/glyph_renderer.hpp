@@ -0,0 +1,472 @@
+// NOTE(WALKER): Instanced replacement for ImGui_ImplOpenGL3_RenderDrawData(), WebGL2 / GL ES 3.0 / GL 3.3.
+//               glyph_batch.cpp turns the frame into glyph instances + leftover triangles + merged draws, this uploads them and
+//               draws each glyph as an instance of a 4 vertex strip (the vertex shader picks the corner from gl_VertexID).
+//
+//               Uploads go through one ring per buffer kind: a buffer allocated once with glBufferData() and filled front to
+//               back with glBufferSubData(), never rewriting a range an earlier frame may still be reading. When a frame doesn't
+//               fit in what is left, the buffer is orphaned (glBufferData(nullptr)) so the driver hands us fresh storage instead
+//               of stalling on the GPU, and the ring starts over. WebGL2 has no persistent mapping, this is the closest to it.
+//
+//               The stock backend still owns the font texture (ImGui_ImplOpenGL3_NewFrame() and friends), we only replace
+//               drawing. In SDF mode the fragment shader does what sdf_text_shader.hpp does, so there is no callback to patch in.
+//               Needs instancing, so the WebGL1 / ES2 build (IMGUI_IMPL_OPENGL_ES2) only gets the stubs at the bottom.
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_impl_opengl3.h"
+#include "glyph_batch.hpp"
+#include "fonts.hpp"
+#include "profiler.hpp"
+#include <stdio.h>
+#include <string.h>
+
+struct Glyph_Renderer_Stats {
+    Glyph_Batch_Stats  frame;               // last frame, both what we uploaded and what the stock backend would have
+    unsigned long long frames        = 0;
+    unsigned long long orphans       = 0;   // ring buffers that wrapped and had their storage replaced
+    unsigned long long upload_bytes  = 0;   // totals, to compare against stock_upload_bytes over a whole session
+    unsigned long long stock_upload_bytes = 0;
+    unsigned long long draws         = 0;
+    unsigned long long stock_draws   = 0;
+};
+
+// NOTE(WALKER): What the menus read. glyph_renderer itself belongs to whichever thread renders, so after each frame that
+//               thread fills a report (glyph_renderer_fill_report()) and the main thread copies it here (resume.cpp, Render_Report)
+struct Glyph_Renderer_Report {
+    Glyph_Renderer_Stats stats;
+    size_t instance_ring = 0; // bytes
+    size_t vertex_ring   = 0;
+    size_t index_ring    = 0;
+};
+
+static Glyph_Renderer_Report glyph_renderer_report;
+
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+
+#if defined(IMGUI_IMPL_OPENGL_ES3)
+#include <GLES3/gl3.h>
+#else
+#ifndef GL_GLEXT_PROTOTYPES
+#define GL_GLEXT_PROTOTYPES
+#endif
+#include <GL/gl.h>
+#include <GL/glext.h>
+#endif
+
+constexpr GLsizeiptr GLYPH_RING_MIN_BYTES = 1 << 20;
+
+struct Glyph_Ring {
+    GLuint     buffer   = 0;
+    GLenum     target   = GL_ARRAY_BUFFER;
+    GLsizeiptr capacity = 0;
+    GLsizeiptr head     = 0;
+};
+
+struct Glyph_Renderer {
+    bool        available = false; // init succeeded (GL 3.3 / ES 3.0 and the shaders compiled)
+    bool        enabled   = true;  // "Performance" menu toggle, the stock backend draws when off
+    GLuint      instance_program = 0;
+    GLint       instance_proj = -1, instance_texture = -1, instance_smoothing = -1, instance_alpha8 = -1;
+    GLint       loc_rect = -1, loc_uv_rect = -1, loc_instance_color = -1;
+    GLuint      triangle_program = 0;
+    GLint       triangle_proj = -1, triangle_texture = -1, triangle_smoothing = -1, triangle_alpha8 = -1;
+    GLint       loc_position = -1, loc_uv = -1, loc_color = -1;
+    GLuint      instance_vao = 0, triangle_vao = 0;
+    GLuint      alpha8_texture = 0; // the font texture while it is GL_R8 (glyph_renderer_atlas_to_alpha8())
+    Glyph_Ring  instance_ring, vertex_ring, index_ring;
+    Glyph_Batch batch;
+    Glyph_Renderer_Stats stats;
+};
+
+static Glyph_Renderer glyph_renderer;
+
+static GLuint glyph_renderer_compile(GLenum type, const char* version, const char* body) {
+    const char* precision = "#ifdef GL_ES\nprecision mediump float;\n#endif\n";
+    const char* sources[] = { version, "\n", precision, body };
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 4, sources, nullptr);
+    glCompileShader(shader);
+    GLint ok = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        char log[1024];
+        glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        fprintf(stderr, "[glyph_renderer] compile failed: %s\n", log);
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+static GLuint glyph_renderer_link(const char* version, const char* vertex_body, const char* fragment_body) {
+    GLuint vs = glyph_renderer_compile(GL_VERTEX_SHADER, version, vertex_body);
+    GLuint fs = glyph_renderer_compile(GL_FRAGMENT_SHADER, version, fragment_body);
+    if (!vs || !fs) {
+        if (vs) glDeleteShader(vs);
+        if (fs) glDeleteShader(fs);
+        return 0;
+    }
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    glLinkProgram(program);
+    glDetachShader(program, vs);
+    glDetachShader(program, fs);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+    GLint ok = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        fprintf(stderr, "[glyph_renderer] link failed\n");
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+// Instancing (glVertexAttribDivisor, glDrawArraysInstanced) is core in GL ES 3.0 / WebGL2 and desktop GL 3.3
+static bool glyph_renderer_gl_supported() {
+    GLint major = 0, minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+#if defined(IMGUI_IMPL_OPENGL_ES3)
+    return major >= 3;
+#else
+    return major > 3 || (major == 3 && minor >= 3);
+#endif
+}
+
+// glsl_version is the same string handed to ImGui_ImplOpenGL3_Init(), "#version 300 es", "#version 130" or "#version 150"
+static bool glyph_renderer_init(const char* glsl_version) {
+    static const char* instance_vertex_body =
+        "uniform mat4 ProjMtx;\n"
+        "in vec4 Rect;\n"   // x0 y0 x1 y1
+        "in vec4 UVRect;\n" // u0 v0 u1 v1
+        "in vec4 Color;\n"
+        "out vec2 Frag_UV;\n"
+        "out vec4 Frag_Color;\n"
+        "void main() {\n"
+        "    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));\n" // strip order: 0,0 1,0 0,1 1,1
+        "    Frag_UV = mix(UVRect.xy, UVRect.zw, corner);\n"
+        "    Frag_Color = Color;\n"
+        "    gl_Position = ProjMtx * vec4(mix(Rect.xy, Rect.zw, corner), 0.0, 1.0);\n"
+        "}\n";
+    static const char* triangle_vertex_body =
+        "uniform mat4 ProjMtx;\n"
+        "in vec2 Position;\n"
+        "in vec2 UV;\n"
+        "in vec4 Color;\n"
+        "out vec2 Frag_UV;\n"
+        "out vec4 Frag_Color;\n"
+        "void main() {\n"
+        "    Frag_UV = UV;\n"
+        "    Frag_Color = Color;\n"
+        "    gl_Position = ProjMtx * vec4(Position.xy, 0.0, 1.0);\n"
+        "}\n";
+    static const char* fragment_body = // Smoothing < 0 is the raster atlas, else the SDF coverage of sdf_text_shader.hpp
+        "uniform sampler2D Texture;\n"
+        "uniform float Smoothing;\n"
+        "uniform float Alpha8;\n" // 1: single channel texture, coverage is in red and the color is white
+        "in vec2 Frag_UV;\n"
+        "in vec4 Frag_Color;\n"
+        "out vec4 Out_Color;\n"
+        "void main() {\n"
+        "    vec4 texel = texture(Texture, Frag_UV);\n"
+        "    if (Alpha8 > 0.5) texel = vec4(1.0, 1.0, 1.0, texel.r);\n"
+        "    if (Smoothing < 0.0) {\n"
+        "        Out_Color = Frag_Color * texel;\n"
+        "    } else {\n"
+        "        float coverage = smoothstep(0.5 - Smoothing, 0.5 + Smoothing, texel.a);\n"
+        "        Out_Color = vec4(Frag_Color.rgb, Frag_Color.a * coverage);\n"
+        "    }\n"
+        "}\n";
+
+    auto& r = glyph_renderer;
+    if (!glsl_version || strcmp(glsl_version, "#version 100") == 0 || !glyph_renderer_gl_supported()) {
+        printf("[glyph_renderer] needs GL 3.3 / ES 3.0, using the stock backend\n");
+        return false;
+    }
+    r.instance_program = glyph_renderer_link(glsl_version, instance_vertex_body, fragment_body);
+    r.triangle_program = glyph_renderer_link(glsl_version, triangle_vertex_body, fragment_body);
+    if (!r.instance_program || !r.triangle_program) {
+        if (r.instance_program) glDeleteProgram(r.instance_program);
+        if (r.triangle_program) glDeleteProgram(r.triangle_program);
+        r.instance_program = r.triangle_program = 0;
+        return false;
+    }
+    r.instance_proj      = glGetUniformLocation(r.instance_program, "ProjMtx");
+    r.instance_texture   = glGetUniformLocation(r.instance_program, "Texture");
+    r.instance_smoothing = glGetUniformLocation(r.instance_program, "Smoothing");
+    r.instance_alpha8    = glGetUniformLocation(r.instance_program, "Alpha8");
+    r.loc_rect           = glGetAttribLocation(r.instance_program, "Rect");
+    r.loc_uv_rect        = glGetAttribLocation(r.instance_program, "UVRect");
+    r.loc_instance_color = glGetAttribLocation(r.instance_program, "Color");
+    r.triangle_proj      = glGetUniformLocation(r.triangle_program, "ProjMtx");
+    r.triangle_texture   = glGetUniformLocation(r.triangle_program, "Texture");
+    r.triangle_smoothing = glGetUniformLocation(r.triangle_program, "Smoothing");
+    r.triangle_alpha8    = glGetUniformLocation(r.triangle_program, "Alpha8");
+    r.loc_position       = glGetAttribLocation(r.triangle_program, "Position");
+    r.loc_uv             = glGetAttribLocation(r.triangle_program, "UV");
+    r.loc_color          = glGetAttribLocation(r.triangle_program, "Color");
+
+    r.instance_ring.target = GL_ARRAY_BUFFER;
+    r.vertex_ring.target   = GL_ARRAY_BUFFER;
+    r.index_ring.target    = GL_ELEMENT_ARRAY_BUFFER; // WebGL won't let an element buffer be bound as anything else
+    glGenBuffers(1, &r.instance_ring.buffer);
+    glGenBuffers(1, &r.vertex_ring.buffer);
+    glGenBuffers(1, &r.index_ring.buffer);
+
+    // Attribute pointers are set per draw (instances) or per frame (triangles), the VAOs only hold the enables + divisors
+    glGenVertexArrays(1, &r.instance_vao);
+    glBindVertexArray(r.instance_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, r.instance_ring.buffer);
+    const GLint instance_locs[] = { r.loc_rect, r.loc_uv_rect, r.loc_instance_color };
+    for (GLint loc : instance_locs) {
+        glEnableVertexAttribArray((GLuint)loc);
+        glVertexAttribDivisor((GLuint)loc, 1);
+    }
+    glGenVertexArrays(1, &r.triangle_vao);
+    glBindVertexArray(r.triangle_vao);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, r.index_ring.buffer);
+    glEnableVertexAttribArray((GLuint)r.loc_position);
+    glEnableVertexAttribArray((GLuint)r.loc_uv);
+    glEnableVertexAttribArray((GLuint)r.loc_color);
+    glBindVertexArray(0);
+
+    r.available = true;
+    return true;
+}
+
+static void glyph_renderer_shutdown() {
+    auto& r = glyph_renderer;
+    if (r.instance_program) glDeleteProgram(r.instance_program);
+    if (r.triangle_program) glDeleteProgram(r.triangle_program);
+    if (r.instance_vao)     glDeleteVertexArrays(1, &r.instance_vao);
+    if (r.triangle_vao)     glDeleteVertexArrays(1, &r.triangle_vao);
+    const GLuint buffers[] = { r.instance_ring.buffer, r.vertex_ring.buffer, r.index_ring.buffer };
+    glDeleteBuffers(3, buffers);
+    glyph_batch_free(r.batch);
+    r = Glyph_Renderer();
+}
+
+// Whether this frame should go through glyph_renderer_render() instead of the stock backend
+static bool glyph_renderer_active() { return glyph_renderer.available && glyph_renderer.enabled; }
+
+// On the thread that renders, after the frame
+static void glyph_renderer_fill_report(Glyph_Renderer_Report& out) {
+    const auto& r = glyph_renderer;
+    out.stats         = r.stats;
+    out.instance_ring = (size_t)r.instance_ring.capacity;
+    out.vertex_ring   = (size_t)r.vertex_ring.capacity;
+    out.index_ring    = (size_t)r.index_ring.capacity;
+}
+
+// NOTE(WALKER): Re-specifies the font texture ImGui_ImplOpenGL3_CreateFontsTexture() just made as GL_R8, one byte per texel
+//               instead of RGBA32's four (every texel of it is white + coverage anyway). The backend keeps owning the handle,
+//               so it still deletes it and doesn't recreate it, but only our shader can draw with it (the Alpha8 uniform
+//               expands red to white + alpha): the caller goes back to RGBA before the stock backend draws again.
+//               The RGBA32 copy GetTexDataAsRGBA32() left in the atlas is freed, it is rebuilt from Alpha8 if ever needed.
+static bool glyph_renderer_atlas_to_alpha8(ImFontAtlas* atlas) {
+    auto& r = glyph_renderer;
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    atlas->GetTexDataAsAlpha8(&pixels, &width, &height);
+    const GLuint texture = (GLuint)(intptr_t)atlas->TexID;
+    if (!r.available || !texture || !pixels) return false;
+    GLint last_texture = 0;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // rows are width bytes
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, (GLuint)last_texture);
+    r.alpha8_texture = texture;
+    if (atlas->TexPixelsRGBA32) {
+        IM_FREE(atlas->TexPixelsRGBA32);
+        atlas->TexPixelsRGBA32 = nullptr;
+    }
+    return true;
+}
+
+// The font texture was recreated (as RGBA32), whatever handle was GL_R8 is gone
+static void glyph_renderer_atlas_reset() { glyph_renderer.alpha8_texture = 0; }
+
+// Writes bytes at the ring's head and returns their offset in the buffer. The buffer has to be bound to ring.target.
+static GLsizeiptr glyph_ring_write(Glyph_Ring& ring, const void* data, GLsizeiptr bytes) {
+    if (bytes > ring.capacity) { // grow: twice this frame so the ring holds a couple of frames before wrapping
+        ring.capacity = ring.capacity ? ring.capacity : GLYPH_RING_MIN_BYTES;
+        while (ring.capacity < bytes * 2) ring.capacity *= 2;
+        glBufferData(ring.target, ring.capacity, nullptr, GL_STREAM_DRAW);
+        ring.head = 0;
+    } else if (ring.head + bytes > ring.capacity) {
+        glBufferData(ring.target, ring.capacity, nullptr, GL_STREAM_DRAW); // orphan
+        ring.head = 0;
+        ++glyph_renderer.stats.orphans;
+    }
+    const GLsizeiptr offset = ring.head;
+    if (bytes > 0) glBufferSubData(ring.target, offset, bytes, data);
+    ring.head = (offset + bytes + 15) & ~(GLsizeiptr)15;
+    return offset;
+}
+
+static void glyph_renderer_setup_state(const ImDrawData* dd, int fb_width, int fb_height, float font_global_scale) {
+    auto& r = glyph_renderer;
+    glEnable(GL_BLEND);
+    glBlendEquation(GL_FUNC_ADD);
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    glDisable(GL_CULL_FACE);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_STENCIL_TEST);
+    glEnable(GL_SCISSOR_TEST);
+    glViewport(0, 0, fb_width, fb_height);
+    glActiveTexture(GL_TEXTURE0);
+
+    const float L = dd->DisplayPos.x;
+    const float R = dd->DisplayPos.x + dd->DisplaySize.x;
+    const float T = dd->DisplayPos.y;
+    const float B = dd->DisplayPos.y + dd->DisplaySize.y;
+    const float ortho[4][4] = {
+        { 2.0f/(R-L),   0.0f,         0.0f, 0.0f },
+        { 0.0f,         2.0f/(T-B),   0.0f, 0.0f },
+        { 0.0f,         0.0f,        -1.0f, 0.0f },
+        { (R+L)/(L-R),  (T+B)/(B-T),  0.0f, 1.0f },
+    };
+    const float smoothing = font_state.mode == Font_Mode_SDF ? fonts_sdf_smoothing(font_global_scale) : -1.0f;
+    glUseProgram(r.triangle_program);
+    glUniformMatrix4fv(r.triangle_proj, 1, GL_FALSE, &ortho[0][0]);
+    glUniform1i(r.triangle_texture, 0);
+    glUniform1f(r.triangle_smoothing, smoothing);
+    glUniform1f(r.triangle_alpha8, 0.0f);
+    glUseProgram(r.instance_program);
+    glUniformMatrix4fv(r.instance_proj, 1, GL_FALSE, &ortho[0][0]);
+    glUniform1i(r.instance_texture, 0);
+    glUniform1f(r.instance_smoothing, smoothing);
+    glUniform1f(r.instance_alpha8, 0.0f);
+}
+
+// font_global_scale is io.FontGlobalScale of the frame, like sdf_text_shader_patch()
+static void glyph_renderer_render(ImDrawData* dd, float font_global_scale) {
+    auto& r = glyph_renderer;
+    const int fb_width  = (int)(dd->DisplaySize.x * dd->FramebufferScale.x);
+    const int fb_height = (int)(dd->DisplaySize.y * dd->FramebufferScale.y);
+    if (fb_width <= 0 || fb_height <= 0) return;
+
+    Glyph_Batch& b = r.batch;
+    glyph_batch_build(b, dd, r.stats.frame);
+    ++r.stats.frames;
+    r.stats.upload_bytes       += (unsigned long long)r.stats.frame.upload_bytes;
+    r.stats.stock_upload_bytes += (unsigned long long)r.stats.frame.stock_upload_bytes;
+    r.stats.draws              += (unsigned long long)r.stats.frame.draws;
+    r.stats.stock_draws        += (unsigned long long)r.stats.frame.stock_draws;
+
+    PROFILE_ZONE("glyph_renderer_render");
+    glBindVertexArray(0); // the index ring's binding would otherwise land in whatever VAO is bound
+    glBindBuffer(GL_ARRAY_BUFFER, r.instance_ring.buffer);
+    const GLsizeiptr instance_offset = glyph_ring_write(r.instance_ring, b.instances.Data, b.instances.size_in_bytes());
+    glBindBuffer(GL_ARRAY_BUFFER, r.vertex_ring.buffer);
+    const GLsizeiptr vertex_offset   = glyph_ring_write(r.vertex_ring, b.vertices.Data, b.vertices.size_in_bytes());
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, r.index_ring.buffer);
+    const GLsizeiptr index_offset    = glyph_ring_write(r.index_ring, b.indices.Data, b.indices.size_in_bytes());
+
+    // Every triangle of the frame indexes one vertex array, so its pointers are set once
+    glBindVertexArray(r.triangle_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, r.vertex_ring.buffer);
+    glVertexAttribPointer((GLuint)r.loc_position, 2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)(vertex_offset + IM_OFFSETOF(ImDrawVert, pos)));
+    glVertexAttribPointer((GLuint)r.loc_uv,       2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)(vertex_offset + IM_OFFSETOF(ImDrawVert, uv)));
+    glVertexAttribPointer((GLuint)r.loc_color,    4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)(vertex_offset + IM_OFFSETOF(ImDrawVert, col)));
+
+    glyph_renderer_setup_state(dd, fb_width, fb_height, font_global_scale);
+    GLuint bound_vao = 0;
+    float  triangle_alpha8 = 0.0f, instance_alpha8 = 0.0f; // what setup_state() left in each program
+    const ImVec2 clip_off   = dd->DisplayPos;
+    const ImVec2 clip_scale = dd->FramebufferScale;
+    for (const Glyph_Draw& draw : b.draws) {
+        if (draw.callback) {
+            if (draw.callback != ImDrawCallback_ResetRenderState)
+                draw.callback(draw.callback_list, draw.callback_cmd);
+            glyph_renderer_setup_state(dd, fb_width, fb_height, font_global_scale); // the callback may have changed anything
+            bound_vao = 0;
+            triangle_alpha8 = instance_alpha8 = 0.0f;
+            continue;
+        }
+        const float min_x = (draw.clip_rect.x - clip_off.x) * clip_scale.x;
+        const float min_y = (draw.clip_rect.y - clip_off.y) * clip_scale.y;
+        const float max_x = (draw.clip_rect.z - clip_off.x) * clip_scale.x;
+        const float max_y = (draw.clip_rect.w - clip_off.y) * clip_scale.y;
+        if (max_x <= min_x || max_y <= min_y) continue;
+        glScissor((int)min_x, (int)((float)fb_height - max_y), (int)(max_x - min_x), (int)(max_y - min_y));
+        glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)draw.texture);
+        const float alpha8 = r.alpha8_texture && (GLuint)(intptr_t)draw.texture == r.alpha8_texture ? 1.0f : 0.0f;
+
+        if (draw.index_count) {
+            if (bound_vao != r.triangle_vao) {
+                glUseProgram(r.triangle_program);
+                glBindVertexArray(r.triangle_vao);
+                bound_vao = r.triangle_vao;
+            }
+            if (triangle_alpha8 != alpha8) {
+                glUniform1f(r.triangle_alpha8, alpha8);
+                triangle_alpha8 = alpha8;
+            }
+            glDrawElements(GL_TRIANGLES, draw.index_count, GL_UNSIGNED_INT,
+                           (GLvoid*)(index_offset + (GLsizeiptr)draw.first_index * (GLsizeiptr)sizeof(unsigned int)));
+        }
+        if (draw.instance_count) {
+            if (bound_vao != r.instance_vao) {
+                glUseProgram(r.instance_program);
+                glBindVertexArray(r.instance_vao);
+                glBindBuffer(GL_ARRAY_BUFFER, r.instance_ring.buffer);
+                bound_vao = r.instance_vao;
+            }
+            if (instance_alpha8 != alpha8) {
+                glUniform1f(r.instance_alpha8, alpha8);
+                instance_alpha8 = alpha8;
+            }
+            // ES 3.0 has no base instance, so the pointers move instead
+            const GLsizeiptr first = instance_offset + (GLsizeiptr)draw.first_instance * (GLsizeiptr)sizeof(Glyph_Instance);
+            glVertexAttribPointer((GLuint)r.loc_rect,           4, GL_FLOAT,         GL_FALSE, sizeof(Glyph_Instance), (GLvoid*)(first + IM_OFFSETOF(Glyph_Instance, x0)));
+            glVertexAttribPointer((GLuint)r.loc_uv_rect,        4, GL_FLOAT,         GL_FALSE, sizeof(Glyph_Instance), (GLvoid*)(first + IM_OFFSETOF(Glyph_Instance, u0)));
+            glVertexAttribPointer((GLuint)r.loc_instance_color, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(Glyph_Instance), (GLvoid*)(first + IM_OFFSETOF(Glyph_Instance, col)));
+            glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, draw.instance_count);
+        }
+    }
+    glBindVertexArray(0);
+    glDisable(GL_SCISSOR_TEST);
+}
+
+#else
+
+// NOTE(WALKER): WebGL1 / ES2 build, no instancing: always the stock backend
+static bool glyph_renderer_init(const char*) { return false; }
+static void glyph_renderer_shutdown() {}
+static bool glyph_renderer_active() { return false; }
+static bool glyph_renderer_atlas_to_alpha8(ImFontAtlas*) { return false; }
+static void glyph_renderer_atlas_reset() {}
+static void glyph_renderer_render(ImDrawData*, float) {}
+static void glyph_renderer_fill_report(Glyph_Renderer_Report&) {}
+
+#endif
+
+// Stats for the "Performance" menu, the stock numbers are what ImGui_ImplOpenGL3_RenderDrawData() uploads for the same frame
+static void glyph_renderer_show_menu() {
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+    auto& r = glyph_renderer;
+    if (!r.available) {
+        ImGui::TextDisabled("Instanced glyphs: unavailable (needs GL 3.3 / WebGL2)");
+        return;
+    }
+    ImGui::Checkbox("Instanced glyph renderer", &r.enabled);
+    if (!r.enabled) return;
+    const Glyph_Renderer_Stats& s = glyph_renderer_report.stats;
+    const Glyph_Batch_Stats&    f = s.frame;
+    ImGui::Text("Upload:          %.1f KB (stock %.1f KB), %d draw calls (stock %d)",
+                f.upload_bytes / 1024.0, f.stock_upload_bytes / 1024.0, f.draws, f.stock_draws);
+    ImGui::Text("Geometry:        %d glyph instances, %d triangle vertices, %d indices, %d overlap splits",
+                f.instances, f.vertices, f.indices, f.overlap_splits);
+    ImGui::Text("Session:         %.1f MB uploaded (stock %.1f MB), %llu ring orphans over %llu frames",
+                s.upload_bytes / (1024.0 * 1024.0), s.stock_upload_bytes / (1024.0 * 1024.0), s.orphans, s.frames);
+#else
+    ImGui::TextDisabled("Instanced glyphs: unavailable in the WebGL1 build");
+#endif
+}
@@ -0,0 +1,280 @@
+#include "input_script.hpp"
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+// Item registry (ImGui test engine hooks)
+//-----------------------------------------------------------------------------
+
+struct Script_Item {
+    ImGuiID     id;
+    ImRect      rect;
+    std::string label;
+};
+
+// Items of the frame being built and of the one before it, swapped on the first hook call of every frame
+static std::vector<Script_Item> items_current;
+static std::vector<Script_Item> items_previous;
+static int                      items_frame = -1;
+
+#ifdef IMGUI_ENABLE_TEST_ENGINE
+// NOTE(WALKER): ImGui calls these for every submitted item when g.TestEngineHookItems is set, we only want labels + rects.
+void ImGuiTestEngineHook_ItemAdd(ImGuiContext*, ImGuiID, const ImRect&, const ImGuiLastItemData*) {}
+
+void ImGuiTestEngineHook_ItemInfo(ImGuiContext* ctx, ImGuiID id, const char* label, ImGuiItemStatusFlags) {
+    if (ctx->FrameCount != items_frame) {
+        items_previous.swap(items_current);
+        items_current.clear();
+        items_frame = ctx->FrameCount;
+    }
+    if (!label || ctx->LastItemData.ID != id) return;
+    Script_Item item;
+    item.id    = id;
+    item.rect  = ctx->LastItemData.Rect;
+    item.label = std::string(label, ImGui::FindRenderedTextEnd(label));
+    items_current.push_back(item);
+}
+
+void ImGuiTestEngineHook_Log(ImGuiContext*, const char*, ...) {}
+
+const char* ImGuiTestEngine_FindItemDebugLabel(ImGuiContext*, ImGuiID) { return nullptr; }
+#endif
+
+bool script_items_enable() {
+#ifdef IMGUI_ENABLE_TEST_ENGINE
+    GImGui->TestEngineHookItems = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Called between frames: items_current is the last complete frame
+static bool find_item(const std::string& label, ImVec2& center) {
+    for (const std::vector<Script_Item>* list : { &items_current, &items_previous }) {
+        for (const Script_Item& item : *list) {
+            if (item.label == label) {
+                center = item.rect.GetCenter();
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+// Parsing
+//-----------------------------------------------------------------------------
+
+static bool script_error(const Input_Script& script, int line, const char* fmt, ...) {
+    fprintf(stderr, "%s:%d: error: ", script.path.c_str(), line);
+    va_list args;
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    va_end(args);
+    fprintf(stderr, "\n");
+    return false;
+}
+
+static std::string trim(const std::string& s) {
+    size_t b = 0, e = s.size();
+    while (b < e && (s[b] == ' ' || s[b] == '\t')) ++b;
+    while (e > b && (s[e - 1] == ' ' || s[e - 1] == '\t' || s[e - 1] == '\r')) --e;
+    return s.substr(b, e - b);
+}
+
+static std::string unquote(const std::string& s) {
+    if (s.size() >= 2 && s.front() == '"' && s.back() == '"') return s.substr(1, s.size() - 2);
+    return s;
+}
+
+// "120" or "50%"
+static bool parse_coordinate(const char* token, float& value, bool& percent) {
+    char* end = nullptr;
+    value = strtof(token, &end);
+    if (end == token) return false;
+    percent = *end == '%';
+    return *end == '\0' || (percent && end[1] == '\0');
+}
+
+static ImGuiKey parse_key(const char* name) {
+    for (int k = ImGuiKey_NamedKey_BEGIN; k < ImGuiKey_NamedKey_END; ++k)
+        if (strcmp(ImGui::GetKeyName((ImGuiKey)k), name) == 0)
+            return (ImGuiKey)k;
+    return ImGuiKey_None;
+}
+
+static bool parse_step(const Input_Script& script, int line, const std::string& keyword, const std::string& rest, Script_Step& step) {
+    step.line = line;
+    char a[128] = {}, b[128] = {};
+    const int tokens = sscanf(rest.c_str(), "%127s %127s", a, b);
+
+    if (keyword == "frames") {
+        step.op = Script_Op_Frames;
+        step.count = tokens >= 1 ? atoi(a) : -1;
+        if (step.count < 0) return script_error(script, line, "frames needs a count >= 0");
+    } else if (keyword == "mouse") {
+        step.op = Script_Op_Mouse;
+        if (tokens != 2 || !parse_coordinate(a, step.x, step.x_percent) || !parse_coordinate(b, step.y, step.y_percent))
+            return script_error(script, line, "mouse needs <x> <y> (pixels or percent)");
+    } else if (keyword == "move" || keyword == "click") {
+        step.op = keyword == "move" ? Script_Op_Move : Script_Op_Click;
+        step.text = unquote(rest);
+        if (step.text.empty()) return script_error(script, line, "%s needs an item label", keyword.c_str());
+    } else if (keyword == "wheel") {
+        step.op = Script_Op_Wheel;
+        char* end = nullptr;
+        step.y = tokens >= 1 ? strtof(a, &end) : 0.0f;
+        step.count = tokens >= 2 ? atoi(b) : 1;
+        if (tokens < 1 || end == a || step.count < 1) return script_error(script, line, "wheel needs <dy> [<frames>]");
+    } else if (keyword == "key") {
+        step.op = Script_Op_Key;
+        step.key = tokens >= 1 ? parse_key(a) : ImGuiKey_None;
+        step.count = tokens >= 2 ? atoi(b) : 1;
+        if (step.key == ImGuiKey_None) return script_error(script, line, "unknown key '%s'", a);
+        if (step.count < 1) return script_error(script, line, "key repeat count must be >= 1");
+    } else if (keyword == "text") {
+        step.op = Script_Op_Text;
+        step.text = unquote(rest);
+    } else if (keyword == "resize") {
+        step.op = Script_Op_Resize;
+        step.x = tokens >= 1 ? strtof(a, nullptr) : 0.0f;
+        step.y = tokens >= 2 ? strtof(b, nullptr) : 0.0f;
+        if (tokens != 2 || step.x < 1.0f || step.y < 1.0f) return script_error(script, line, "resize needs <width> <height> in pixels");
+    } else {
+        return script_error(script, line, "unknown step '%s'", keyword.c_str());
+    }
+    return true;
+}
+
+bool input_script_load(Input_Script& script, const char* path) {
+    script.path = path;
+    script.scenarios.clear();
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "%s: error: can't open script\n", path);
+        return false;
+    }
+    std::string src;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) src.append(buf, n);
+    fclose(f);
+
+    bool ok = true;
+    int line = 1;
+    for (size_t start = 0; start < src.size(); ++line) {
+        size_t end = src.find('\n', start);
+        if (end == std::string::npos) end = src.size();
+        const std::string text = trim(src.substr(start, end - start));
+        start = end + 1;
+        if (text.empty() || text[0] == '#') continue;
+
+        const size_t space = text.find_first_of(" \t");
+        const std::string keyword = text.substr(0, space);
+        const std::string rest    = space == std::string::npos ? "" : trim(text.substr(space));
+
+        if (keyword == "scenario") {
+            if (rest.empty()) { ok = script_error(script, line, "scenario needs a name"); continue; }
+            if (rest.find_first_of(" \t") != std::string::npos) { ok = script_error(script, line, "scenario names can't contain spaces (baseline files are whitespace separated)"); continue; }
+            Script_Scenario scenario;
+            scenario.name = rest;
+            script.scenarios.push_back(scenario);
+            continue;
+        }
+        if (script.scenarios.empty()) { ok = script_error(script, line, "step before the first scenario"); continue; }
+        Script_Step step;
+        if (!parse_step(script, line, keyword, rest, step)) { ok = false; continue; }
+        script.scenarios.back().steps.push_back(step);
+    }
+    if (ok && script.scenarios.empty()) {
+        fprintf(stderr, "%s: error: no scenarios\n", path);
+        ok = false;
+    }
+    return ok;
+}
+
+//-----------------------------------------------------------------------------
+// Playback
+//-----------------------------------------------------------------------------
+
+void script_player_start(Script_Player& player, const Script_Scenario& scenario) {
+    player = Script_Player();
+    player.scenario = &scenario;
+    items_current.clear();
+    items_previous.clear();
+    items_frame = -1;
+}
+
+static bool player_fail(Script_Player& player, const Script_Step& step, const std::string& why) {
+    player.failed = true;
+    player.error  = "line " + std::to_string(step.line) + ": " + why;
+    return false;
+}
+
+bool script_player_feed(Script_Player& player, ImGuiIO& io) {
+    if (!player.scenario || player.failed) return false;
+    script_items_enable();
+
+    const std::vector<Script_Step>& steps = player.scenario->steps;
+    while (player.step < steps.size()) {
+        const Script_Step& s = steps[player.step];
+        const int frame = player.step_frame++;
+        switch (s.op) {
+        case Script_Op_Frames: {
+            if (frame < s.count) return true;
+        } break;
+        case Script_Op_Mouse: {
+            if (frame == 0) {
+                io.AddMousePosEvent(s.x_percent ? s.x * 0.01f * io.DisplaySize.x : s.x,
+                                    s.y_percent ? s.y * 0.01f * io.DisplaySize.y : s.y);
+                return true;
+            }
+        } break;
+        case Script_Op_Move:
+        case Script_Op_Click: {
+            if (frame == 0) {
+                ImVec2 center;
+                if (!find_item(s.text, center))
+                    return player_fail(player, s, "no item labeled \"" + s.text + "\" was submitted last frame");
+                io.AddMousePosEvent(center.x, center.y);
+                return true;
+            }
+            if (s.op == Script_Op_Click && frame == 1) { io.AddMouseButtonEvent(ImGuiMouseButton_Left, true);  return true; }
+            if (s.op == Script_Op_Click && frame == 2) { io.AddMouseButtonEvent(ImGuiMouseButton_Left, false); return true; }
+        } break;
+        case Script_Op_Wheel: {
+            if (frame < s.count) {
+                io.AddMouseWheelEvent(0.0f, s.y);
+                return true;
+            }
+        } break;
+        case Script_Op_Key: {
+            if (frame < 2 * s.count) {
+                io.AddKeyEvent(s.key, frame % 2 == 0);
+                return true;
+            }
+        } break;
+        case Script_Op_Text: {
+            if (frame == 0) {
+                io.AddInputCharactersUTF8(s.text.c_str());
+                return true;
+            }
+        } break;
+        case Script_Op_Resize: {
+            if (frame == 0) {
+                io.DisplaySize = ImVec2(s.x, s.y); // the headless loop notices and resizes the fonts like resume.cpp does
+                return true;
+            }
+        } break;
+        }
+        ++player.step;
+        player.step_frame = 0;
+    }
+    return false;
+}
@@ -0,0 +1,77 @@
+// NOTE(WALKER): Scripted input for the headless benchmark (resume_headless --bench).
+//               A script is a list of named scenarios, each a list of steps that queue mouse/keyboard/wheel events into
+//               ImGuiIO frame by frame, so runs are deterministic and need no browser. Syntax (one step per line, # comments):
+//
+//                   scenario <name>        starts a scenario, every step until the next one belongs to it
+//                   frames <n>             n frames without input
+//                   mouse <x> <y>          move the mouse, pixels or percent of the display ("50% 60%")
+//                   move <label>           move the mouse to the center of the item with that label (last frame's layout)
+//                   click <label>          move + left click (3 frames: move, press, release)
+//                   wheel <dy> [<n>]       vertical wheel event every frame for n frames (default 1)
+//                   key <name> [<n>]       press + release a key n times (ImGui key names: Tab, Enter, Escape, DownArrow, ...)
+//                   text <string>          type characters
+//                   resize <w> <h>         change the display size (window resize / DPI change), in pixels
+//
+//               Labels are matched against the visible part (before "##") of every item ImGui submitted last frame, which
+//               needs the build to define IMGUI_ENABLE_TEST_ENGINE: we implement ImGui's test engine item hooks in
+//               input_script.cpp to record item labels and rects (the native Makefile target does this).
+
+#pragma once
+
+#include "imgui.h"
+#include <string>
+#include <vector>
+
+enum Script_Op {
+    Script_Op_Frames,
+    Script_Op_Mouse,
+    Script_Op_Move,
+    Script_Op_Click,
+    Script_Op_Wheel,
+    Script_Op_Key,
+    Script_Op_Text,
+    Script_Op_Resize,
+};
+
+struct Script_Step {
+    Script_Op   op        = Script_Op_Frames;
+    int         line      = 0;
+    int         count     = 1;     // frames / repeats
+    float       x         = 0.0f;  // mouse position, or wheel delta in y
+    float       y         = 0.0f;
+    bool        x_percent = false;
+    bool        y_percent = false;
+    ImGuiKey    key       = ImGuiKey_None;
+    std::string text;              // label for move/click, characters for text
+};
+
+struct Script_Scenario {
+    std::string              name;
+    std::vector<Script_Step> steps;
+};
+
+struct Input_Script {
+    std::string                  path;
+    std::vector<Script_Scenario> scenarios;
+};
+
+// Parses the whole script, reporting "path:line: error" for every bad line. Needs an ImGui context (key names).
+bool input_script_load(Input_Script& script, const char* path);
+
+struct Script_Player {
+    const Script_Scenario* scenario   = nullptr;
+    size_t                 step       = 0;
+    int                    step_frame = 0;
+    bool                   failed     = false;
+    std::string            error;
+};
+
+void script_player_start(Script_Player& player, const Script_Scenario& scenario);
+
+// Call once per frame before ImGui::NewFrame(), queues this frame's events.
+// Returns false once the scenario is finished (or failed, see player.failed/error), in which case nothing was queued.
+bool script_player_feed(Script_Player& player, ImGuiIO& io);
+
+// Turns on ImGui's per-item hooks so labels can be resolved, call after ImGui::CreateContext().
+// Returns false when the build has no IMGUI_ENABLE_TEST_ENGINE (label steps will then fail).
+bool script_items_enable();
@@ -0,0 +1,134 @@
+// NOTE(WALKER): Memory accounting for the "Performance" menu: the heap, the font atlas (CPU copies and the GL texture), our GL
+//               buffers and every font's glyph tables, plus a heap budget.
+//               ALLOW_MEMORY_GROWTH=1 lets the wasm heap grow with no limit and wasm memory never shrinks, so the heap size is
+//               also its high-water mark. What malloc actually hands out is sampled separately (mallinfo() walks the heap, so
+//               only every MEMORY_SAMPLE_INTERVAL frames). When the heap grows past the budget (HEAP_BUDGET_MB in the Makefile,
+//               0 = off) a warning goes to the console once per growth and the menu shows it in red.
+//
+//               The font texture is RGBA32 for the stock backend, but every texel of it is white + coverage. While the
+//               instanced renderer draws, it is re-specified as GL_R8 (glyph_renderer_atlas_to_alpha8()), a quarter of the
+//               bytes, and the shader expands it. resume.cpp switches the format whenever the renderer changes.
+//               Sizes of GL objects are what we asked for, the driver may round up or double buffer.
+
+#pragma once
+
+#include "imgui.h"
+#include "allocator.hpp"
+#include "glyph_renderer.hpp"
+#include "render_scale_target.hpp"
+#include "damage_target.hpp"
+#include <stdio.h>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten/heap.h>
+#include <malloc.h>
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#ifndef RESUME_HEAP_BUDGET_MB
+#define RESUME_HEAP_BUDGET_MB 0
+#endif
+
+constexpr int MEMORY_SAMPLE_INTERVAL = 60; // frames between mallinfo() samples
+
+struct Memory_Panel {
+    bool   alpha8_atlas   = true;  // menu checkbox: single channel font texture whenever the instanced renderer draws
+    bool   atlas_alpha8   = false; // what the font texture is right now
+    bool   alpha8_failed  = false; // a conversion failed and turned alpha8_atlas off, until the checkbox is ticked again
+    float  heap_budget_mb = (float)RESUME_HEAP_BUDGET_MB;
+
+    size_t heap_size      = 0; // wasm memory (web), bytes malloc got from the system (native)
+    size_t heap_peak      = 0;
+    size_t heap_used      = 0; // handed out by malloc, last sample
+    size_t heap_used_peak = 0;
+    size_t warned_size    = 0; // heap size of the last budget warning
+    int    warnings       = 0;
+    size_t stock_buffer_bytes = 0; // last frame's vertices + indices, the stock backend's buffers hold at least that
+    unsigned long long frames = 0;
+};
+
+static Memory_Panel memory_panel;
+
+static void memory_sample_heap(Memory_Panel& m, bool walk) {
+#if defined(__EMSCRIPTEN__)
+    m.heap_size = emscripten_get_heap_size();
+    if (walk) m.heap_used = (size_t)mallinfo().uordblks;
+#elif defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    if (walk) {
+        const struct mallinfo2 info = mallinfo2();
+        m.heap_size = info.arena + info.hblkhd;
+        m.heap_used = info.uordblks + info.hblkhd;
+    }
+#else
+    m.heap_size = m.heap_used = allocator_stats.heap_bytes; // only what goes through ImGui's allocator
+#endif
+    if (m.heap_size > m.heap_peak)      m.heap_peak      = m.heap_size;
+    if (m.heap_used > m.heap_used_peak) m.heap_used_peak = m.heap_used;
+}
+
+// After ImGui::Render(), once per rendered frame
+static void memory_panel_frame(const ImDrawData* draw_data) {
+    auto& m = memory_panel;
+    memory_sample_heap(m, m.frames++ % MEMORY_SAMPLE_INTERVAL == 0);
+    if (draw_data) m.stock_buffer_bytes = (size_t)draw_data->TotalVtxCount * sizeof(ImDrawVert) + (size_t)draw_data->TotalIdxCount * sizeof(ImDrawIdx);
+
+    const size_t budget = (size_t)(m.heap_budget_mb * 1024.0f * 1024.0f);
+    if (budget > 0 && m.heap_size > budget && m.heap_size > m.warned_size) {
+        fprintf(stderr, "[memory] heap grew to %.1f MB, over the %.0f MB budget (%.1f MB in use)\n",
+                m.heap_size / (1024.0 * 1024.0), m.heap_budget_mb, m.heap_used / (1024.0 * 1024.0));
+        m.warned_size = m.heap_size;
+        ++m.warnings;
+    }
+}
+
+static double memory_kb(size_t bytes) { return bytes / 1024.0; }
+
+// NOTE(WALKER): Shown in the menu bar "Performance" menu
+static void memory_panel_show_menu() {
+    auto& m = memory_panel;
+    const ImGuiIO& io = ImGui::GetIO();
+    const ImFontAtlas* atlas = io.Fonts;
+
+    ImGui::Text("Heap:            %.1f MB (peak %.1f MB), %.1f MB in use (peak %.1f MB)",
+                m.heap_size / (1024.0 * 1024.0), m.heap_peak / (1024.0 * 1024.0), m.heap_used / (1024.0 * 1024.0), m.heap_used_peak / (1024.0 * 1024.0));
+    ImGui::SliderFloat("Heap budget (MB)", &m.heap_budget_mb, 0.0f, 512.0f, m.heap_budget_mb > 0.0f ? "%.0f" : "off");
+    if (m.heap_budget_mb > 0.0f && m.heap_size > (size_t)(m.heap_budget_mb * 1024.0f * 1024.0f))
+        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Over budget:     %.1f MB over, %d warnings", (m.heap_size - (size_t)(m.heap_budget_mb * 1024.0f * 1024.0f)) / (1024.0 * 1024.0), m.warnings);
+
+    // Atlas: the GL texture and what the atlas keeps on the CPU side
+    if (glyph_renderer_active()) {
+        if (ImGui::Checkbox("Single channel font atlas", &m.alpha8_atlas)) m.alpha8_failed = false; // ticked again: one more try
+        if (m.alpha8_failed)
+            ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Font atlas:      single channel conversion failed, staying RGBA32");
+    } else
+        ImGui::TextDisabled("Font atlas:      single channel needs the instanced glyph renderer");
+    const size_t texels = (size_t)atlas->TexWidth * (size_t)atlas->TexHeight;
+    ImGui::Text("Font texture:    %dx%d %s, %.1f KB (RGBA32 would be %.1f KB)", atlas->TexWidth, atlas->TexHeight,
+                m.atlas_alpha8 ? "R8" : "RGBA32", memory_kb(texels * (m.atlas_alpha8 ? 1 : 4)), memory_kb(texels * 4));
+    ImGui::Text("Atlas pixels:    %.1f KB Alpha8 + %.1f KB RGBA32 on the heap",
+                memory_kb(atlas->TexPixelsAlpha8 ? texels : 0), memory_kb(atlas->TexPixelsRGBA32 ? texels * 4 : 0));
+    for (const ImFont* font : atlas->Fonts) {
+        const size_t tables = (size_t)font->Glyphs.size_in_bytes() + (size_t)font->IndexLookup.size_in_bytes() + (size_t)font->IndexAdvanceX.size_in_bytes();
+        ImGui::BulletText("%s: %d glyphs, %.1f KB of tables", font->GetDebugName(), font->Glyphs.Size, memory_kb(tables));
+    }
+
+    // GL buffers and render targets
+    ImGui::Text("Framebuffer:     %.1f KB (%.0fx%.0f, front + back)", memory_kb((size_t)(io.DisplaySize.x * io.DisplayFramebufferScale.x * io.DisplaySize.y * io.DisplayFramebufferScale.y) * 4 * 2),
+                io.DisplaySize.x * io.DisplayFramebufferScale.x, io.DisplaySize.y * io.DisplayFramebufferScale.y);
+    ImGui::Text("Stock buffers:   %.1f KB (at least, last frame's vertices + indices)", memory_kb(m.stock_buffer_bytes));
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+    // NOTE(WALKER): The render thread's objects, as of the last frame it handed back (glyph_renderer_report and friends)
+    const auto& g = glyph_renderer_report;
+    if (glyph_renderer.available)
+        ImGui::Text("Glyph rings:     %.1f KB (instances %.1f, vertices %.1f, indices %.1f)",
+                    memory_kb(g.instance_ring + g.vertex_ring + g.index_ring),
+                    memory_kb(g.instance_ring), memory_kb(g.vertex_ring), memory_kb(g.index_ring));
+    const auto& s = render_scale_report;
+    if (s.width)
+        ImGui::Text("Scaled target:   %.1f KB (%dx%d)", memory_kb((size_t)s.width * (size_t)s.height * 4), s.width, s.height);
+    const auto& dt = damage_target_report;
+    if (dt.width)
+        ImGui::Text("Damage target:   %.1f KB (%dx%d)", memory_kb((size_t)dt.width * (size_t)dt.height * 4), dt.width, dt.height);
+#endif
+}
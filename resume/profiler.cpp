@@ -0,0 +1,255 @@
+#include "profiler.hpp"
+
+#include "imgui.h"
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <chrono>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#endif
+
+#include "../Utilities/defer.hpp"
+#include "allocator.hpp"
+
+Profiler_State profiler;
+
+struct Profile_Event {
+    const char* name;
+    double      start_ms;
+    double      end_ms;
+    uint32_t    frame;
+    uint16_t    depth;
+    uint16_t    thread;
+};
+
+static constexpr uint32_t PROFILER_EVENT_CAPACITY = 1 << 13; // must be a power of 2, ~15 zones a frame -> the last ~500 frames
+static constexpr int      PROFILER_FRAME_CAPACITY = 512;
+static constexpr int      PROFILER_HISTOGRAM_BUCKETS = 32;
+
+// NOTE(WALKER): Lock-free ring: a writer claims a slot with one fetch_add on event_write, marks it busy (sequence 0),
+//               fills it in, then publishes it by storing claim + 1. Readers only take slots whose sequence is the one they
+//               expect before AND after copying, so a slot being overwritten mid-read is just skipped (seqlock style).
+static Profile_Event         events[PROFILER_EVENT_CAPACITY];
+static std::atomic<uint32_t> event_sequence[PROFILER_EVENT_CAPACITY];
+static std::atomic<uint32_t> event_write{0};
+static std::atomic<uint32_t> current_frame{0};
+static std::atomic<uint16_t> next_thread_index{0};
+
+// Frame times, only touched by the main loop thread
+static float    frame_times[PROFILER_FRAME_CAPACITY];
+static uint32_t frames_recorded     = 0;
+static uint32_t last_complete_frame = 0;
+static double   frame_start_ms      = 0.0;
+
+static const std::chrono::steady_clock::time_point clock_origin = std::chrono::steady_clock::now();
+
+double profiler_now_ms() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - clock_origin).count();
+}
+
+int& profiler_zone_depth() {
+    static thread_local int depth = 0;
+    return depth;
+}
+
+static uint16_t profiler_thread_index() {
+    static thread_local int index = -1;
+    if (index < 0) index = next_thread_index.fetch_add(1, std::memory_order_relaxed);
+    return (uint16_t)index;
+}
+
+Profile_Zone::Profile_Zone(const char* zone_name) : name(zone_name), start_ms(0.0), active(profiler.enabled) {
+    if (!active) return;
+    start_ms = profiler_now_ms();
+    ++profiler_zone_depth();
+}
+
+Profile_Zone::~Profile_Zone() {
+    if (!active) return;
+    const int depth = --profiler_zone_depth();
+    profiler_push_zone(name, start_ms, profiler_now_ms(), depth);
+}
+
+void profiler_push_zone(const char* name, double start_ms, double end_ms, int depth) {
+    const uint32_t claim = event_write.fetch_add(1, std::memory_order_relaxed);
+    const uint32_t slot  = claim & (PROFILER_EVENT_CAPACITY - 1);
+    event_sequence[slot].store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Profile_Event& e = events[slot];
+    e.name     = name;
+    e.start_ms = start_ms;
+    e.end_ms   = end_ms;
+    e.frame    = current_frame.load(std::memory_order_relaxed);
+    e.depth    = (uint16_t)depth;
+    e.thread   = profiler_thread_index();
+
+    event_sequence[slot].store(claim + 1, std::memory_order_release);
+}
+
+// Copies every published event still in the ring into out (room for PROFILER_EVENT_CAPACITY), oldest claim first
+static int profiler_read_events(Profile_Event* out) {
+    int count = 0;
+    const uint32_t end   = event_write.load(std::memory_order_acquire);
+    const uint32_t total = end < PROFILER_EVENT_CAPACITY ? end : PROFILER_EVENT_CAPACITY;
+    for (uint32_t claim = end - total; claim != end; ++claim) {
+        const uint32_t slot = claim & (PROFILER_EVENT_CAPACITY - 1);
+        if (event_sequence[slot].load(std::memory_order_acquire) != claim + 1) continue; // not published yet
+        const Profile_Event e = events[slot];
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (event_sequence[slot].load(std::memory_order_relaxed) != claim + 1) continue; // overwritten while copying
+        out[count++] = e;
+    }
+    return count;
+}
+
+void profiler_frame_begin() {
+    current_frame.fetch_add(1, std::memory_order_relaxed);
+    frame_start_ms = profiler_now_ms();
+}
+
+void profiler_frame_end() {
+    frame_times[frames_recorded % PROFILER_FRAME_CAPACITY] = (float)(profiler_now_ms() - frame_start_ms);
+    ++frames_recorded;
+    last_complete_frame = current_frame.load(std::memory_order_relaxed);
+}
+
+static int compare_floats(const void* a, const void* b) {
+    const float x = *(const float*)a, y = *(const float*)b;
+    return x < y ? -1 : x > y ? 1 : 0;
+}
+
+static int compare_event_start(const void* a, const void* b) {
+    const Profile_Event* x = (const Profile_Event*)a;
+    const Profile_Event* y = (const Profile_Event*)b;
+    if (x->start_ms != y->start_ms) return x->start_ms < y->start_ms ? -1 : 1;
+    return (int)x->depth - (int)y->depth; // same start: parent first
+}
+
+void profiler_show_overlay() {
+    if (!profiler.show_overlay) return;
+    const bool visible = ImGui::Begin("Profiler", &profiler.show_overlay, ImGuiWindowFlags_AlwaysAutoResize);
+    defer { ImGui::End(); };
+    if (!visible) return;
+
+    ImGui::Checkbox("Record zones", &profiler.enabled);
+
+    // Frame times (oldest first) + percentiles. Scratch comes from the frame arena, gone next frame (allocator.hpp)
+    float* timeline = frame_arena_alloc_array<float>(PROFILER_FRAME_CAPACITY);
+    float* sorted   = frame_arena_alloc_array<float>(PROFILER_FRAME_CAPACITY);
+    const int count = (int)(frames_recorded < (uint32_t)PROFILER_FRAME_CAPACITY ? frames_recorded : (uint32_t)PROFILER_FRAME_CAPACITY);
+    if (count == 0) {
+        ImGui::TextUnformatted("No frames recorded yet");
+        return;
+    }
+    const uint32_t first = frames_recorded - (uint32_t)count;
+    double sum = 0.0;
+    for (int i = 0; i < count; ++i) {
+        timeline[i] = frame_times[(first + (uint32_t)i) % PROFILER_FRAME_CAPACITY];
+        sorted[i]   = timeline[i];
+        sum += timeline[i];
+    }
+    qsort(sorted, (size_t)count, sizeof(float), compare_floats);
+    auto percentile = [&](float p) { return sorted[(int)(p * (float)(count - 1))]; };
+    const float max_ms = sorted[count - 1];
+
+    ImGui::Text("Last %d frames:  avg %.3f ms  max %.3f ms", count, sum / count, max_ms);
+    ImGui::Text("p50 %.3f ms  p95 %.3f ms  p99 %.3f ms", percentile(0.50f), percentile(0.95f), percentile(0.99f));
+    ImGui::PlotLines("##frame times", timeline, count, 0, "frame ms", 0.0f, max_ms, ImVec2(360, 60));
+
+    float buckets[PROFILER_HISTOGRAM_BUCKETS] = {};
+    const float bucket_ms = max_ms > 0.0f ? max_ms / PROFILER_HISTOGRAM_BUCKETS : 1.0f;
+    for (int i = 0; i < count; ++i) {
+        int b = (int)(sorted[i] / bucket_ms);
+        buckets[b < PROFILER_HISTOGRAM_BUCKETS ? b : PROFILER_HISTOGRAM_BUCKETS - 1] += 1.0f;
+    }
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "0 .. %.2f ms", max_ms);
+    ImGui::PlotHistogram("##frame histogram", buckets, PROFILER_HISTOGRAM_BUCKETS, 0, overlay, 0.0f, FLT_MAX, ImVec2(360, 60));
+
+    // Zones of the last complete frame, in start order and indented by depth
+    Profile_Event* scratch = frame_arena_alloc_array<Profile_Event>((int)PROFILER_EVENT_CAPACITY);
+    const int read = profiler_read_events(scratch);
+    int kept = 0;
+    for (int i = 0; i < read; ++i)
+        if (scratch[i].frame == last_complete_frame) scratch[kept++] = scratch[i];
+    if (kept) qsort(scratch, (size_t)kept, sizeof(Profile_Event), compare_event_start);
+
+    ImGui::Separator();
+    ImGui::Text("Frame %u zones:", last_complete_frame);
+    if (ImGui::BeginTable("zones", 2, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+        defer { ImGui::EndTable(); };
+        for (int i = 0; i < kept; ++i) {
+            const Profile_Event& e = scratch[i];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            if (e.depth) ImGui::Indent(e.depth * 12.0f);
+            ImGui::TextUnformatted(e.name);
+            if (e.depth) ImGui::Unindent(e.depth * 12.0f);
+            ImGui::TableNextColumn();
+            ImGui::Text("%8.3f ms", e.end_ms - e.start_ms);
+        }
+    }
+
+    static const char* export_status = nullptr;
+    if (ImGui::Button("Export Chrome trace"))
+        export_status = profiler_export_chrome_trace("frame_trace.json") ? "Wrote frame_trace.json" : "Export failed";
+    ImGui::SetItemTooltip("Every zone still in the ring buffer, open it in chrome://tracing or ui.perfetto.dev");
+    if (export_status) {
+        ImGui::SameLine();
+        ImGui::TextUnformatted(export_status);
+    }
+}
+
+#ifdef __EMSCRIPTEN__
+// NOTE(WALKER): No file system to speak of in the browser, hand the JSON over as a download instead
+EM_JS(void, profiler_download, (const char* name, const char* data, int length), {
+    const blob = new Blob([HEAPU8.subarray(data, data + length)], { type: "application/json" });
+    const a = document.createElement("a");
+    a.href = URL.createObjectURL(blob);
+    a.download = UTF8ToString(name);
+    a.click();
+    setTimeout(() => URL.revokeObjectURL(a.href), 1000);
+});
+#endif
+
+static void append_json_string(ImGuiTextBuffer& out, const char* s) {
+    for (; *s; ++s) {
+        const unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') { const char esc[3] = { '\\', (char)c, 0 }; out.append(esc); }
+        else if (c < 0x20)         out.appendf("\\u%04x", c);
+        else                       out.append(s, s + 1);
+    }
+}
+
+bool profiler_export_chrome_trace(const char* path) {
+    ImVector<Profile_Event> all;
+    all.resize((int)PROFILER_EVENT_CAPACITY);
+    all.resize(profiler_read_events(all.Data));
+
+    ImGuiTextBuffer json;
+    json.reserve(all.Size * 120 + 64);
+    json.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (int i = 0; i < all.Size; ++i) {
+        const Profile_Event& e = all[i];
+        json.append("{\"name\":\"");
+        append_json_string(json, e.name ? e.name : "?");
+        json.appendf("\",\"cat\":\"frame\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"frame\":%u,\"depth\":%u}}%s\n",
+                     e.start_ms * 1000.0, (e.end_ms - e.start_ms) * 1000.0, (unsigned)e.thread, e.frame, (unsigned)e.depth,
+                     i + 1 < all.Size ? "," : "");
+    }
+    json.append("]}\n");
+
+#ifdef __EMSCRIPTEN__
+    profiler_download(path, json.c_str(), json.size());
+    return true;
+#else
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    defer { fclose(f); };
+    return fwrite(json.c_str(), 1, (size_t)json.size(), f) == (size_t)json.size();
+#endif
+}
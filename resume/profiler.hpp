@@ -0,0 +1,48 @@
+// NOTE(WALKER): Tiny built-in frame profiler.
+//               PROFILE_ZONE("name") times the enclosing scope and pushes {name, start, end, depth, thread, frame} into a fixed
+//               size lock-free ring buffer (any thread can push, a slot is claimed with one atomic add), so zones cost two clock
+//               reads and a few stores. profiler_frame_begin()/profiler_frame_end() bracket one main loop iteration.
+//               The overlay (toggled from the menu bar next to "Style") shows the last frame's zones, a frame time histogram
+//               and p50/p95/p99, and everything still in the ring can be exported as Chrome trace JSON (chrome://tracing, Perfetto).
+//               Zone names must be string literals or otherwise outlive the ring (e.g. strings in the content buffer).
+
+#pragma once
+
+#include <stdint.h>
+
+void   profiler_push_zone(const char* name, double start_ms, double end_ms, int depth);
+double profiler_now_ms();
+int&   profiler_zone_depth(); // per thread nesting depth
+
+struct Profile_Zone {
+    const char* name;
+    double      start_ms;
+    bool        active;
+
+    explicit Profile_Zone(const char* zone_name);
+    ~Profile_Zone();
+    Profile_Zone(const Profile_Zone&) = delete;
+    Profile_Zone& operator=(const Profile_Zone&) = delete;
+};
+
+#define PROFILE_ZONE_CONCAT2(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT2(a, b)
+#define PROFILE_ZONE(name) Profile_Zone PROFILE_ZONE_CONCAT(profile_zone_, __LINE__)(name)
+
+struct Profiler_State {
+    bool enabled      = true;
+    bool show_overlay = false;
+};
+
+extern Profiler_State profiler;
+
+// Bracket one main loop iteration. Iterations that end without profiler_frame_end() (e.g. skipped by the frame pacer)
+// keep their zones in the trace but don't count as frames.
+void profiler_frame_begin();
+void profiler_frame_end();
+
+// Call between ImGui::NewFrame() and ImGui::Render(), draws the overlay window when profiler.show_overlay is set.
+void profiler_show_overlay();
+
+// Writes every zone still in the ring as Chrome trace JSON. On the web the file is handed to the browser as a download.
+bool profiler_export_chrome_trace(const char* path);
@@ -0,0 +1,255 @@
+#include "render_pipeline.hpp"
+#include "profiler.hpp"
+
+#include "imgui.h"
+#include <stdio.h>
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+// Snapshots
+//-----------------------------------------------------------------------------
+
+// resize() + memcpy instead of operator=, which frees and reallocates every time
+template <typename T> static void snapshot_copy_vector(ImVector<T>& dst, const ImVector<T>& src) {
+    dst.resize(src.Size);
+    if (src.Size) memcpy(dst.Data, src.Data, (size_t)src.size_in_bytes());
+}
+
+static void draw_snapshot_copy(Draw_Snapshot& s, const ImDrawData* dd) {
+    while (s.lists.Size < dd->CmdListsCount) s.lists.push_back(IM_NEW(ImDrawList)(nullptr));
+    ImDrawData& out = s.draw_data;
+    out.Valid            = dd->Valid;
+    out.CmdListsCount    = dd->CmdListsCount;
+    out.TotalIdxCount    = dd->TotalIdxCount;
+    out.TotalVtxCount    = dd->TotalVtxCount;
+    out.DisplayPos       = dd->DisplayPos;
+    out.DisplaySize      = dd->DisplaySize;
+    out.FramebufferScale = dd->FramebufferScale;
+    out.OwnerViewport    = nullptr; // main thread state, the render thread has no business with it
+    out.CmdLists.resize(0);
+    for (int n = 0; n < dd->CmdListsCount; ++n) {
+        const ImDrawList* src = dd->CmdLists[n];
+        ImDrawList*       dst = s.lists[n];
+        snapshot_copy_vector(dst->CmdBuffer, src->CmdBuffer);
+        snapshot_copy_vector(dst->IdxBuffer, src->IdxBuffer);
+        snapshot_copy_vector(dst->VtxBuffer, src->VtxBuffer);
+        dst->Flags = src->Flags;
+        out.CmdLists.push_back(dst);
+    }
+}
+
+static void draw_snapshot_free(Draw_Snapshot& s) {
+    for (ImDrawList* list : s.lists) IM_DELETE(list);
+    s.lists.clear();
+    s.draw_data.CmdLists.clear();
+    s.draw_data.CmdListsCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Handoff
+//-----------------------------------------------------------------------------
+
+#if RENDER_PIPELINE_THREADS
+static void pipeline_wake(Render_Pipeline& p) {
+    { std::lock_guard<std::mutex> lock(p.park_mutex); } // a waiter between its check and wait() can't miss this
+    p.park.notify_all();
+}
+
+// Spins a little (the other side is usually about to finish), then parks
+template <typename Done> static void pipeline_wait(Render_Pipeline& p, Done done) {
+    for (int spin = 0; spin < 64; ++spin) {
+        if (done()) return;
+        std::this_thread::yield();
+    }
+    std::unique_lock<std::mutex> lock(p.park_mutex);
+    p.park.wait(lock, done);
+}
+
+static void pipeline_thread(Render_Pipeline* pipeline) {
+    Render_Pipeline& p = *pipeline;
+    const bool ok = p.attach();
+    p.attached.store(ok ? 1 : -1, std::memory_order_release);
+    pipeline_wake(p);
+    if (!ok) return;
+
+    for (;;) {
+        const int slot = p.render_slot;
+        pipeline_wait(p, [&] { return p.state[slot].load(std::memory_order_acquire) == Render_Pipeline_Slot_Ready || p.quit.load(); });
+        if (p.state[slot].load(std::memory_order_acquire) != Render_Pipeline_Slot_Ready) break; // quit with nothing queued
+
+        Draw_Snapshot& s = p.slots[slot];
+        s.render_begin_ms = profiler_now_ms();
+        if (s.task) {
+            PROFILE_ZONE("render_pipeline task");
+            s.task();
+        } else {
+            PROFILE_ZONE("render_pipeline render");
+            p.render(s);
+        }
+        s.present_ms = profiler_now_ms();
+        s.rendered   = s.task == nullptr;
+        s.task       = nullptr;
+        p.state[slot].store(Render_Pipeline_Slot_Free, std::memory_order_release);
+        pipeline_wake(p);
+        p.render_slot ^= 1;
+    }
+    p.detach();
+}
+#endif
+
+static double interval_overlap(double a0, double a1, double b0, double b1) {
+    const double lo = a0 > b0 ? a0 : b0;
+    const double hi = a1 < b1 ? a1 : b1;
+    return hi > lo ? hi - lo : 0.0;
+}
+
+// Main thread, once a slot is back: folds its render timings into the stats
+static void pipeline_collect(Render_Pipeline& p, Draw_Snapshot& s, double current_build_begin, double now) {
+    if (!s.rendered) return;
+    s.rendered = false;
+    Render_Pipeline_Stats& st = p.stats;
+    ++st.frames;
+    st.render_ms      += s.present_ms - s.render_begin_ms;
+    st.last_latency_ms = s.present_ms - s.frame_begin_ms;
+    st.latency_ms     += st.last_latency_ms;
+    const int count = p.build_count < RENDER_PIPELINE_HISTORY ? p.build_count : RENDER_PIPELINE_HISTORY;
+    for (int i = 0; i < count; ++i)
+        st.overlap_ms += interval_overlap(s.render_begin_ms, s.present_ms, p.build_begin[i], p.build_end[i]);
+    if (current_build_begin > 0.0) // the frame being built right now
+        st.overlap_ms += interval_overlap(s.render_begin_ms, s.present_ms, current_build_begin, now);
+}
+
+// Main thread: waits for the next slot to come back and collects it
+static Draw_Snapshot& pipeline_acquire(Render_Pipeline& p, double current_build_begin) {
+    const int slot = p.main_slot;
+#if RENDER_PIPELINE_THREADS
+    if (p.state[slot].load(std::memory_order_acquire) != Render_Pipeline_Slot_Free) {
+        PROFILE_ZONE("render_pipeline wait");
+        const double start = profiler_now_ms();
+        pipeline_wait(p, [&] { return p.state[slot].load(std::memory_order_acquire) == Render_Pipeline_Slot_Free; });
+        p.stats.main_wait_ms += profiler_now_ms() - start;
+    }
+#endif
+    Draw_Snapshot& s = p.slots[slot];
+    pipeline_collect(p, s, current_build_begin, profiler_now_ms());
+    if (p.handback) p.handback(s);
+    return s;
+}
+
+static void pipeline_publish(Render_Pipeline& p) {
+    p.state[p.main_slot].store(Render_Pipeline_Slot_Ready, std::memory_order_release);
+    p.main_slot ^= 1;
+#if RENDER_PIPELINE_THREADS
+    pipeline_wake(p);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// API
+//-----------------------------------------------------------------------------
+
+bool render_pipeline_start(Render_Pipeline& p) {
+    if (p.running) return true;
+#if RENDER_PIPELINE_THREADS
+    if (!p.attach || !p.detach || !p.render) return false;
+    p.state[0].store(Render_Pipeline_Slot_Free);
+    p.state[1].store(Render_Pipeline_Slot_Free);
+    p.main_slot = p.render_slot = 0;
+    p.quit.store(false);
+    p.attached.store(0);
+    p.thread = std::thread(pipeline_thread, &p);
+    pipeline_wait(p, [&] { return p.attached.load(std::memory_order_acquire) != 0; });
+    if (p.attached.load() < 0) {
+        p.thread.join();
+        fprintf(stderr, "[render_pipeline] the render thread couldn't take the GL context, staying single threaded\n");
+        return false;
+    }
+    p.running = true;
+    return true;
+#else
+    printf("[render_pipeline] no render thread in this build, staying single threaded\n");
+    return false;
+#endif
+}
+
+void render_pipeline_stop(Render_Pipeline& p) {
+    if (!p.running) return;
+#if RENDER_PIPELINE_THREADS
+    for (int i = 0; i < 2; ++i) { // drain, collecting the last frames on the way
+        pipeline_acquire(p, 0.0);
+        p.main_slot ^= 1;
+    }
+    p.quit.store(true);
+    pipeline_wake(p);
+    p.thread.join();
+#endif
+    p.running = false;
+}
+
+void render_pipeline_submit(Render_Pipeline& p, const ImDrawData* dd, double frame_begin_ms, float font_global_scale, int renderer, float render_scale) {
+    PROFILE_ZONE("render_pipeline_submit");
+    Draw_Snapshot& s = pipeline_acquire(p, frame_begin_ms);
+    const double copy_start = profiler_now_ms();
+    draw_snapshot_copy(s, dd);
+    s.font_global_scale = font_global_scale;
+    s.renderer          = renderer;
+    s.render_scale      = render_scale;
+    s.task              = nullptr;
+    s.frame_begin_ms    = frame_begin_ms;
+    s.build_end_ms      = profiler_now_ms();
+    p.stats.copy_ms    += s.build_end_ms - copy_start;
+
+    const int h = p.build_count++ % RENDER_PIPELINE_HISTORY;
+    p.build_begin[h] = frame_begin_ms;
+    p.build_end[h]   = s.build_end_ms;
+    pipeline_publish(p);
+}
+
+void render_pipeline_run(Render_Pipeline& p, void (*task)()) {
+    if (!p.running) {
+        task();
+        return;
+    }
+    PROFILE_ZONE("render_pipeline_run");
+    Draw_Snapshot& s = pipeline_acquire(p, 0.0);
+    s.task = task;
+    const int slot = p.main_slot;
+    pipeline_publish(p);
+#if RENDER_PIPELINE_THREADS
+    pipeline_wait(p, [&] { return p.state[slot].load(std::memory_order_acquire) == Render_Pipeline_Slot_Free; });
+#endif
+}
+
+void render_pipeline_record_single(Render_Pipeline& p, double frame_begin_ms, double present_ms) {
+    Render_Pipeline_Stats& st = p.stats;
+    ++st.single_frames;
+    st.last_single_latency_ms = present_ms - frame_begin_ms;
+    st.single_latency_ms     += st.last_single_latency_ms;
+}
+
+void render_pipeline_free(Render_Pipeline& p) {
+    render_pipeline_stop(p);
+    draw_snapshot_free(p.slots[0]);
+    draw_snapshot_free(p.slots[1]);
+}
+
+void render_pipeline_show_menu(Render_Pipeline& p) {
+#if RENDER_PIPELINE_THREADS
+    ImGui::Checkbox("Render on a second thread", &p.requested);
+#else
+    ImGui::TextDisabled("Render thread:   not in the web build (single threaded)");
+#endif
+    const Render_Pipeline_Stats& st = p.stats;
+    const double single = st.single_frames ? st.single_latency_ms / (double)st.single_frames : 0.0;
+    if (st.frames) {
+        const double frames  = (double)st.frames;
+        const double latency = st.latency_ms / frames;
+        ImGui::Text("Pipelined:       %llu frames, %.0f%% of render time overlapped, copy %.3f ms, render %.3f ms, main waited %.3f ms",
+                    st.frames, st.render_ms > 0.0 ? 100.0 * st.overlap_ms / st.render_ms : 0.0,
+                    st.copy_ms / frames, st.render_ms / frames, st.main_wait_ms / frames);
+        ImGui::Text("Latency:         %.2f ms pipelined (last %.2f), %.2f ms single threaded (%+.2f ms)",
+                    latency, st.last_latency_ms, single, st.single_frames ? latency - single : 0.0);
+    } else if (st.single_frames) {
+        ImGui::Text("Latency:         %.2f ms input to present (last %.2f), single threaded", single, st.last_single_latency_ms);
+    }
+}
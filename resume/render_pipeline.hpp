@@ -0,0 +1,119 @@
+// NOTE(WALKER): Pipelined rendering: the main thread builds frame N+1 while a render thread submits frame N.
+//               After ImGui::Render() the draw data is copied into one of two snapshots (draw lists kept between frames, so a
+//               steady frame only memcpy's the buffers) and handed over. A snapshot is owned by exactly one thread at a time,
+//               the handoff is one atomic store per side (FREE -> READY by the main thread, READY -> FREE by the render
+//               thread), alternating between the two slots. The mutex + condition variable are only there to park a thread
+//               that has nothing to do instead of spinning, no data is ever read under them.
+//
+//               With two slots the main thread is at most one frame ahead: if it finishes frame N+2 while N+1 is still
+//               queued it waits (counted in main_wait_ms), so latency can't pile up behind a slow GPU.
+//               Every GL call has to happen on the thread that owns the context, so the render thread makes it current in
+//               attach() and anything else GL (font texture uploads) goes through render_pipeline_run(), which runs it there
+//               in frame order and waits for it.
+//               Nothing the render thread writes may be read by the main thread while the render thread runs, menus included:
+//               render() leaves what the main thread should see in snapshot.user, and handback() takes it on the main thread
+//               once the slot is back (and puts the next frame's settings in the same way).
+//
+//               Stats: overlap is how much of the render thread's busy time ran while the main thread was building a frame
+//               (0% = no better than single threaded), latency is frame start (input just polled) to present, for both modes.
+//               No threads on the web: Emscripten's GLFW creates the WebGL context on the browser thread and can't hand it to a
+//               pthread (that needs an OffscreenCanvas owned by the render thread from the start), so start() fails there and
+//               the caller stays single threaded.
+
+#pragma once
+
+#include "imgui.h"
+#include <atomic>
+
+#if !defined(__EMSCRIPTEN__)
+#define RENDER_PIPELINE_THREADS 1
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+struct Draw_Snapshot {
+    ImDrawData            draw_data;              // CmdLists point at lists
+    ImVector<ImDrawList*> lists;                  // owned, reused from frame to frame
+    float                 font_global_scale = 1.0f; // io.FontGlobalScale when the frame was built, the render thread can't read io
+    int                   renderer = 0;           // the main thread's pick of backend for this frame, up to the caller
+    float                 render_scale = 1.0f;    // fraction of the framebuffer to draw at, up to the caller
+    void                (*task)() = nullptr;      // render_pipeline_run(): run this instead of rendering a frame
+    void*                 user = nullptr;         // the caller's, travels with the slot (render() and handback())
+
+    // Timings (profiler_now_ms()), the frame ones written by the main thread, the render ones handed back with the slot
+    double                frame_begin_ms  = 0.0;
+    double                build_end_ms    = 0.0;
+    double                render_begin_ms = 0.0;
+    double                present_ms      = 0.0;
+    bool                  rendered        = false; // has render timings the main thread hasn't collected yet
+};
+
+struct Render_Pipeline_Stats {
+    unsigned long long frames          = 0;   // pipelined frames presented
+    unsigned long long single_frames   = 0;   // single threaded frames (render_pipeline_record_single())
+    double             copy_ms         = 0.0; // totals
+    double             render_ms       = 0.0;
+    double             overlap_ms      = 0.0; // render time that ran during a main thread build
+    double             main_wait_ms    = 0.0; // main thread blocked on both slots being busy
+    double             latency_ms      = 0.0;
+    double             single_latency_ms = 0.0;
+    double             last_latency_ms = 0.0;
+    double             last_single_latency_ms = 0.0;
+};
+
+constexpr int RENDER_PIPELINE_HISTORY = 8; // main thread build intervals kept to intersect with render intervals
+
+enum Render_Pipeline_Slot : int {
+    Render_Pipeline_Slot_Free  = 0, // owned by the main thread
+    Render_Pipeline_Slot_Ready = 1, // owned by the render thread
+};
+
+struct Render_Pipeline {
+    bool   requested = false; // the menu checkbox, applied by the caller at the start of a frame
+    bool   running   = false; // a render thread owns the context
+
+    // Hooks, attach()/detach() run on the render thread (make the context current there / release it), render() draws one
+    // snapshot and presents
+    bool (*attach)() = nullptr;
+    void (*detach)() = nullptr;
+    void (*render)(Draw_Snapshot& snapshot) = nullptr;
+    // Optional, main thread: a slot came back from the render thread (or is about to be filled for the first time)
+    void (*handback)(Draw_Snapshot& snapshot) = nullptr;
+
+    Draw_Snapshot    slots[2];
+    std::atomic<int> state[2] = {};
+    int              main_slot   = 0;
+    int              render_slot = 0;
+    double           build_begin[RENDER_PIPELINE_HISTORY] = {};
+    double           build_end[RENDER_PIPELINE_HISTORY]   = {};
+    int              build_count = 0;
+    Render_Pipeline_Stats stats;
+#if RENDER_PIPELINE_THREADS
+    std::thread             thread;
+    std::atomic<bool>       quit{false};
+    std::atomic<int>        attached{0}; // 0 waiting, 1 ok, -1 attach() failed
+    std::mutex              park_mutex;
+    std::condition_variable park;
+#endif
+};
+
+// Starts the render thread. The caller releases the context on this thread first; false means attach() failed or there are
+// no threads, the caller takes the context back and keeps rendering itself.
+bool render_pipeline_start(Render_Pipeline& pipeline);
+// Waits for every submitted frame, stops the thread (detach() releases the context), collects the last timings
+void render_pipeline_stop(Render_Pipeline& pipeline);
+
+// Copies the draw data into the next slot and hands it to the render thread, frame_begin_ms is when input was polled
+void render_pipeline_submit(Render_Pipeline& pipeline, const ImDrawData* draw_data, double frame_begin_ms, float font_global_scale, int renderer,
+                            float render_scale);
+// Runs task on the render thread after every frame submitted so far, and waits for it
+void render_pipeline_run(Render_Pipeline& pipeline, void (*task)());
+
+// Single threaded frames, for the latency comparison
+void render_pipeline_record_single(Render_Pipeline& pipeline, double frame_begin_ms, double present_ms);
+
+void render_pipeline_free(Render_Pipeline& pipeline);
+
+// For the "Performance" menu, the checkbox sets pipeline.requested
+void render_pipeline_show_menu(Render_Pipeline& pipeline);
@@ -0,0 +1,145 @@
+#include "render_scale.hpp"
+
+#include "imgui.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+Render_Scale render_scale;
+
+static void render_scale_set(Render_Scale& rs, float to, double now_ms, const char* reason) {
+    Render_Scale_Decision& d = rs.history[rs.history_count++ % RENDER_SCALE_HISTORY];
+    d.time_ms  = now_ms;
+    d.from     = rs.scale;
+    d.to       = to;
+    d.frame_ms = rs.smoothed_ms;
+    d.reason   = reason;
+    if (rs.log)
+        printf("[render_scale] %.3f -> %.3f (%s, %.1f ms frames, %.1f ms budget)\n", rs.scale, to, reason, rs.smoothed_ms, rs.budget_ms);
+    rs.scale        = to;
+    rs.smoothed_ms  = 0.0; // the old samples were measured at the old scale
+    rs.over_streak  = 0;
+    rs.under_streak = 0;
+}
+
+void render_scale_reset(Render_Scale& rs) {
+    rs.smoothed_ms        = 0.0;
+    rs.over_streak        = 0;
+    rs.under_streak       = 0;
+    rs.probe_frames       = rs.base_probe_frames;
+    rs.frames_since_raise = -1;
+    rs.window_count       = 0;
+    rs.drop_from_ms       = 0.0;
+}
+
+static int render_scale_compare_floats(const void* a, const void* b) {
+    const float x = *(const float*)a, y = *(const float*)b;
+    return x < y ? -1 : x > y ? 1 : 0;
+}
+
+static void render_scale_set_refresh(Render_Scale& rs, double refresh_ms) {
+    rs.refresh_ms = refresh_ms > 1000.0 / 60.0 ? refresh_ms : 1000.0 / 60.0;
+    rs.budget_ms  = rs.refresh_ms * rs.budget_factor;
+}
+
+// Every RENDER_SCALE_WINDOW samples. Only ever lowers the refresh interval: frames late for vsync push a window's percentile
+// up, never below the real refresh.
+static void render_scale_measure_refresh(Render_Scale& rs, double interval) {
+    rs.window[rs.window_count++] = (float)interval;
+    if (rs.window_count < RENDER_SCALE_WINDOW) return;
+    rs.window_count = 0;
+    qsort(rs.window, RENDER_SCALE_WINDOW, sizeof(float), render_scale_compare_floats);
+    const double refresh = rs.window[(int)(rs.refresh_percentile * (float)(RENDER_SCALE_WINDOW - 1))];
+    if (refresh < rs.refresh_ms) render_scale_set_refresh(rs, refresh);
+}
+
+float render_scale_frame(Render_Scale& rs, double frame_begin_ms, bool follows_previous, float device_pixel_ratio) {
+    const double interval = frame_begin_ms - rs.last_frame_ms;
+    const bool   sample   = follows_previous && rs.last_frame_ms > 0.0 && interval < 250.0; // longer is the page stalling, not us
+    rs.last_frame_ms = frame_begin_ms;
+
+    rs.floor = device_pixel_ratio > 1.0f ? 1.0f / device_pixel_ratio : 1.0f;
+    if (rs.floor < rs.min_scale) rs.floor = rs.min_scale;
+    if (!rs.available || !rs.enabled) {
+        if (rs.scale != 1.0f) render_scale_set(rs, 1.0f, frame_begin_ms, rs.enabled ? "unavailable" : "disabled");
+        return rs.scale;
+    }
+    if (rs.scale < rs.floor) render_scale_set(rs, rs.floor, frame_begin_ms, "floor raised"); // DPR went down
+    if (!sample) return rs.scale;
+
+    ++rs.samples;
+    rs.smoothed_ms = rs.smoothed_ms == 0.0 ? interval : rs.smoothed_ms + 0.1 * (interval - rs.smoothed_ms);
+    if (rs.frames_since_raise >= 0) ++rs.frames_since_raise;
+    render_scale_measure_refresh(rs, interval);
+
+    if (rs.smoothed_ms > rs.budget_ms) {
+        rs.under_streak = 0;
+        if (++rs.over_streak < rs.over_frames) return rs.scale;
+        const bool shortened = rs.smoothed_ms < rs.drop_from_ms * (1.0 - rs.drop_gain);
+        if (rs.drop_from_ms > 0.0 && shortened) {
+            rs.drop_from_ms    = rs.smoothed_ms; // a lower vsync multiple, the next steps are judged from here
+            rs.drop_from_scale = rs.scale;
+        } else if (rs.drop_from_ms > 0.0 && rs.scale <= rs.floor && rs.drop_from_scale > rs.scale) {
+            // NOTE(WALKER): Down to the floor, same interval: it's the refresh (or a throttle) we're waiting on, not the drawing
+            ++rs.futile;
+            render_scale_set_refresh(rs, rs.smoothed_ms);
+            rs.drop_from_ms = 0.0;
+            render_scale_set(rs, rs.drop_from_scale, frame_begin_ms, "steps down didn't help");
+            return rs.scale;
+        }
+        if (rs.scale <= rs.floor) return rs.scale;
+        float to = rs.scale - rs.step;
+        if (to < rs.floor) to = rs.floor;
+        const bool revert = rs.frames_since_raise >= 0 && rs.frames_since_raise < rs.base_probe_frames;
+        if (revert) {
+            ++rs.reverts;
+            rs.probe_frames = rs.probe_frames * 2 < rs.max_probe_frames ? rs.probe_frames * 2 : rs.max_probe_frames;
+        }
+        ++rs.drops;
+        rs.frames_since_raise = -1;
+        if (rs.drop_from_ms == 0.0) {
+            rs.drop_from_ms    = rs.smoothed_ms;
+            rs.drop_from_scale = rs.scale;
+        }
+        render_scale_set(rs, to, frame_begin_ms, revert ? "step up reverted" : "over budget");
+    } else {
+        rs.over_streak = 0;
+        if (++rs.under_streak < rs.probe_frames || rs.scale >= 1.0f) return rs.scale;
+        float to = rs.scale + rs.step;
+        if (to > 1.0f) to = 1.0f;
+        ++rs.raises;
+        rs.frames_since_raise = 0;
+        rs.drop_from_ms       = 0.0;
+        render_scale_set(rs, to, frame_begin_ms, "probing headroom");
+    }
+    return rs.scale;
+}
+
+//-----------------------------------------------------------------------------
+// Menu
+//-----------------------------------------------------------------------------
+
+// NOTE(WALKER): Shown in the menu bar "Performance" menu
+void render_scale_show_menu(Render_Scale& rs) {
+    if (!rs.available) {
+        ImGui::TextDisabled("Render scale:    full resolution only (needs GL 3.0 / WebGL2)");
+        return;
+    }
+    if (ImGui::Checkbox("Dynamic render resolution", &rs.enabled))
+        render_scale_reset(rs);
+    ImGui::SetItemTooltip("Draw at a lower resolution and upscale while frames take longer than the budget");
+    if (ImGui::SliderFloat("Frame budget (x refresh)", &rs.budget_factor, 1.02f, 2.0f, "%.2f"))
+        render_scale_set_refresh(rs, rs.refresh_ms);
+    const ImGuiIO& io = ImGui::GetIO();
+    ImGui::Text("Render scale:    %.3f (floor %.3f), drawing %.0fx%.0f of %.0fx%.0f", rs.scale, rs.floor,
+                io.DisplaySize.x * io.DisplayFramebufferScale.x * rs.scale, io.DisplaySize.y * io.DisplayFramebufferScale.y * rs.scale,
+                io.DisplaySize.x * io.DisplayFramebufferScale.x, io.DisplaySize.y * io.DisplayFramebufferScale.y);
+    ImGui::Text("Frame interval:  %.2f ms smoothed over %llu samples, next probe after %d frames on budget",
+                rs.smoothed_ms, rs.samples, rs.probe_frames);
+    ImGui::Text("Refresh:         %.2f ms (%.1f Hz), budget %.2f ms", rs.refresh_ms, 1000.0 / rs.refresh_ms, rs.budget_ms);
+    ImGui::Text("Decisions:       %llu down (%llu reverted step ups, %llu undone as futile), %llu up", rs.drops, rs.reverts, rs.futile, rs.raises);
+    const int count = rs.history_count < RENDER_SCALE_HISTORY ? rs.history_count : RENDER_SCALE_HISTORY;
+    for (int i = 0; i < count; ++i) {
+        const Render_Scale_Decision& d = rs.history[(rs.history_count - 1 - i) % RENDER_SCALE_HISTORY];
+        ImGui::TextDisabled("  %8.1f s  %.3f -> %.3f  %s (%.1f ms)", d.time_ms / 1000.0, d.from, d.to, d.reason, d.frame_ms);
+    }
+}
@@ -0,0 +1,91 @@
+// NOTE(WALKER): Dynamic render resolution.
+//               The canvas backing store is its CSS size * devicePixelRatio, so a DPR 3 phone or a 4K laptop clears and fills
+//               8+ megapixels every frame. When frames come in slower than the budget, the UI is drawn into a smaller offscreen
+//               target and stretched over the window (render_scale_target.hpp). This is the controller that picks the scale,
+//               it has no GL in it so the headless build can feed it synthetic intervals (--render-scale-check).
+//
+//               The signal is the interval between back-to-back rendered frames: the browser (or a vsynced swap natively)
+//               holds the next frame back while the GPU is behind, so overload shows up there whether the cost is ours or the
+//               compositor's. Intervals across a skipped frame (frame_pacer.hpp) are gaps, not samples.
+//               Over budget for a while -> one step down. Vsync hides headroom (a frame never comes in under the refresh
+//               interval), so going back up is a probe: after probe_frames on budget, one step up. A step up that goes over
+//               budget again right away was wrong, it is reverted and the next probe waits twice as long.
+//
+//               The budget is budget_factor times the display's refresh interval, which steady intervals alone can't tell
+//               from steady overload (33 ms is a 30 Hz throttle or a 60 Hz screen dropping every other frame). It starts at
+//               60 Hz and is learned from what the scale does. Vsync rounds intervals up to whole refreshes, so a step down
+//               can save real time and still land on the same multiple: steps down are only judged once they reach the floor.
+//               When one lands on a lower multiple they worked, and the steps after it are judged from there. When the run
+//               got to the floor without shortening the interval, the wait is the display's (a 50 Hz screen,
+//               requestAnimationFrame throttled to 30 Hz by iOS Low Power Mode), the run is undone and that interval becomes
+//               the refresh one. It comes back down when a window of intervals shows a faster refresh again (the throttle
+//               lifted), but never under 60 Hz: more frames aren't worth fewer pixels.
+//
+//               Text: the scale never goes below 1/devicePixelRatio, so there are never fewer pixels than CSS pixels (the same
+//               sharpness as a DPR 1 screen), and the SDF ramp is computed for the smaller target so glyph edges stay
+//               anti-aliased instead of aliasing before the upscale.
+
+#pragma once
+
+constexpr int RENDER_SCALE_HISTORY = 8;  // decisions kept for the menu
+constexpr int RENDER_SCALE_WINDOW  = 64; // intervals per refresh estimate
+
+struct Render_Scale_Decision {
+    double time_ms  = 0.0;
+    float  from     = 1.0f;
+    float  to       = 1.0f;
+    double frame_ms = 0.0; // smoothed interval when it was made
+    const char* reason = "";
+};
+
+struct Render_Scale {
+    bool   available    = false; // the GL side can render offscreen (render_scale_init())
+    bool   enabled      = true;
+    bool   log          = true;  // print every decision
+    float  scale        = 1.0f;  // fraction of the framebuffer (per axis) the next frame is drawn at
+    float  min_scale    = 0.5f;  // floor before the 1/devicePixelRatio one
+    float  step         = 0.125f;
+    float  budget_factor = 1.1f; // smoothed intervals over this times the refresh interval mean frames are being dropped
+    float  refresh_percentile = 0.25f; // of a window of intervals, under the median so a half dropped window still finds vsync
+    float  drop_gain    = 0.05f; // a step down has to shorten the interval by this fraction to count as working
+    int    over_frames  = 10;    // frames over budget before stepping down
+    int    base_probe_frames = 120;
+    int    max_probe_frames  = 1920;
+
+    // Controller state
+    double last_frame_ms  = 0.0;
+    double smoothed_ms    = 0.0; // exponential average of back-to-back intervals, 0 = no sample since the last change
+    int    over_streak    = 0;
+    int    under_streak   = 0;
+    int    probe_frames   = 120;
+    int    frames_since_raise = -1; // -1 when the last step was down (or there was none)
+    float  floor          = 0.5f; // max(min_scale, 1/devicePixelRatio), from the last render_scale_frame()
+    double refresh_ms     = 1000.0 / 60.0; // display refresh interval, kept across resets (it's the display's, not the pixels')
+    double budget_ms      = 1000.0 / 60.0 * 1.1; // refresh_ms * budget_factor
+    float  window[RENDER_SCALE_WINDOW];
+    int    window_count   = 0;
+    double drop_from_ms   = 0.0;  // smoothed interval before the steps down in a row that didn't shorten it yet, 0 after a step up
+    float  drop_from_scale = 1.0f;
+
+    // Stats
+    unsigned long long samples = 0;
+    unsigned long long drops   = 0;
+    unsigned long long raises  = 0;
+    unsigned long long reverts = 0; // drops that undid the step up right before them
+    unsigned long long futile  = 0; // runs of steps down undone because the interval didn't get shorter
+    Render_Scale_Decision history[RENDER_SCALE_HISTORY];
+    int    history_count = 0;
+};
+
+extern Render_Scale render_scale; // the app's (resume.cpp), main thread
+
+// Forget what was measured, after a resize (a different amount of pixels) or toggling the controller
+void render_scale_reset(Render_Scale& rs);
+
+// NOTE(WALKER): Once per rendered frame on the main thread, before the frame is drawn. frame_begin_ms is profiler_now_ms() at
+//               the start of the frame, follows_previous is false when the frame pacer skipped iterations since the last one.
+//               Returns the scale to draw this frame at.
+float render_scale_frame(Render_Scale& rs, double frame_begin_ms, bool follows_previous, float device_pixel_ratio);
+
+// Settings, refresh estimate and the last decisions for the "Performance" menu
+void render_scale_show_menu(Render_Scale& rs);
@@ -0,0 +1,136 @@
+// NOTE(WALKER): The GL side of dynamic render resolution (render_scale.hpp): below full scale the UI is drawn into a smaller
+//               offscreen target (draw_data->FramebufferScale shrunk, so the backends' viewport, projection and scissors
+//               follow) and stretched over the window with one linear glBlitFramebuffer(). Layout, fonts and input don't change
+//               at all. Needs glBlitFramebuffer() (GL 3.0 / WebGL2), the WebGL1 build gets the stubs at the bottom and stays at
+//               full resolution.
+
+#pragma once
+
+#include "imgui.h"
+#include "render_scale.hpp"
+#include "profiler.hpp"
+#include <stdio.h>
+
+// NOTE(WALKER): The offscreen target as the main thread last saw it, filled after each frame by whichever thread renders and
+//               copied over by resume.cpp (Render_Report): the target itself is the render thread's
+struct Render_Scale_Report {
+    bool failed = false; // the target couldn't be made, render_scale_collect_report() turns the controller off
+    int  width  = 0;     // 0 = no target
+    int  height = 0;
+};
+
+static Render_Scale_Report render_scale_report; // main thread
+
+static void render_scale_collect_report(const Render_Scale_Report& report) {
+    render_scale_report = report;
+    if (report.failed) render_scale.available = false;
+}
+
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+
+#if defined(IMGUI_IMPL_OPENGL_ES3)
+#include <GLES3/gl3.h>
+#else
+#ifndef GL_GLEXT_PROTOTYPES
+#define GL_GLEXT_PROTOTYPES
+#endif
+#include <GL/gl.h>
+#include <GL/glext.h>
+#endif
+
+// Offscreen target, only touched by the thread that owns the GL context (render_pipeline.hpp)
+struct Render_Scale_Target {
+    GLuint framebuffer  = 0;
+    GLuint color        = 0; // renderbuffer, only ever blitted from
+    int    width        = 0;
+    int    height       = 0;
+    int    full_width   = 0; // the window framebuffer of the frame being drawn
+    int    full_height  = 0;
+    ImVec2 full_scale;       // draw_data->FramebufferScale before render_scale_target_begin() shrunk it
+    bool   failed       = false; // incomplete, full resolution from now on (the main thread hears of it with the next report)
+};
+
+static Render_Scale_Target render_scale_target;
+
+// Main thread, before any frame
+static bool render_scale_init() {
+    render_scale.available = true;
+    return true;
+}
+
+static void render_scale_shutdown() {
+    auto& t = render_scale_target;
+    if (t.framebuffer) glDeleteFramebuffers(1, &t.framebuffer);
+    if (t.color)       glDeleteRenderbuffers(1, &t.color);
+    t = Render_Scale_Target();
+}
+
+// Binds the offscreen target for a frame drawn at scale and shrinks draw_data->FramebufferScale to match.
+// False (and nothing changed) at full scale, the frame is drawn straight to the window as before.
+static bool render_scale_target_begin(ImDrawData* draw_data, float scale) {
+    auto& t = render_scale_target;
+    const int full_width  = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+    const int full_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+    int width  = (int)((float)full_width  * scale + 0.5f);
+    int height = (int)((float)full_height * scale + 0.5f);
+    if (width < 1) width = 1;
+    if (height < 1) height = 1;
+    if (t.failed || scale >= 1.0f || full_width <= 0 || full_height <= 0 || (width == full_width && height == full_height)) return false;
+
+    if (!t.framebuffer) {
+        glGenFramebuffers(1, &t.framebuffer);
+        glGenRenderbuffers(1, &t.color);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, t.framebuffer);
+    if (width != t.width || height != t.height) { // only on a decision or a resize
+        glBindRenderbuffer(GL_RENDERBUFFER, t.color);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, t.color);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        t.width  = width;
+        t.height = height;
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            fprintf(stderr, "[render_scale] offscreen target %dx%d incomplete, staying at full resolution\n", width, height);
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            render_scale_shutdown();
+            render_scale_target.failed = true;
+            return false;
+        }
+    }
+    t.full_width  = full_width;
+    t.full_height = full_height;
+    t.full_scale  = draw_data->FramebufferScale;
+    draw_data->FramebufferScale = ImVec2(t.full_scale.x * (float)width / (float)full_width, t.full_scale.y * (float)height / (float)full_height);
+    return true;
+}
+
+// Stretches the offscreen target over the window and puts draw_data->FramebufferScale back
+static void render_scale_target_present(ImDrawData* draw_data) {
+    auto& t = render_scale_target;
+    PROFILE_ZONE("render_scale upscale");
+    glDisable(GL_SCISSOR_TEST); // blits are scissored
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, t.framebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, t.width, t.height, 0, 0, t.full_width, t.full_height, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    draw_data->FramebufferScale = t.full_scale;
+}
+
+// On the thread that renders, after the frame
+static void render_scale_fill_report(Render_Scale_Report& out) {
+    const auto& t = render_scale_target;
+    out.failed = t.failed;
+    out.width  = t.framebuffer ? t.width : 0;
+    out.height = t.framebuffer ? t.height : 0;
+}
+
+#else
+
+// NOTE(WALKER): WebGL1 / ES2 build, no glBlitFramebuffer(): always full resolution
+static bool render_scale_init() { return false; }
+static void render_scale_shutdown() {}
+static bool render_scale_target_begin(ImDrawData*, float) { return false; }
+static void render_scale_target_present(ImDrawData*) {}
+static void render_scale_fill_report(Render_Scale_Report&) {}
+
+#endif
@@ -7,18 +7,32 @@
 #include "imgui_freetype.h"
 #include <stdio.h>
 #define GL_SILENCE_DEPRECATION
+#define GL_GLEXT_PROTOTYPES // NOTE(WALKER): Shader entry points for our own GL code on native (sdf_text_shader.hpp, glyph_renderer.hpp)
 #if defined(IMGUI_IMPL_OPENGL_ES2)
 #include <GLES2/gl2.h>
+#elif defined(IMGUI_IMPL_OPENGL_ES3)
+#include <GLES3/gl3.h>
 #endif
 #include <GLFW/glfw3.h> // Will drag system OpenGL headers
 
+#ifdef __EMSCRIPTEN__
 #include <emscripten.h>
+#endif
 
 #include "../Utilities/defer.hpp" // NOTE(WALKER): Custom defer macro used to make code sleaker and more readable when using imgui (especially begin()/end() pairs)
+#include "frame_pacer.hpp"
+#include "allocator.hpp"
+#include "fonts.hpp"
+#include "sdf_text_shader.hpp"
+#include "glyph_renderer.hpp"
+#include "render_scale_target.hpp"
+#include "damage_target.hpp"
+#include "memory_panel.hpp"
+#include "render_pipeline.hpp"
+#include "resume_ui.hpp"
+#include "profiler.hpp"
 
-// NOTE(WALKER): This is a nice hack to get wrapped bullet text, not low level or deep, but it works well enough
-#define IMGUI_BULLETTEXTWRAPPED(fmt_str, ...) ImGui::BulletText(""); ImGui::SameLine(); ImGui::TextWrapped(fmt_str, ##__VA_ARGS__)
-
+#ifdef __EMSCRIPTEN__
 // NOTE(WALKER): For getting the canvas width/height in order to make a window
 EM_JS(int, get_canvas_width, (), {
     return Module.canvas.width;
@@ -26,26 +40,305 @@ EM_JS(int, get_canvas_width, (), {
 EM_JS(int, get_canvas_height, (), {
     return Module.canvas.height;
 });
-// NOTE(WALKER): Called at the beginning to set canvas dimensions to the dimensions of the user's monitor
-// credit: https://stackoverflow.com/questions/16277383/javascript-screen-height-and-screen-width-returns-incorrect-values
-EM_JS(void, resize_canvas_to_screen_dimensions, (), {
-    var w = screen.width; var h = screen.height;
-    var DPR = window.devicePixelRatio;
-    w = Math.round(DPR * w);
-    h = Math.round(DPR * h);
-    if (w < h) {
-        var temp = w;
-        w = h;
-        h = temp;
-    }
-    Module.canvas.width  = w;
-    Module.canvas.height = h;
+// NOTE(WALKER): The canvas backing store is its CSS box (the whole page, see resume_shell.html) times devicePixelRatio,
+//               so the browser never stretches it and text stays the size we drew it at, on any monitor.
+EM_JS(void, get_canvas_display_size, (int* w, int* h), {
+    var DPR = window.devicePixelRatio || 1;
+    var rect = Module.canvas.getBoundingClientRect();
+    HEAP32[w >> 2] = Math.max(1, Math.round(rect.width  * DPR));
+    HEAP32[h >> 2] = Math.max(1, Math.round(rect.height * DPR));
+});
+EM_JS(float, get_device_pixel_ratio, (), {
+    return window.devicePixelRatio || 1;
+});
+EM_JS(void, resize_canvas_to_display_size, (), {
+    var DPR = window.devicePixelRatio || 1;
+    var rect = Module.canvas.getBoundingClientRect();
+    Module.canvas.width  = Math.max(1, Math.round(rect.width  * DPR));
+    Module.canvas.height = Math.max(1, Math.round(rect.height * DPR));
+});
+// NOTE(WALKER): A devicePixelRatio change (window dragged to another monitor, browser zoom) doesn't fire "resize" in every
+//               browser, a resolution media query does. It re-dispatches a "resize" so one callback handles both.
+EM_JS(void, install_device_pixel_ratio_listener, (), {
+    var listen = function() {
+        var query = matchMedia("(resolution: " + window.devicePixelRatio + "dppx)");
+        query.addEventListener("change", function() { window.dispatchEvent(new Event("resize")); listen(); }, { once: true });
+    };
+    listen();
 });
 // NOTE(WALKER): This is so we can click on links we want to embed into the UI
 EM_JS(void, open_link, (const char* str), {
     let link = UTF8ToString(str);
     window.open(link, "_blank");
 });
+// NOTE(WALKER): Time to first frame, from navigation start (includes downloading and compiling resume.wasm)
+EM_JS(double, time_since_page_start_ms, (), {
+    return performance.now();
+});
+// NOTE(WALKER): Removes the static HTML rendition the shell page shows while we load (tools/content_html.cpp), returns when
+//               it was first painted (0 if there was none: STATIC_SHELL=0 or it never painted)
+EM_JS(double, static_content_swap, (), {
+    let content = document.getElementById("static-resume");
+    if (content) content.remove();
+    return typeof resume_static_content_ms === "number" ? resume_static_content_ms : 0;
+});
+#else
+// NOTE(WALKER): Native stand-ins for the EM_JS hooks above so the same main() runs in a desktop GLFW window
+static int  native_canvas_width  = 1920;
+static int  native_canvas_height = 1080;
+static int  get_canvas_width()  { return native_canvas_width; }
+static int  get_canvas_height() { return native_canvas_height; }
+static void resize_canvas_to_display_size() {
+    if (const GLFWvidmode* mode = glfwGetVideoMode(glfwGetPrimaryMonitor())) {
+        native_canvas_width  = mode->width;
+        native_canvas_height = mode->height;
+    }
+}
+static void open_link(const char* str) { printf("open link: %s\n", str); }
+static float get_device_pixel_ratio() {
+    float x = 1.0f, y = 1.0f;
+    if (GLFWmonitor* monitor = glfwGetPrimaryMonitor()) glfwGetMonitorContentScale(monitor, &x, &y);
+    return x;
+}
+static double time_since_page_start_ms() { return glfwGetTime() * 1000.0; }
+static double static_content_swap() { return 0.0; }
+#endif
+
+static double first_frame_ms    = 0.0;
+static double static_content_ms = 0.0; // first paint of the shell page's static rendition, 0 without one
+
+//-----------------------------------------------------------------------------
+// Display size
+//-----------------------------------------------------------------------------
+
+// NOTE(WALKER): Text is 13px per 960 framebuffer pixels of the long side. The long side so a phone held upright still gets
+//               readable text (what the old landscape canvas swap was for), and framebuffer pixels so a DPI change keeps
+//               the same physical size.
+static float font_display_size(int fb_width, int fb_height) {
+    return 13.0f * (float)(fb_width > fb_height ? fb_width : fb_height) / 960.0f;
+}
+
+struct Display_State {
+    bool dirty   = false; // a resize/DPI event came in since the last frame
+    int  width   = 0;     // framebuffer size the fonts were last sized for
+    int  height  = 0;
+    int  changes = 0;
+};
+static Display_State display;
+
+static void display_mark_dirty() {
+    display.dirty = true;
+    frame_pacer_wake();
+}
+
+#ifdef __EMSCRIPTEN__
+static EM_BOOL display_resize_callback(int, const EmscriptenUiEvent*, void*) {
+    display_mark_dirty();
+    return EM_FALSE;
+}
+#else
+// NOTE(WALKER): Installed before frame_pacer_install(), which chains to it
+static void display_framebuffer_size_callback(GLFWwindow*, int, int) { display_mark_dirty(); }
+static void display_content_scale_callback(GLFWwindow*, float, float) { display_mark_dirty(); }
+#endif
+
+static void display_install(GLFWwindow* window) {
+#ifdef __EMSCRIPTEN__
+    (void)window;
+    emscripten_set_resize_callback(EMSCRIPTEN_EVENT_TARGET_WINDOW, nullptr, EM_FALSE, display_resize_callback); // also orientation changes
+    install_device_pixel_ratio_listener();
+#else
+    glfwSetFramebufferSizeCallback(window, display_framebuffer_size_callback);
+    glfwSetWindowContentScaleCallback(window, display_content_scale_callback);
+#endif
+    glfwGetFramebufferSize(window, &display.width, &display.height);
+}
+
+//-----------------------------------------------------------------------------
+// Rendering
+//-----------------------------------------------------------------------------
+
+// NOTE(WALKER): Either this thread renders (single threaded), or render_pipeline owns the GL context on its own thread and
+//               everything GL below runs there: frames through render_snapshot(), other GL work through render_pipeline_run().
+static Render_Pipeline render_pipeline;
+static GLFWwindow*     main_window = nullptr;
+static ImVec4          clear_color = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
+
+enum Renderer_Kind { Renderer_Stock, Renderer_Instanced };
+
+static void render_draw_data(ImDrawData* draw_data, float font_global_scale, int renderer, float scale, const Damage_Settings& damage) {
+    const bool offscreen = render_scale_target_begin(draw_data, scale); // NOTE(WALKER): Below full resolution (render_scale_target.hpp)
+    if (offscreen) font_global_scale *= scale; // the SDF ramp is one pixel of the smaller target wide
+    const int fb_width  = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+    const int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+    glViewport(0, 0, fb_width, fb_height);
+    bool partial = false; // NOTE(WALKER): Only the damage redrawn, into the target that kept the last frame (damage_target.hpp)
+    if (offscreen) damage_invalidate(damage_tracker, "drawn below full resolution");
+    else           partial = damage_target_begin(draw_data, renderer, clear_color, damage);
+    if (!partial) {
+        glClearColor(clear_color.x * clear_color.w, clear_color.y * clear_color.w, clear_color.z * clear_color.w, clear_color.w);
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+    if (renderer == Renderer_Instanced) {
+        glyph_renderer_render(draw_data, font_global_scale);
+    } else {
+        sdf_text_shader_patch(draw_data, font_global_scale); // NOTE(WALKER): The instanced renderer does SDF in its own shader
+        ImGui_ImplOpenGL3_RenderDrawData(draw_data);
+    }
+    if (partial)
+        damage_target_present(draw_data);
+    if (offscreen)
+        render_scale_target_present(draw_data);
+}
+
+static bool render_thread_attach() {
+    glfwMakeContextCurrent(main_window);
+    if (glfwGetCurrentContext() != main_window) return false;
+    glfwSwapInterval(1);
+    ImGui_ImplOpenGL3_NewFrame(); // creates the backend's device objects if they aren't yet, the main thread no longer calls it
+    return true;
+}
+static void render_thread_detach() { glfwMakeContextCurrent(nullptr); }
+
+// NOTE(WALKER): What travels with a frame besides the draw data: the main thread's settings down to the GL side, and what
+//               the GL side has to tell the main thread back up (stats and sizes for the menus, a render target that failed).
+//               Pipelined, it rides in the snapshot (Draw_Snapshot::user): settings put in and the report collected when the
+//               main thread gets the slot back, so neither thread reads what the other is writing.
+struct Render_Handoff {
+    Damage_Settings       damage;
+    bool                  filled = false; // the report below is from a frame the main thread hasn't collected
+    Glyph_Renderer_Report glyph;
+    Render_Scale_Report   scale;
+    Damage_Target_Report  damage_target;
+};
+
+static Render_Handoff render_handoffs[2]; // one per pipeline slot
+
+static void render_handoff_fill(Render_Handoff& h) {
+    glyph_renderer_fill_report(h.glyph);
+    render_scale_fill_report(h.scale);
+    damage_target_fill_report(h.damage_target);
+    h.filled = true;
+}
+
+static void render_handoff_collect(Render_Handoff& h) {
+    h.damage = damage_settings; // for the frame about to be put in this slot
+    if (!h.filled) return; // a task ran in that slot, or nothing yet
+    glyph_renderer_report = h.glyph;
+    render_scale_collect_report(h.scale);
+    damage_target_report = h.damage_target;
+    h.filled = false;
+}
+
+static void render_snapshot(Draw_Snapshot& snapshot) {
+    Render_Handoff& h = *(Render_Handoff*)snapshot.user;
+    render_draw_data(&snapshot.draw_data, snapshot.font_global_scale, snapshot.renderer, snapshot.render_scale, h.damage);
+    render_handoff_fill(h);
+    PROFILE_ZONE("glfwSwapBuffers");
+    glfwSwapBuffers(main_window);
+}
+
+static void render_snapshot_handback(Draw_Snapshot& snapshot) { render_handoff_collect(*(Render_Handoff*)snapshot.user); }
+
+// Applies the "Render on a second thread" checkbox, at the start of a frame
+static void render_pipeline_update() {
+    auto& p = render_pipeline;
+    if (p.requested == p.running) return;
+    if (p.requested) {
+        glfwMakeContextCurrent(nullptr); // the render thread takes it
+        if (!render_pipeline_start(p)) {
+            glfwMakeContextCurrent(main_window);
+            p.requested = false;
+        }
+    } else {
+        render_pipeline_stop(p);
+        glfwMakeContextCurrent(main_window);
+    }
+}
+
+// NOTE(WALKER): The font texture is GL_R8 while the instanced renderer draws and the menu asks for it, RGBA32 otherwise
+//               (memory_panel.hpp). Decided on the main thread, before the upload task is handed to the GL thread.
+static bool fonts_texture_alpha8_wanted = false;
+
+static void fonts_reupload_texture_now() {
+    glyph_renderer_atlas_reset();
+    ImGui_ImplOpenGL3_DestroyFontsTexture();
+    ImGui_ImplOpenGL3_CreateFontsTexture();
+    memory_panel.atlas_alpha8 = fonts_texture_alpha8_wanted && glyph_renderer_atlas_to_alpha8(ImGui::GetIO().Fonts);
+    damage_invalidate(damage_tracker, "font texture changed");
+}
+static void fonts_texture_to_alpha8_now() {
+    memory_panel.atlas_alpha8 = glyph_renderer_atlas_to_alpha8(ImGui::GetIO().Fonts);
+    if (memory_panel.atlas_alpha8) damage_invalidate(damage_tracker, "font texture changed");
+}
+
+// NOTE(WALKER): A conversion that was asked for and didn't happen turns the checkbox off, once, instead of every following
+//               frame retrying it (a synchronous trip to the GL thread, and a full redraw for damage tracking)
+static void fonts_texture_alpha8_check(bool wanted) {
+    if (!wanted || memory_panel.atlas_alpha8) return;
+    fprintf(stderr, "[fonts] single channel font texture failed, staying RGBA32\n");
+    memory_panel.alpha8_atlas  = false;
+    memory_panel.alpha8_failed = true;
+}
+
+static void fonts_reupload_texture() {
+    fonts_texture_alpha8_wanted = memory_panel.alpha8_atlas && glyph_renderer_active();
+    render_pipeline_run(render_pipeline, fonts_reupload_texture_now);
+    fonts_texture_alpha8_check(fonts_texture_alpha8_wanted);
+}
+
+// The renderer or the menu changed: going to Alpha8 converts the texture in place, going back rebuilds it as RGBA32
+static void fonts_texture_update_format() {
+    const bool alpha8 = memory_panel.alpha8_atlas && glyph_renderer_active();
+    if (alpha8 == memory_panel.atlas_alpha8) return;
+    if (alpha8) {
+        render_pipeline_run(render_pipeline, fonts_texture_to_alpha8_now);
+        fonts_texture_alpha8_check(true);
+    } else {
+        fonts_reupload_texture();
+    }
+}
+
+// Called before a frame: follows the canvas to its new CSS size * DPR, then resizes the text to match
+static void display_update(GLFWwindow* window, ImGuiIO& io) {
+    if (!display.dirty) return;
+    display.dirty = false;
+#ifdef __EMSCRIPTEN__
+    int w = 0, h = 0;
+    get_canvas_display_size(&w, &h);
+    int window_w = 0, window_h = 0;
+    glfwGetWindowSize(window, &window_w, &window_h);
+    if (w != window_w || h != window_h)
+        glfwSetWindowSize(window, w, h); // Emscripten's GLFW resizes the canvas backing store and tells ImGui's backend
+#endif
+    int fb_w = 0, fb_h = 0;
+    glfwGetFramebufferSize(window, &fb_w, &fb_h);
+    if (fb_w <= 0 || fb_h <= 0 || (fb_w == display.width && fb_h == display.height)) return;
+    display.width  = fb_w;
+    display.height = fb_h;
+    ++display.changes;
+    render_scale_reset(render_scale); // a different amount of pixels, what was measured no longer holds
+    if (fonts_set_display_size(io, font_display_size(fb_w, fb_h)))
+        fonts_reupload_texture(); // switched to a cached atlas
+}
+
+static void platform_menu() {
+    frame_pacer_show_menu();
+    ImGui::Text("First frame:     %.1f ms after page start", first_frame_ms);
+    if (static_content_ms > 0.0)
+        ImGui::Text("First content:   %.1f ms (static HTML), %.1f ms sooner than the first frame", static_content_ms, first_frame_ms - static_content_ms);
+    else
+        ImGui::Text("First content:   %.1f ms (first frame, no static HTML)", first_frame_ms);
+    ImGui::Text("Framebuffer:     %dx%d (%d size changes)", display.width, display.height, display.changes);
+    glyph_renderer_show_menu();
+    render_scale_show_menu(render_scale);
+    damage_target_show_menu();
+    render_pipeline_show_menu(render_pipeline);
+    ImGui::Separator();
+    memory_panel_show_menu();
+}
+
+static void request_frames() { frame_pacer_request_frames(2); }
 
 // [Win32] Our example includes a copy of glfw3.lib pre-compiled with VS2010 to maximize ease of testing and compatibility with old VS compilers.
 // To link with VS2010-era libraries, VS2015+ requires linking with legacy_stdio_definitions.lib, which we do using this pragma.
@@ -76,6 +369,12 @@ int main(int, char**) {
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
     glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
+#elif defined(IMGUI_IMPL_OPENGL_ES3)
+    // GL ES 3.0 + GLSL 300 es (WebGL2, for the instanced glyph renderer)
+    const char* glsl_version = "#version 300 es";
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
 #elif defined(__APPLE__)
     // GL 3.2 + GLSL 150
     const char* glsl_version = "#version 150";
@@ -92,27 +391,26 @@ int main(int, char**) {
     //glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);            // 3.0+ only
 #endif
 
-    // Automatically set Canvas Width/Height:
-    resize_canvas_to_screen_dimensions();
+    // Automatically set Canvas Width/Height (and keep following it, see display_update()):
+    resize_canvas_to_display_size();
     auto canvas_width  = get_canvas_width();
     auto canvas_height = get_canvas_height();
 
-    // NOTE(WALKER): This is for mobile users so they can at least view the app when they turn their phone sideways
-    //               They still wno't be able to interact with it very well because touch screens are wonky
-    if (canvas_width < canvas_height) {
-        auto temp = canvas_width;
-        canvas_width = canvas_height;
-        canvas_height = temp;
-    }
-
     // Create window with graphics context
     GLFWwindow* window = glfwCreateWindow(canvas_width, canvas_height, "Walker Williams Resume", nullptr, nullptr);
     if (window == nullptr)
         return 1;
     glfwMakeContextCurrent(window);
     glfwSwapInterval(1); // Enable vsync
+    main_window = window;
+    render_pipeline.attach = render_thread_attach;
+    render_pipeline.detach = render_thread_detach;
+    render_pipeline.render = render_snapshot;
+    render_pipeline.handback = render_snapshot_handback;
+    for (int i = 0; i < 2; ++i) render_pipeline.slots[i].user = &render_handoffs[i];
 
     // Setup Dear ImGui context
+    allocator_install(); // NOTE(WALKER): Before CreateContext(), every ImGui allocation goes through the pool (allocator.hpp)
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
     ImGuiIO& io = ImGui::GetIO(); (void)io;
@@ -124,37 +422,34 @@ int main(int, char**) {
     //io.ConfigViewportsNoTaskBarIcon = true;
 
     // Setup Dear ImGui style
-    ImGui::StyleColorsDark();
-    ImGuiStyle& style = ImGui::GetStyle();
-    // Rounding:
-    style.WindowRounding = 0.0f;
-    style.ChildRounding = 6.0f;
-    style.FrameRounding = 6.0f;
-    style.PopupRounding = 6.0f;
-    style.ScrollbarRounding = 6.0f;
-    style.GrabRounding = 6.0f;
-    style.TabRounding = 12.0f;
-
-    // When viewports are enabled we tweak WindowRounding/WindowBg so platform windows can look identical to regular ones.
-    if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
-        style.WindowRounding = 0.0f;
-        style.Colors[ImGuiCol_WindowBg].w = 1.0f;
-    }
+    resume_ui_setup_style();
 
     // Setup Platform/Renderer backends
+    display_install(window);     // NOTE(WALKER): Before the frame pacer so it chains to our framebuffer size callback
+    frame_pacer_install(window); // NOTE(WALKER): Before the ImGui backend so it chains to our callbacks
     ImGui_ImplGlfw_InitForOpenGL(window, true);
     ImGui_ImplOpenGL3_Init(glsl_version);
 
     // NOTE(WALKER): Automatically adjust font size based on the user's window dimensions to get clarity
-    const auto font_ratio = (canvas_width / 960.0f);
-    io.Fonts->AddFontFromFileTTF("fonts/JetBrainsMono-Regular.ttf", 13.0f * font_ratio);
-    io.Fonts->AddFontFromFileTTF("fonts/LiberationSans-Regular.ttf", 13.0f * font_ratio);
-    io.Fonts->AddFontFromFileTTF("fonts/LinLibertine_RBah.ttf", 13.0f * font_ratio);
-    io.Fonts->AddFontFromFileTTF("fonts/times new roman.ttf", 13.0f * font_ratio);
-    io.Fonts->AddFontFromFileTTF("fonts/ProggyClean.ttf", 13.0f * font_ratio);
+    //               In SDF mode the faces are baked once and the size only becomes a shader scale (see fonts.hpp)
+    const float font_size = font_display_size(display.width, display.height);
+#ifdef RESUME_FONT_PACK
+    fonts_open_pack("fonts/fonts.pack"); // NOTE(WALKER): Falls back to the TTF files when it's not there (see Makefile, FONT_PACK)
+#endif
+    fonts_load(io, Font_Mode_SDF, font_size);
+    if (!sdf_text_shader_init(glsl_version))
+        fonts_load(io, Font_Mode_Raster, font_size); // No SDF shader, no SDF atlas
+    glyph_renderer_init(glsl_version); // NOTE(WALKER): Falls back to the stock backend below when this fails
+    render_scale_init();
+    ImGui_ImplOpenGL3_CreateDeviceObjects(); // NOTE(WALKER): Now instead of in the first NewFrame(), which would recreate the font texture after the first frame made it Alpha8
+
+    Resume_UI ui;
+    ui.open_link      = open_link;
+    ui.platform_menu  = platform_menu;
+    ui.request_frames = request_frames;
+    resume_ui_init(ui, "content/resume.bin");
 
-    // Our state
-    ImVec4 clear_color = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
+    unsigned long long frames_skipped_before = 0; // NOTE(WALKER): Frame intervals across a skipped frame aren't render_scale samples
 
     // Main loop
 #ifdef __EMSCRIPTEN__
@@ -166,406 +461,101 @@ int main(int, char**) {
     while (!glfwWindowShouldClose(window))
 #endif
     {
-        glfwPollEvents();
+        profiler_frame_begin(); // NOTE(WALKER): PROFILE_ZONE()s below show up in the "Profiler" overlay (profiler.hpp)
+        if (fonts_has_pending_work())
+            frame_pacer_request_frames(1); // NOTE(WALKER): Keep frames coming while a streamed-in face is being built
+        {
+            PROFILE_ZONE("glfwPollEvents");
+            frame_pacer_wait_events();
+        }
+        if (!frame_pacer_should_render())
+            continue; // NOTE(WALKER): Nothing changed, the last presented frame is still on screen
+        const double frame_begin_ms = profiler_now_ms(); // NOTE(WALKER): Input is in, latency is measured from here to present
+        render_pipeline_update();
+        const float frame_render_scale = render_scale_frame(render_scale, frame_begin_ms, frame_pacer.frames_skipped == frames_skipped_before, get_device_pixel_ratio());
+        frames_skipped_before = frame_pacer.frames_skipped;
 
-        // Start the Dear ImGui frame
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
-        ImGui::NewFrame();
+        {
+            PROFILE_ZONE("Font streaming");
+            display_update(window, io);
+            if (fonts_update(io)) // New atlas swapped in, the texture we have is the old atlas'
+                fonts_reupload_texture();
+            else
+                fonts_texture_update_format(); // NOTE(WALKER): Only our shader can draw the Alpha8 texture, it follows the renderer
+        }
+        const int renderer = glyph_renderer_active() ? Renderer_Instanced : Renderer_Stock; // NOTE(WALKER): Picked with the texture format, a toggle while building waits for the next frame
 
+        // Start the Dear ImGui frame
+        allocator_new_frame();
         {
-            const ImGuiViewport* viewport = ImGui::GetMainViewport();
-            ImGui::SetNextWindowPos(viewport->WorkPos);
-            ImGui::SetNextWindowSize(viewport->WorkSize);
-
-            ImGuiWindowFlags window_flags = 0;
-            // window_flags |= ImGuiWindowFlags_NoTitleBar;
-            window_flags |= ImGuiWindowFlags_NoMove;
-            window_flags |= ImGuiWindowFlags_NoResize;
-            window_flags |= ImGuiWindowFlags_NoCollapse;
-            window_flags |= ImGuiWindowFlags_MenuBar;
-            ImGui::Begin("Walker Williams Resume (Written in C++)", nullptr, window_flags);
-            defer { ImGui::End(); };
-
-            // Menu bar:
-            if (ImGui::BeginMenuBar()) {
-                defer { ImGui::EndMenuBar(); };
-                // Style editor (from the demo window):
-                if (ImGui::BeginMenu("Style")) {
-                    defer { ImGui::EndMenu(); };
-                    ImGui::ShowStyleEditor();
-                }
-            }
+            PROFILE_ZONE("ImGui::NewFrame");
+            if (!render_pipeline.running)
+                ImGui_ImplOpenGL3_NewFrame();
+            ImGui_ImplGlfw_NewFrame();
+            ImGui::NewFrame();
+        }
 
-            // Sections:
-            if (ImGui::BeginTabBar("Sections")) {
-                defer { ImGui::EndTabBar(); };
-                if (ImGui::BeginTabItem("About", nullptr, ImGuiTabItemFlags_None)) {
-                    defer { ImGui::EndTabItem(); };
-                    {
-                        ImGui::BeginChild("Scroll");
-                        defer { ImGui::EndChild(); };
-
-                        ImGui::TextWrapped("Contact info:");
-                        IMGUI_BULLETTEXTWRAPPED("Email:        walkerw97@gmail.com");
-                        IMGUI_BULLETTEXTWRAPPED("Phone Number: +1 (919) 935-2397");
-                        IMGUI_BULLETTEXTWRAPPED("");
-                        ImGui::SameLine();
-                        if (ImGui::Button("LinkedIn")) {
-                            open_link("https://www.linkedin.com/in/walker-williams-02223a1a8");
-                        }
-                        IMGUI_BULLETTEXTWRAPPED("");
-                        ImGui::SameLine();
-                        if (ImGui::Button("GitHub")) {
-                            open_link("https://github.com/WWilliams741");
-                        }
-                        ImGui::NewLine();
-
-                        ImGui::TextWrapped("Hello, my name is Walker Williams. I am a very passionate programmer and this is my resume, written in C++, and put on the web for you, recruiter, potential employer, or casual viewer, to look through.");
-                        ImGui::NewLine();
-                        ImGui::TextWrapped("You might ask yourself: \"Why write your resume in C++?\" The answer is simple. Regular resumes are boring and recruiters and employers go through them day by day looking for certain qualities. I figured the best way to show them that I'm a competent programmer is to program my own resume in a language I am familiar with. Want to know if I can program in C++ right away without spending time looking at my resume? Well guess what? This resume is written in C++, so now you know the answer is yes. This also spices up the recruiter's or employer's life, and gives them something they can interact with for once, instead of a word document or a pdf they boringly scan for key words, usually with a computer program. It's a nice little surprise to break the day to day monotany.");
-                        ImGui::NewLine();
-                        ImGui::TextWrapped("Fun fact: This is the first UI I've ever written as a programmer. I learned on the fly just to write this resume.");
-                        ImGui::NewLine();
-                        ImGui::TextWrapped("PSSSSSSSSSSSSSSSSSSSSST: There is a style button at the top left corner of this resume. Try clicking it and mess with some of the values (especially colors).");
-                        ImGui::NewLine();
-                        if (ImGui::Button("Resume Code")) {
-                            open_link("https://github.com/WWilliams741/WWilliams741.github.io");
-                        }
-                    }
-                }
-                // Skills:
-                if (ImGui::BeginTabItem("Skills", nullptr, ImGuiTabItemFlags_None)) {
-                    defer { ImGui::EndTabItem(); };
-                    int open_action = -1;
-                    if (ImGui::Button("Open all"))
-                        open_action = 1;
-                    ImGui::SameLine();
-                    if (ImGui::Button("Close all"))
-                        open_action = 0;
-                    {
-                        ImGui::BeginChild("Scroll");
-                        defer { ImGui::EndChild(); };
-
-                        // Languages:
-                        if (open_action != -1)
-                            ImGui::SetNextItemOpen(open_action != 0);
-                        if (ImGui::TreeNode("C/C++ (master)")) {
-                            defer { ImGui::TreePop(); };
-                            IMGUI_BULLETTEXTWRAPPED("C++ is my main language besides Jai");
-                            IMGUI_BULLETTEXTWRAPPED("This resume is written in C++ thanks to the power of Dear ImGui and Emscripten");
-                            IMGUI_BULLETTEXTWRAPPED("I have developed, from scratch solo, critical projects/architecture in C++, with little to no guidance before");
-                            {
-                                ImGui::Indent();
-                                defer { ImGui::Unindent(); };
-                                IMGUI_BULLETTEXTWRAPPED("The above projects were all multi-threaded environments in distributed systems");
-                            }
-                            IMGUI_BULLETTEXTWRAPPED("I was well known at FlexGen Power Systems as one of their best C++ programmers, not even a linter was used without my approval");
-                            IMGUI_BULLETTEXTWRAPPED("Familiar with the STL, Generic Programming, creating custom allocators/memory management, etc.");
-                            IMGUI_BULLETTEXTWRAPPED("Familiar with debugging using Valgrind, GDB, step debugging using breakpoints in an IDE, etc.");
-                            IMGUI_BULLETTEXTWRAPPED("Familiar with TDD (Test Driven Development) using Googletest or, my preferred favorite framework, Doctest");
-                        }
-                        if (open_action != -1)
-                            ImGui::SetNextItemOpen(open_action != 0);
-                        if (ImGui::TreeNode("golang (intermediate)")) {
-                            defer { ImGui::TreePop(); };
-                            IMGUI_BULLETTEXTWRAPPED("I know golang enough to write code in it comfortably, but I still have to look things up every now and then");
-                            IMGUI_BULLETTEXTWRAPPED("I have mentored a new software engineer to rewrite a core codebase from scratch in golang");
-                        }
-                        if (open_action != -1)
-                            ImGui::SetNextItemOpen(open_action != 0);
-                        if (ImGui::TreeNode("python (intermediate)")) {
-                            defer { ImGui::TreePop(); };
-                            IMGUI_BULLETTEXTWRAPPED("I know python at a scripting level");
-                            IMGUI_BULLETTEXTWRAPPED("I have written python scripts before in a professional environment");
-                        }
-                        if (open_action != -1)
-                            ImGui::SetNextItemOpen(open_action != 0);
-                        if (ImGui::TreeNode("bash (intermediate)")) {
-                            defer { ImGui::TreePop(); };
-                            IMGUI_BULLETTEXTWRAPPED("I know bash at a scripting level");
-                            IMGUI_BULLETTEXTWRAPPED("I have written bash scripts for an installation/deployment process before professionally");
-                        }
-                        if (open_action != -1)
-                            ImGui::SetNextItemOpen(open_action != 0);
-                        if (ImGui::TreeNode("Jai (intermediate)")) {
-                            defer { ImGui::TreePop(); };
-                            IMGUI_BULLETTEXTWRAPPED("Currently a proud member of the closed beta for the ");
-                            ImGui::SameLine();
-                            if (ImGui::Button("Jai programming language")) {
-                                open_link("https://github.com/Jai-Community/Jai-Community-Library/wiki");
-                            }
-                            IMGUI_BULLETTEXTWRAPPED("Beta access is not easily given out, you have to prove you're worthy of being given access");
-                            IMGUI_BULLETTEXTWRAPPED("Only a couple hundred other people are in the beta");
-                            IMGUI_BULLETTEXTWRAPPED("Beta is run by Jonathan Blow, creator of best selling games \"Braid\" and \"The Witness\"");
-                        }
-                        // Practices:
-                        if (open_action != -1)
-                            ImGui::SetNextItemOpen(open_action != 0);
-                        if (ImGui::TreeNode("Agile Development")) {
-                            defer { ImGui::TreePop(); };
-                            IMGUI_BULLETTEXTWRAPPED("Jira boards and filling out tickets for sprints");
-                            IMGUI_BULLETTEXTWRAPPED("Markdown documentation on Confluence or GitHub Wikis");
-                            IMGUI_BULLETTEXTWRAPPED("CI (Continuous Integration) using GitHub PRs (Pull Requests), Code Reviews with lead sign off, and Jenkins/AWS (Amazon Web Services)");
-                            IMGUI_BULLETTEXTWRAPPED("SCRUM meetings twice a week to check in on progress and potential blockers");
-                            IMGUI_BULLETTEXTWRAPPED("Sprints that last 1 month+ with pre-planning");
-                            IMGUI_BULLETTEXTWRAPPED("Consistent communication on Slack with team members on a daily basis");
-                        }
-                        if (open_action != -1)
-                            ImGui::SetNextItemOpen(open_action != 0);
-                        if (ImGui::TreeNode("Parallel/Multi-threaded Programming")) {
-                            defer { ImGui::TreePop(); };
-                            IMGUI_BULLETTEXTWRAPPED("Familiar with concepts such as producer-consumer queues (channels), IO pools, mutexes, semaphores, atomics, false sharing, over subscribing, etc.");
-                            IMGUI_BULLETTEXTWRAPPED("I know the difference between the two different types of parallel programming paradigms: for performance and for blocking events (like IO)");
-                            IMGUI_BULLETTEXTWRAPPED("I have written multi-threaded software before in distributed systems professionally");
-                        }
-                        if (open_action != -1)
-                            ImGui::SetNextItemOpen(open_action != 0);
-                        if (ImGui::TreeNode("Performance Aware Programming")) {
-                            defer { ImGui::TreePop(); };
-                            IMGUI_BULLETTEXTWRAPPED("I am NOT afraid of ");
-                            ImGui::SameLine();
-                            if (ImGui::Button("memory")) {
-                                open_link("https://github.com/WWilliams741/Utilities/tree/main/jai_langauge_concepts_in_cpp");
-                            }
-                            ImGui::SameLine();
-                            ImGui::Text(" and low level programming");
-                            IMGUI_BULLETTEXTWRAPPED("I am PRO creating custom allocators");
-                            IMGUI_BULLETTEXTWRAPPED("I am PRO understanding how your program acesses memory and how that relates to CPU caches and RAM (L1, L2, L3, main memory cache misses and their costs)");
-                            IMGUI_BULLETTEXTWRAPPED("I am PRO SUA (Shutup Use Array) 99%% of the time, and the last 1%% is usually a Hash Table");
-                            IMGUI_BULLETTEXTWRAPPED("I am PRO writing software from scratch, from an empty main(), and doing many iterations");
-                            IMGUI_BULLETTEXTWRAPPED("These above princples I have used in professional environments to great success");
-                        }
-                        // Environment:
-                        if (open_action != -1)
-                            ImGui::SetNextItemOpen(open_action != 0);
-                        if (ImGui::TreeNode("Software Environment/Tools")) {
-                            defer { ImGui::TreePop(); };
-                            IMGUI_BULLETTEXTWRAPPED("Docker for simulatating distributed systems and networks, using Dockerfiles and docker-compose for simplicity");
-                            IMGUI_BULLETTEXTWRAPPED("Linux environments are my goto (CentOS - Red Hat Linux for example), but Windows is alright");
-                        }
-                    }
-                }
-                // Work Experience:
-                if (ImGui::BeginTabItem("Work Experience", nullptr, ImGuiTabItemFlags_None)) {
-                    defer { ImGui::EndTabItem(); };
-                    int open_action = -1;
-                    if (ImGui::Button("Open all"))
-                        open_action = 1;
-                    ImGui::SameLine();
-                    if (ImGui::Button("Close all"))
-                        open_action = 0;
-                    {
-                        ImGui::BeginChild("Scroll");
-                        defer { ImGui::EndChild(); };
-
-                        if (open_action != -1)
-                            ImGui::SetNextItemOpen(open_action != 0);
-                        if (ImGui::TreeNode("Software Engineer - IBM                       (January   2024 -> Current)")) {
-                            defer { ImGui::TreePop(); };
-
-                            IMGUI_BULLETTEXTWRAPPED("Languages: C/C++, XML, XSL");
-                            IMGUI_BULLETTEXTWRAPPED("Working as a backend developer for IBM's ");
-                            ImGui::SameLine();
-                            if (ImGui::Button("Datapower Gateway")) {
-                                open_link("https://www.ibm.com/products/datapower-gateway");
-                            }
-                            IMGUI_BULLETTEXTWRAPPED("Maintaining and updating a 20+ year old legacy C++ codebase, bug fixes especially");
-                            IMGUI_BULLETTEXTWRAPPED("Completing Salesforce cases by talking directly to customers, recreating their issues, then investigating code directly for solutions");
-                        }
-
-                        if (open_action != -1)
-                            ImGui::SetNextItemOpen(open_action != 0);
-                        if (ImGui::TreeNode("Software Engineer - Chrysanthemum Productions (Auguest   2023 -> Current)")) {
-                            defer { ImGui::TreePop(); };
-                            IMGUI_BULLETTEXTWRAPPED("Languages: C/C++, Jai");
-                            IMGUI_BULLETTEXTWRAPPED("Working with a previous FlexGen employee, Sam Rappl, on a hydroponics startup");
-                            IMGUI_BULLETTEXTWRAPPED("Preliminary work is being done using Arduino Uno, Raspberry Pi, sensors, and custom circuits on a bread board");
-                            IMGUI_BULLETTEXTWRAPPED("We have already applied for two patents, and are applying for more");
-                            IMGUI_BULLETTEXTWRAPPED("Currently not off the ground yet, but will get there someday");
-                        }
-
-                        if (open_action != -1)
-                            ImGui::SetNextItemOpen(open_action != 0);
-                        if (ImGui::TreeNode("Software Engineer - FlexGen Power Systems     (September 2020 -> August 2023)")) {
-                            defer { ImGui::TreePop(); };
-
-                            IMGUI_BULLETTEXTWRAPPED("Languages: C/C++, golang, python, bash");
-                            IMGUI_BULLETTEXTWRAPPED("Joined FlexGen fresh out of college, my first job, doing 100%% remote work for the first couple months over Slack");
-                            IMGUI_BULLETTEXTWRAPPED("FlexGen specializes in BESSs (Battery Energy Storage Systems), a form of distributed system with multiple pieces of hardware in a \"Command and Control\" typology, with thousands of data points in a live system");
-                            IMGUI_BULLETTEXTWRAPPED("I developed, along with 3 other people in C++, FlexGen's ESS (Energy Storage System) Controller, their lowest level controller and one of their most important pieces of software");
-                            IMGUI_BULLETTEXTWRAPPED("I have written, solo in bash, their entire deployment/installation process, later this was converted to Ansible by another team entirely");
-                            IMGUI_BULLETTEXTWRAPPED("I have rewritten, solo in C++, core communication software that is used throughout the entire distributed network, bringing the CPU usage down from 112%% to 1-3%% in our largest use cases and increasing networking performance by about 2-3 times");
-                            IMGUI_BULLETTEXTWRAPPED("I have rewritten, solo in C, C++, and golang, the core Unix IPC (Inter Process Communication) architecture that underlied everything, taking a large test that used to take 3 minutes down to 3 seconds, and causing an end-to-end all possible inputs test to go from 1 week down to 1 day or less, without breaking anyone's code");
-                            IMGUI_BULLETTEXTWRAPPED("I have mentored a new software engineer to rewrite a core piece of integration architecture from scratch, in golang, taking the lines of config from the thousands down to the hundreds by adding programmatic scripting language support");
-                            {
-                                ImGui::Indent();
-                                defer { ImGui::Unindent(); };
-                                IMGUI_BULLETTEXTWRAPPED("Because of the above achievements, FlexGen was able to properly scale to larger sites beyond 100+ MW, allowing them to take on some of the largest BESS projects in the world, and become a multi-million dollar success story, going from 50 employees to hundreds of employees");
-                            }
-                            IMGUI_BULLETTEXTWRAPPED("I was known as one of their best Software Engineers, even to the point where not even a C++ linter was used without my approval, and have received glowing recommendations from my fellow co-workers, including the Director of Software at FlexGen: ");
-                            {
-                                ImGui::Indent();
-                                defer { ImGui::Unindent(); };
-                                ImGui::BulletText("");
-                                ImGui::SameLine();
-                                if (ImGui::Button("Kyle Brezina")) {
-                                    open_link("https://www.linkedin.com/in/kyle-brezina-b7066b57/");
-                                }
-                                ImGui::SameLine();
-                                ImGui::Text(" (you can find his recommendation on ");
-                                ImGui::SameLine();
-                                if (ImGui::Button("my LinkedIn")) {
-                                    open_link("https://www.linkedin.com/in/walker-williams-02223a1a8");
-                                }
-                                ImGui::SameLine();
-                                ImGui::Text(")");
-                            }
-                        }
-                    }
-                }
-                // Projects:
-                if (ImGui::BeginTabItem("Projects", nullptr, ImGuiTabItemFlags_None)) {
-                    defer { ImGui::EndTabItem(); };
-                    int open_action = -1;
-                    if (ImGui::Button("Open all"))
-                        open_action = 1;
-                    ImGui::SameLine();
-                    if (ImGui::Button("Close all"))
-                        open_action = 0;
-                    {
-                        ImGui::BeginChild("Scroll");
-                        defer { ImGui::EndChild(); };
-
-                        if (open_action != -1)
-                            ImGui::SetNextItemOpen(open_action != 0);
-                        if (ImGui::TreeNode("This Resume - Lifetime Active")) {
-                            defer { ImGui::TreePop(); };
-                            IMGUI_BULLETTEXTWRAPPED("If you're reading this you're viewing this project right now");
-                            IMGUI_BULLETTEXTWRAPPED("NOTE: Each time you view this resume things might change, so check back every now and then");
-                        }
-
-                        if (open_action != -1)
-                            ImGui::SetNextItemOpen(open_action != 0);
-                        if (ImGui::TreeNode("Jai Language Closed Beta - Currently Active")) {
-                            defer { ImGui::TreePop(); };
-                            IMGUI_BULLETTEXTWRAPPED("Currently a proud member of the closed beta for the ");
-                            ImGui::SameLine();
-                            if (ImGui::Button("Jai programming language")) {
-                                open_link("https://github.com/Jai-Community/Jai-Community-Library/wiki");
-                            }
-                            IMGUI_BULLETTEXTWRAPPED("Beta access is not easily given out, you have to prove you're worthy of being given access");
-                            IMGUI_BULLETTEXTWRAPPED("Only a couple hundred other people are in the beta");
-                            IMGUI_BULLETTEXTWRAPPED("Beta is run by Jonathan Blow, creator of best selling games \"Braid\" and \"The Witness\"");
-                            IMGUI_BULLETTEXTWRAPPED("I have filled out multiple bug reports across multiple beta versions already");
-                            IMGUI_BULLETTEXTWRAPPED("I have contributed to an open source project that the beta members are writing called \"Focus\", an editor written 100%% in Jai that I am using right now to write this resume");
-                        }
-                        if (open_action != -1)
-                            ImGui::SetNextItemOpen(open_action != 0);
-                        if (ImGui::TreeNode("Arduino Uno Simon Says Game - Completed")) {
-                            defer { ImGui::TreePop(); };
-                            IMGUI_BULLETTEXTWRAPPED("A simple game with four buttons on a custom built circuit and an Arduino Uno");
-                            IMGUI_BULLETTEXTWRAPPED("A random order of lights would be displayed, you would then have to match the light order with the buttons, then another light is added next round");
-                            IMGUI_BULLETTEXTWRAPPED("You won if you went 15 rounds following \"Simon's\" orders, and lost if you couldn't memorize them");
-                            IMGUI_BULLETTEXTWRAPPED("");
-                            ImGui::SameLine();
-                            if (ImGui::Button("Code and Demo")) {
-                                open_link("https://github.com/WWilliams741/Simon-Says-Game");
-                            }
-                        }
-                    }
-                }
-                // Education:
-                if (ImGui::BeginTabItem("Education", nullptr, ImGuiTabItemFlags_None)) {
-                    defer { ImGui::EndTabItem(); };
-                    int open_action = -1;
-                    if (ImGui::Button("Open all"))
-                        open_action = 1;
-                    ImGui::SameLine();
-                    if (ImGui::Button("Close all"))
-                        open_action = 0;
-                    {
-                        ImGui::BeginChild("Scroll");
-                        defer { ImGui::EndChild(); };
-
-                        if (open_action != -1)
-                            ImGui::SetNextItemOpen(open_action != 0);
-                        if (ImGui::TreeNode("University of North Carolina at Charlotte - (2016 -> 2020)")) {
-                            defer { ImGui::TreePop(); };
-                            IMGUI_BULLETTEXTWRAPPED("Early Master of Science in Computer Science - GPA: 3.8  /4.0");
-                            IMGUI_BULLETTEXTWRAPPED("Bachelor of Science in Computer Science     - GPA: 3.658/4.0");
-                            IMGUI_BULLETTEXTWRAPPED("I enrolled in UNCC's Early Master's program");
-                            IMGUI_BULLETTEXTWRAPPED("I graduated in 3 years with my Bachelor's and 4 with my Master's");
-                        }
-                        if (open_action != -1)
-                            ImGui::SetNextItemOpen(open_action != 0);
-                        if (ImGui::TreeNode("Lee Early College/Central Carolina Community College - (2012 -> 2016)")) {
-                            defer { ImGui::TreePop(); };
-                            IMGUI_BULLETTEXTWRAPPED("High School Diploma && Associate in Science - GPA: 3.78 /4.0");
-                            IMGUI_BULLETTEXTWRAPPED("I was chosen out of Middle School for this High School through an interview process");
-                            IMGUI_BULLETTEXTWRAPPED("Students would dual enroll in both High School and Community College courses, graduating from both at the end of 4 years");
-                        }
-                    }
-                }
-                // defer macro gift:
-                if (ImGui::BeginTabItem("Gifts For You", nullptr, ImGuiTabItemFlags_None)) {
-                    defer { ImGui::EndTabItem(); };
-
-                    ImGui::TextWrapped("These are gifts to you, as a way of contributing to your, or the company that you represent's, codebase before even being hired, as a gesture of good will. It is a defer macro for C++11 and beyond, and a unique take on memory management in C++ based on the Jai Programming Language. So, even if you don't hire me, at least you got free code out of it, and the world will be a better place.");
-                    ImGui::NewLine();
-
-                    ImGui::BulletText("");
-                    ImGui::SameLine();
-                    if (ImGui::Button("Defer Code")) {
-                        open_link("https://github.com/WWilliams741/Utilities/blob/main/defer.hpp");
-                    }
-                    ImGui::SameLine();
-                    ImGui::Text("(");
-                    ImGui::SameLine();
-
-                    if (ImGui::Button("Live Demo")) {
-                        open_link("https://compiler-explorer.com/#z:OYLghAFBqd5QCxAYwPYBMCmBRdBLAF1QCcAaPECAMzwBtMA7AQwFtMQByARg9KtQYEAysib0QXACx8BBAKoBnTAAUAHpwAMvAFYTStJg1DIApACYAQuYukl9ZATwDKjdAGFUtAK4sGe1wAyeAyYAHI%2BAEaYxBIAnKQADqgKhE4MHt6%2BekkpjgJBIeEsUTFc8XaYDmlCBEzEBBk%2Bfly2mPZ5DDV1BAVhkdFxtrX1jVktCsM9wX3FA2UAlLaoXsTI7BzmAMzByN5YANQmm27IE/ioR9gmGgCC13dm21QMWFT7ACLYAGLYAEoA%2Bm5lMp7ltXtMPt8/oDgaDbgB6eH7G77LxKKheWj7FhMZDEVD7Ij7YCYAj7OoRQjEOoAT32aAORMwqkqXgImHJZIICA5rn2qDeTH2CjQCQ5aOCwH2vxuAElZeSXvsDMV0EwFAA6e6I/YAFQQeAU%2BwS%2BIAbngsEbXtFhTTBExVMK8Cw6Hg6oSCcBPIZgBq9QajYbUejMft%2BMR9sF2cQqLjJdqkQB3QgIfZuZHKWVG7lMMkhTDocmHMxmLDBQjmMz8iOV3aYQxeBKVsNeBhVAQe/ZRelieiF3OEnn7PkC4WizBahFI/VBvH19lGhkcnNk2f0Qw2qKiNEcmnLfboARgDh5zAFztz3Mc2ioAhG0cy%2BX7RPUhJi4iauE3HWhADyuuwEB/Q5a0IxxPECSDdUFB8c8iW7SsGFQZk1gSAhmwiOlXiYTECEnb8kX2IjiLBTAaBCSEfgBAB1WVdQACX%2BbAAA03GwZRdVlX9QiEckIlQU0OUrUCNQQN9myJXtUETYdVFQjpswJbtuXxRMGATYjNOCFIDlA4VanZNhBCNCAxG5ZZgFTBVE2WWhCwNSzaDpJh0HNJRyWAJhtNXAh5lBR48CoV5KOhWiGKY1j2M47ihH8zZwQoz4qP%2BP8WLYjj9iQlDMDQ6gxCUPzbi2NolDihKOSS6FUsijKsrknKCAgAhiC8TBCoeTZXECr8tkC/Z/n%2BZAEm8BRhrRQ5NiuTZ3n2MwNC4AB2DRNgCL8dXeMibXA/F9ggS4jhmtxrGsRb5hAe5DOGq8jjcAgaTFZg2DTDBMH224JhahwPk2msFqsW5NI8A4lyOf6CPpAQJmZE1hUbJJ6l2/bprTY7LDms64r6gahpGsajSRma5rmjQzFWgHiLQBgodUGGNqoaIICBjkIhvZAAGt5hCgFqvS3V9iApcIBZ1B2c5kw/vF957k0ynqZhgA/OmGc5yrud/NKosOP6IawCA/M2CwtalorHhK17yaIpXiEZl6u1ZjmuZS9War5gWXqF%2B2xYlhbjZRYjFZ%2BvXHZ5zXxcNwX9cNyW4q6qhQR90GyrIiEAHFsFCf5VZSm4AFlsH%2BeibjcABpCBHswUgIdbaNOfL4tNi2KvBGiJPyI5NOM6z0Jc%2BwMvWArpua/2DvM6hbme4LovS/Lyu0Gr6J2tItuDx%2B776YjEeu57iB/lA/5K4GtxfzkUIAIBf4xeRkwAFYrDMAA2G/3iDrvnd5nrTdoUqiqnNettxHae1JoHRRpYE6XB2qXQMOyG6d0Hr92elgN6NwPpeC%2BlbLWYNAa2xBgbaWxErY2wOMLUWwc36azdrrEhDsw7RwtvsAO68X5jydhrDKYcdaYD1qDI28cpZ4Pes1NBZIrb/BTowaIuYSCYMJJgFgV0YHHDgYwBBTNLh/2IDdNRk1%2BTvikTWSwRCORLhViwkO7DtbEFJCsBgGitEvX2n9EGCcDZG14QIjq5Vh7p1HslbuedJ4lz7mwWeyxm7EFrggrYjc57hNbqnHxW887BIHrEoem8zET0LkEmeg8F7xIonpHCRIMl%2BO3rvH6%2B9%2BqAmPqfaEF8JozVEeIkI1IiCaO9jNawhxb7mEftfZ%2Bpi/HkI4h/TqLxuo/3BtgVQrBhrigUEwEk51f7FIJAoVAbB/gYjbKZNkFwH6RgYAkNkXswY6k0npDhqMLDBBOehVx8IABU%2BxlBsk4XbEWbN9g8isZ2ZkrJ2ScmHEqUcIpUBikrnuLwPZbFWPXp2Ssdy2TNmCIOWcttqHKjwGzDkSFiA4ixE8pE0cPEXOIjqe5/JuQ2iXD86Iu59yJkMFyAkALkBsmZmREgIFV60BxXikghKNKaSsQQGxRz7mJ1/nQ6Zsz5H0GxF5WxEAFAIFsoWE0UZ9hcC7Nyv5ZgMa/21TiYIQdaG/0uavDhWrBBUD2iWHktAbyVz0jZYgdkwBgFmjfNw6kSyR3cecwixErna1tQQe1lYnUupXgi91nrvVcF9f6w1PDSXBt4VM4qEy47ZtuCa5V5qJb0LDYbCNUbHVtFjW6kgiafXXz9ZWQNGb8FETLcaYgUZK1mBjagV1q8E3oC9TqlNzb00uLBrKjgixaCcGvrwPwHAtCkFQJwI6YDLDCmWKsISjweCkAIJoGdiweQuQGHrUgbMQDXw0PoTgkhF3HtXZwXgCgQB3qPcumdpA4CwBgIgFAmyEh0GiOQSgaB5GgZiMALgmwzCkCwOaNYAA1PAmBEy/gepwA9NBaDRnfULZ9lJmDEBpDh3gJHaS/giNoSoX6D2QaMgQX8DAnLPqwBELwwA3C9nfdwXgWAcRGHEN%2BxDeArFVEEvxld7LOXPqjG0Z9/KIjUjI0zZ9zVnQUcWFQAwwAFBoYw1hxgFGZCCBEGIdgUhzPyCUGoZ9ugWgGCMCgG5%2Bg8ARHfZARYEKFKcAALRnAOqYTdFg5r7AC7%2BKsAXqK9ki9RZkzUhSxbFGqQQeBkAJcpoJD8aQEtqpctJSLzxUABeymhNICheACWiF2y08BFgVHbH4CArhRjNFIIEaYRQSjZGSKkAQHX%2Bu5DSL0XrcxWjtGqJMYb4w2j0Zm90cb/RShDG6HN9b9QVuzFKE1ndawJCzvnU%2BsTa6OD7FUAADnvgF%2B%2BkhiTICy3BjUVYIC4EINIrYEDeBfq0PMRY1775mA1Nfe9HBH2kBYDeu9S6V3nbfR%2Bw9x7Fh/sA8sAg9zwMQEgyB%2BgxBQj904Nd2793HvPc2K93gBZPv1b0PwCzohxA2YZ3ZlQ6gxNOdIC%2BJgCQdPg4XaQOHNXOC/jZFS0cJO7sPeAE9nVlO3seCg/j%2BuP3kffoB6QM9WAYiXrnRD3g0Pb1C%2BfQj2wSO/snqvTD8HmxTvw9fer/7x2OBmHtyLjgv2UeLFyykZwkggA%3D%3D");
-                    }
-                    ImGui::SameLine();
-                    ImGui::Text(")");
-
-                    ImGui::BulletText("");
-                    ImGui::SameLine();
-                    if (ImGui::Button("C++ memory management")) {
-                        open_link("https://github.com/WWilliams741/Utilities/tree/main/jai_langauge_concepts_in_cpp");
-                    }
-                }
-            }
+        {
+            PROFILE_ZONE("Build UI");
+            resume_ui_frame(ui);
         }
 
         // Rendering
-        ImGui::Render();
-        int display_w, display_h;
-        glfwGetFramebufferSize(window, &display_w, &display_h);
-        glViewport(0, 0, display_w, display_h);
-        glClearColor(clear_color.x * clear_color.w, clear_color.y * clear_color.w, clear_color.z * clear_color.w, clear_color.w);
-        glClear(GL_COLOR_BUFFER_BIT);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-
-        // Update and Render additional Platform Windows
-        // (Platform functions may change the current OpenGL context, so we save/restore it to make it easier to paste this code elsewhere.
-        //  For this specific demo app we could also call glfwMakeContextCurrent(window) directly)
-        if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
-            GLFWwindow* backup_current_context = glfwGetCurrentContext();
-            ImGui::UpdatePlatformWindows();
-            ImGui::RenderPlatformWindowsDefault();
-            glfwMakeContextCurrent(backup_current_context);
+        {
+            PROFILE_ZONE("ImGui::Render");
+            ImGui::Render();
+            resume_ui_end_frame(ui, ImGui::GetDrawData());
+            memory_panel_frame(ImGui::GetDrawData());
         }
+        if (render_pipeline.running) {
+            // NOTE(WALKER): Copied and handed to the render thread, which draws and presents it while we build the next one
+            render_pipeline_submit(render_pipeline, ImGui::GetDrawData(), frame_begin_ms, io.FontGlobalScale, renderer, frame_render_scale);
+        } else {
+            {
+                PROFILE_ZONE("ImGui_ImplOpenGL3_RenderDrawData");
+                render_draw_data(ImGui::GetDrawData(), io.FontGlobalScale, renderer, frame_render_scale, damage_settings);
+                render_handoff_fill(render_handoffs[0]);
+                render_handoff_collect(render_handoffs[0]);
+            }
 
-        glfwSwapBuffers(window);
+            // Update and Render additional Platform Windows
+            // (Platform functions may change the current OpenGL context, so we save/restore it to make it easier to paste this code elsewhere.
+            //  For this specific demo app we could also call glfwMakeContextCurrent(window) directly)
+            if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
+                GLFWwindow* backup_current_context = glfwGetCurrentContext();
+                ImGui::UpdatePlatformWindows();
+                ImGui::RenderPlatformWindowsDefault();
+                glfwMakeContextCurrent(backup_current_context);
+            }
+
+            {
+                PROFILE_ZONE("glfwSwapBuffers");
+                glfwSwapBuffers(window);
+            }
+            render_pipeline_record_single(render_pipeline, frame_begin_ms, profiler_now_ms());
+        }
+        if (first_frame_ms == 0.0) {
+            first_frame_ms    = time_since_page_start_ms();
+            static_content_ms = static_content_swap();
+            printf("[startup] first frame at %.1f ms\n", first_frame_ms);
+        }
+        profiler_frame_end();
     }
 #ifdef __EMSCRIPTEN__
     EMSCRIPTEN_MAINLOOP_END;
 #endif
 
     // Cleanup
+    render_pipeline_free(render_pipeline); // NOTE(WALKER): Before any GL cleanup, the context comes back to this thread
+    glfwMakeContextCurrent(window);
+    resume_ui_shutdown(ui);
+    render_scale_shutdown();
+    damage_target_shutdown();
+    glyph_renderer_shutdown();
+    sdf_text_shader_shutdown();
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
+    fonts_shutdown();
     ImGui::DestroyContext();
 
     glfwDestroyWindow(window);
@@ -0,0 +1,965 @@
+// NOTE(WALKER): Native, headless build of the resume for benchmarking and profiling (perf, valgrind, sanitizers, CI).
+//               Same UI code as the web build (resume_ui.cpp), but no window, no GL context and a null renderer that only
+//               walks the draw data the way a real backend would. Modes:
+//                 - plain: runs a fixed number of frames at a fixed display size and prints CPU timings plus geometry counts
+//                 - --bench script.txt: plays every scenario of an input script (input_script.hpp) in a fresh ImGui context,
+//                   reports per scenario CPU time, vertices/indices, draw calls and ImGui heap allocations per frame, and
+//                   compares them against a baseline file so regressions fail the run (exit code 1)
+//                 - --soak: a long session of deterministic input that fails if the heap keeps growing after warm-up (allocator.hpp)
+//                 - --search-bench N: times every keystroke of a few typed queries against the content repeated N times (search.hpp)
+//                 - --emit-bench N: scalar vs SIMD glyph quad emission (glyph_emit.hpp) over the text laid out in the first frames
+//                 - --render-scale-check: the render scale controller (render_scale.hpp) on synthetic vsynced frame intervals
+//               --raster also draws every frame on the CPU (soft_raster.hpp) and reports the raster time and pixels filled per
+//               frame, --png writes the last frame. In bench mode --golden dir compares each scenario's last frame with
+//               dir/<scenario>.png (--write-golden dir writes them), so a frame that draws wrong fails the same run as a slow one.
+//               --damage tracks what changed from frame to frame (damage.hpp) and reports the damaged area, with --raster the
+//               CPU rasterizer then only redraws the damage, and --damage-check compares every such frame with a full redraw.
+//               Plain mode with --glyph-batch also batches every frame for the instanced renderer (glyph_batch.hpp) and prints
+//               what it would upload and draw next to what the stock OpenGL3 backend does with the same draw data.
+//               --pipelined hands every frame to the null renderer on a second thread (render_pipeline.hpp), --render-cost-ms
+//               makes each render busy-wait that long, standing in for driver/GPU submission, so the overlap shows.
+//
+// Build/run from resume/:  make headless && ./native/resume_headless --frames 1000 --width 1920 --height 1080
+//                          make bench / make bench-baseline / make soak / make search-bench / make glyph-bench / make pipeline-bench
+//                          make emit-bench / make golden / make golden-images / make golden-baseline / make damage-bench
+//                          make render-scale-check
+
+#include "imgui.h"
+#include "imgui_internal.h" // ImHashData()
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "fonts.hpp"
+#include "resume_ui.hpp"
+#include "profiler.hpp"
+#include "input_script.hpp"
+#include "allocator.hpp"
+#include "search.hpp"
+#include "glyph_batch.hpp"
+#include "glyph_emit.hpp"
+#include "text_layout_cache.hpp"
+#include "render_pipeline.hpp"
+#include "soft_raster.hpp"
+#include "damage.hpp"
+#include "render_scale.hpp"
+
+struct Headless_Options {
+    int         frames       = 1000;
+    int         width        = 1920;
+    int         height       = 1080;
+    const char* content_path = "gen/content/resume.bin";
+    Font_Mode   font_mode    = Font_Mode_SDF;
+    const char* baked_atlas  = nullptr; // load this pre-baked atlas (tools/atlas_baker) instead of building from the TTFs
+    const char* font_pack    = nullptr; // read the TTFs from this asset pack (tools/asset_packer) instead of fonts/
+    bool        move_mouse   = false; // sweep the mouse over the window so hover/replay fallbacks get exercised too
+    const char* trace_path   = nullptr; // Chrome trace JSON of the last frames (profiler.hpp)
+    bool        soak         = false;   // watch the heap over a long run instead, see run_soak()
+    int         content_copies = 1;     // synthetic large content: every section repeated this many times (content_load_repeated())
+    bool        virtualize     = true;  // content_view_stats.enabled, off to compare against submitting every row
+    int         search_copies    = 0;     // --search-bench, run_search_bench()
+    float       search_budget_ms = 1.0f;  // per keystroke, p99
+    int         emit_passes      = 0;     // --emit-bench, run_emit_bench()
+    bool        render_scale_check = false; // --render-scale-check, run_render_scale_check()
+    bool        glyph_batch      = false; // also run glyph_batch_build() on every frame, see run_frames()
+    bool        pipelined        = false; // render on a second thread, see run_frames()
+    double      render_cost_ms   = 0.0;   // simulated submission time per rendered frame
+    bool        raster           = false; // soft_raster_render() every frame, not counted in the cpu frame time
+    int         raster_threads   = 0;     // 0 = every hardware thread
+    const char* png_path         = nullptr; // plain mode: the last frame, rasterized
+    bool        damage           = false; // plain mode: damage_track() every frame, partial redraws with --raster
+    bool        damage_check     = false; // every partially redrawn frame against a full one
+
+    // --bench
+    const char* bench_path      = nullptr;
+    const char* baseline_path   = nullptr;
+    const char* write_baseline  = nullptr;
+    float       time_tolerance  = 0.30f; // CPU time is noisy, allow +30% before calling it a regression
+    float       count_tolerance = 0.02f; // geometry/allocation counts are deterministic, allow +2%
+    const char* golden_dir       = nullptr; // compare every scenario's last frame with <dir>/<scenario>.png
+    const char* write_golden_dir = nullptr;
+    int         golden_tolerance = 2;      // per channel, rounding differences between compilers/FMA
+    float       golden_max_diff  = 0.001f; // fraction of pixels allowed past the tolerance
+};
+
+// What a renderer backend would have to touch every frame, the checksum keeps the walk from being optimized out
+struct Null_Renderer_Stats {
+    unsigned long long vertices  = 0;
+    unsigned long long indices   = 0;
+    unsigned long long draw_cmds = 0;
+    unsigned int       checksum  = 0;
+};
+
+// 13px per 960 pixels of the long side, as font_display_size() in resume.cpp
+static float headless_font_size(ImVec2 display_size) {
+    return 13.0f * (display_size.x > display_size.y ? display_size.x : display_size.y) / 960.0f;
+}
+static ImVec2 fonts_display_size; // what the fonts were last sized for
+
+static int links_opened = 0;
+static void headless_open_link(const char* url) {
+    ++links_opened;
+    printf("open link: %s\n", url);
+}
+
+static void null_renderer_render(const ImDrawData* draw_data, Null_Renderer_Stats& stats) {
+    for (int n = 0; n < draw_data->CmdListsCount; ++n) {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        stats.vertices += (unsigned long long)cmd_list->VtxBuffer.Size;
+        stats.indices  += (unsigned long long)cmd_list->IdxBuffer.Size;
+        stats.checksum  = ImHashData(cmd_list->VtxBuffer.Data, (size_t)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert), stats.checksum);
+        for (const ImDrawCmd& cmd : cmd_list->CmdBuffer) {
+            if (cmd.UserCallback) {
+                if (cmd.UserCallback != ImDrawCallback_ResetRenderState)
+                    cmd.UserCallback(cmd_list, &cmd);
+                continue;
+            }
+            if (cmd.ClipRect.z <= cmd.ClipRect.x || cmd.ClipRect.w <= cmd.ClipRect.y) continue;
+            ++stats.draw_cmds;
+        }
+    }
+}
+
+// NOTE(WALKER): Stand-in for the time a real backend spends in the driver, so single threaded vs pipelined can be compared
+static double null_renderer_cost_ms = 0.0;
+static void null_renderer_submit() {
+    const double end = profiler_now_ms() + null_renderer_cost_ms;
+    while (profiler_now_ms() < end) {}
+}
+
+// --pipelined: null_renderer_render() on the render thread, into these stats
+static Render_Pipeline      headless_pipeline;
+static Null_Renderer_Stats* headless_pipeline_stats = nullptr;
+static bool headless_pipeline_attach() { return true; } // no context to take
+static void headless_pipeline_detach() {}
+static void headless_pipeline_render(Draw_Snapshot& snapshot) {
+    null_renderer_render(&snapshot.draw_data, *headless_pipeline_stats);
+    null_renderer_submit();
+}
+
+static bool headless_create_context(const Headless_Options& options, Resume_UI& ui) {
+    allocator_install();
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+    io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;
+    io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
+    io.IniFilename  = nullptr; // reproducible runs, no imgui.ini
+    io.BackendPlatformName = "headless";
+    io.BackendRendererName = "null";
+    io.DisplaySize  = ImVec2((float)options.width, (float)options.height);
+    resume_ui_setup_style();
+
+    // Same font sizing rule as resume.cpp, the display size is our framebuffer
+    fonts_display_size = io.DisplaySize;
+    const float font_size = headless_font_size(io.DisplaySize);
+    if (options.font_pack && !fonts_open_pack(options.font_pack)) {
+        fprintf(stderr, "[headless] can't open the font pack %s\n", options.font_pack);
+        return false;
+    }
+    const bool fonts_ok = options.baked_atlas ? fonts_load_baked(io, options.baked_atlas, options.font_mode, font_size)
+                                              : fonts_load(io, options.font_mode, font_size);
+    if (!fonts_ok) {
+        fprintf(stderr, "[headless] font atlas build failed\n");
+        return false;
+    }
+    fonts_finish_streaming(io); // NOTE(WALKER): Measure the final atlas, not the first-frame one
+
+    ui = Resume_UI();
+    ui.open_link = headless_open_link;
+    if (!resume_ui_init(ui, options.content_path))
+        fprintf(stderr, "[headless] no content (%s), running with the fallback tab\n", options.content_path);
+    if (options.content_copies > 1 && ui.content.header) {
+        Content repeated;
+        if (!content_load_repeated(repeated, ui.content, options.content_copies)) {
+            fprintf(stderr, "[headless] can't repeat the content %d times\n", options.content_copies);
+            return false;
+        }
+        content_free(ui.content);
+        ui.content = repeated;
+        search_index_build(ui.search.index, ui.content);
+    }
+    content_view_stats.enabled = options.virtualize;
+    return true;
+}
+
+static void headless_destroy_context(Resume_UI& ui) {
+    resume_ui_shutdown(ui);
+    fonts_shutdown();
+    ImGui::DestroyContext();
+}
+
+static void headless_frame(Resume_UI& ui, Null_Renderer_Stats& render_stats) {
+    ImGuiIO& io = ImGui::GetIO();
+    const double frame_begin_ms = profiler_now_ms();
+    io.DeltaTime = 1.0f / 60.0f; // fixed timestep, results don't depend on how fast the machine is
+    allocator_new_frame();
+
+    profiler_frame_begin();
+    {
+        // NOTE(WALKER): resume.cpp's display_update() + fonts_update(), minus the texture upload the null renderer doesn't need
+        PROFILE_ZONE("Font streaming");
+        if (io.DisplaySize.x != fonts_display_size.x || io.DisplaySize.y != fonts_display_size.y) {
+            fonts_display_size = io.DisplaySize;
+            fonts_set_display_size(io, headless_font_size(io.DisplaySize));
+        }
+        fonts_update(io);
+    }
+    {
+        PROFILE_ZONE("ImGui::NewFrame");
+        ImGui::NewFrame();
+    }
+    {
+        PROFILE_ZONE("Build UI");
+        resume_ui_frame(ui);
+    }
+    {
+        PROFILE_ZONE("ImGui::Render");
+        ImGui::Render();
+        resume_ui_end_frame(ui, ImGui::GetDrawData());
+    }
+    if (headless_pipeline.running) {
+        render_pipeline_submit(headless_pipeline, ImGui::GetDrawData(), frame_begin_ms, io.FontGlobalScale, 0, 1.0f);
+    } else {
+        PROFILE_ZONE("null_renderer_render");
+        null_renderer_render(ImGui::GetDrawData(), render_stats);
+        null_renderer_submit();
+        render_pipeline_record_single(headless_pipeline, frame_begin_ms, profiler_now_ms());
+    }
+    profiler_frame_end();
+}
+
+// The font atlas as the fragment shader sees it: coverage, or a distance field in SDF mode
+static Soft_Raster_Texture headless_raster_texture() {
+    ImGuiIO& io = ImGui::GetIO();
+    Soft_Raster_Texture texture;
+    unsigned char* pixels = nullptr;
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &texture.width, &texture.height);
+    texture.id        = io.Fonts->TexID;
+    texture.alpha8    = pixels;
+    texture.sdf       = font_state.mode == Font_Mode_SDF;
+    texture.smoothing = fonts_sdf_smoothing(io.FontGlobalScale);
+    return texture;
+}
+
+using bench_clock = std::chrono::steady_clock;
+
+static double elapsed_ms(bench_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+}
+
+static double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    return values[(size_t)(p * (double)(values.size() - 1))];
+}
+
+//-----------------------------------------------------------------------------
+// Plain mode
+//-----------------------------------------------------------------------------
+
+static int run_frames(const Headless_Options& options) {
+    Resume_UI ui;
+    if (!headless_create_context(options, ui)) return 1;
+    ImGuiIO& io = ImGui::GetIO();
+
+    std::vector<double> frame_ms;
+    frame_ms.reserve((size_t)options.frames);
+    Null_Renderer_Stats render_stats;
+    const Allocator_Stats allocs_before = allocator_stats; // not counting the font atlas and content
+    Glyph_Batch       glyph_batch;
+    Glyph_Batch_Stats glyph_frame;
+    Glyph_Batch_Stats glyph_total; // sums over the run
+    double            glyph_ms = 0.0;
+    Soft_Raster       raster;
+    raster.threads = options.raster_threads;
+    Damage_Tracker      damage;
+    Damage_Clip         damage_clip;
+    Soft_Raster         damage_reference; // --damage-check: the same frame drawn in full
+    std::vector<double> damaged;
+    int                 damage_mismatches = 0;
+    damage.enabled = options.damage;
+    damage_reference.threads = options.raster_threads;
+
+    null_renderer_cost_ms = options.render_cost_ms;
+    if (options.pipelined) {
+        headless_pipeline.attach = headless_pipeline_attach;
+        headless_pipeline.detach = headless_pipeline_detach;
+        headless_pipeline.render = headless_pipeline_render;
+        headless_pipeline_stats  = &render_stats;
+        if (!render_pipeline_start(headless_pipeline)) fprintf(stderr, "[headless] no render thread, running single threaded\n");
+    }
+
+    const auto run_start = bench_clock::now();
+    for (int frame = 0; frame < options.frames; ++frame) {
+        const auto start = bench_clock::now();
+        if (options.move_mouse) {
+            const float t = (float)(frame % 600) / 600.0f;
+            io.AddMousePosEvent(t * io.DisplaySize.x, (0.5f + 0.4f * (t - 0.5f)) * io.DisplaySize.y);
+        }
+        headless_frame(ui, render_stats);
+        frame_ms.push_back(elapsed_ms(start));
+        if (options.glyph_batch) { // not part of the frame time above, the stock numbers shouldn't move with it on
+            const auto batch_start = bench_clock::now();
+            glyph_batch_build(glyph_batch, ImGui::GetDrawData(), glyph_frame);
+            glyph_ms += elapsed_ms(batch_start);
+            glyph_total.instances          += glyph_frame.instances;
+            glyph_total.vertices           += glyph_frame.vertices;
+            glyph_total.indices            += glyph_frame.indices;
+            glyph_total.draws              += glyph_frame.draws;
+            glyph_total.overlap_splits     += glyph_frame.overlap_splits;
+            glyph_total.upload_bytes       += glyph_frame.upload_bytes;
+            glyph_total.stock_draws        += glyph_frame.stock_draws;
+            glyph_total.stock_upload_bytes += glyph_frame.stock_upload_bytes;
+        }
+        if (options.damage) {
+            damage_track(damage, ImGui::GetDrawData());
+            damaged.push_back(damage.damaged);
+        }
+        if (options.raster || (options.png_path && frame == options.frames - 1)) { // same, timed on its own
+            ImDrawData* draw_data = ImGui::GetDrawData();
+            const bool partial = options.damage && options.raster && !damage.full;
+            if (partial) { // what resume.cpp does with its offscreen target (damage_target.hpp)
+                for (int i = 0; i < damage.rect_count; ++i)
+                    soft_raster_clear_rect(raster, damage.rects[i].x0, damage.rects[i].y0, damage.rects[i].x1, damage.rects[i].y1);
+                damage_clip_begin(damage_clip, draw_data, damage);
+            }
+            raster.preserve = partial;
+            soft_raster_render(raster, draw_data, headless_raster_texture());
+            if (partial) damage_clip_end(damage_clip, draw_data);
+            if (partial && options.damage_check) {
+                soft_raster_render(damage_reference, draw_data, headless_raster_texture());
+                const Soft_Raster_Diff diff = soft_raster_compare(raster.pixels.Data, damage_reference.pixels.Data, raster.width, raster.height,
+                                                                  damage_reference.width, damage_reference.height, 0);
+                if (!diff.size_matches || diff.differing_pixels) {
+                    if (!damage_mismatches++)
+                        printf("  damage check:   frame %d differs from a full redraw in %d pixels\n", frame, diff.differing_pixels);
+                    raster.preserve = false; // start over from a correct frame
+                    soft_raster_render(raster, draw_data, headless_raster_texture());
+                }
+            }
+        }
+    }
+    render_pipeline_stop(headless_pipeline); // every frame rendered before render_stats is read
+    const double total_ms = elapsed_ms(run_start);
+    const double frames = (double)options.frames;
+
+    printf("resume_headless: %d frames at %dx%d, %s fonts\n", options.frames, options.width, options.height,
+           options.font_mode == Font_Mode_SDF ? "SDF" : "raster");
+    printf("  cpu frame ms:   avg %.4f  p50 %.4f  p95 %.4f  p99 %.4f  max %.4f  (total %.1f ms)\n",
+           total_ms / frames, percentile(frame_ms, 0.50), percentile(frame_ms, 0.95), percentile(frame_ms, 0.99),
+           percentile(frame_ms, 1.0), total_ms);
+    printf("  per frame:      %.1f vertices, %.1f indices, %.1f draw calls\n",
+           (double)render_stats.vertices / frames, (double)render_stats.indices / frames, (double)render_stats.draw_cmds / frames);
+    printf("  allocations:    %.2f per frame (%.2f KB), %llu of %d frames reached malloc, heap peak %.1f KB\n",
+           (double)(allocator_stats.total_allocs - allocs_before.total_allocs) / frames,
+           (double)(allocator_stats.total_bytes - allocs_before.total_bytes) / 1024.0 / frames,
+           allocator_stats.heap_alloc_frames, options.frames, (double)allocator_stats.peak_heap_bytes / 1024.0);
+    printf("  section rows:   %d drawn of %d on the last frame (%s)\n", content_view_stats.rows_drawn, content_view_stats.rows,
+           options.virtualize ? "virtualized" : "not virtualized");
+    if (options.glyph_batch) {
+        printf("  stock upload:   %.1f KB, %.1f draw calls per frame\n",
+               glyph_total.stock_upload_bytes / 1024.0 / frames, glyph_total.stock_draws / frames);
+        printf("  instanced:      %.1f KB, %.1f draw calls per frame (%.1f glyph instances, %.1f triangle vertices, %.1f overlap splits), batched in %.4f ms\n",
+               glyph_total.upload_bytes / 1024.0 / frames, glyph_total.draws / frames, glyph_total.instances / frames,
+               glyph_total.vertices / frames, glyph_total.overlap_splits / frames, glyph_ms / frames);
+    }
+    glyph_batch_free(glyph_batch);
+    if (options.raster) {
+        const double raster_frames = (double)raster.stats.frames;
+        printf("  soft raster:    %.3f ms per frame (last %.3f), %.0f triangles, %.0f pixels filled (%.2fx the framebuffer), %d tiles\n",
+               raster.stats.total_ms / raster_frames, raster.stats.last_ms, raster.stats.triangles / raster_frames,
+               raster.stats.pixels / raster_frames, raster.stats.pixels / raster_frames / ((double)raster.width * raster.height),
+               raster.tiles_x * raster.tiles_y);
+    }
+    int png_failed = 0;
+    if (options.png_path) {
+        if (soft_raster_write_png(options.png_path, raster.pixels.Data, raster.width, raster.height)) {
+            printf("  last frame:     %s\n", options.png_path);
+        } else {
+            fprintf(stderr, "[headless] can't write %s\n", options.png_path);
+            png_failed = 1;
+        }
+    }
+    soft_raster_free(raster);
+    if (options.damage) {
+        const double damage_frames = (double)damage.frames;
+        printf("  damage:         %.2f%% of the screen changed per frame (p50 %.2f%%, p95 %.2f%%), %.2f%% redrawn, tracked in %.4f ms\n",
+               damage.damaged_sum / damage_frames * 100.0, percentile(damaged, 0.50) * 100.0, percentile(damaged, 0.95) * 100.0,
+               damage.redrawn_sum / damage_frames * 100.0, damage.track_ms_sum / damage_frames);
+        printf("                  %llu partial, %llu full (over %.0f%% or invalidated), %llu unchanged frames\n",
+               damage.partial_frames, damage.full_frames, damage.max_fraction * 100.0f, damage.clean_frames);
+        if (options.damage_check && options.raster)
+            printf("  damage check:   %s\n", damage_mismatches ? "FAILED, partial redraws differ from full ones" : "ok, every partial redraw matched a full one");
+    }
+    damage_clip_free(damage_clip);
+    soft_raster_free(damage_reference);
+    const Render_Pipeline_Stats& pipeline = headless_pipeline.stats;
+    if (pipeline.frames) {
+        printf("  pipelined:      latency %.3f ms input to present, %.0f%% of render time overlapped, copy %.4f ms, main waited %.4f ms per frame\n",
+               pipeline.latency_ms / (double)pipeline.frames, pipeline.render_ms > 0.0 ? 100.0 * pipeline.overlap_ms / pipeline.render_ms : 0.0,
+               pipeline.copy_ms / (double)pipeline.frames, pipeline.main_wait_ms / (double)pipeline.frames);
+    } else if (pipeline.single_frames) {
+        printf("  single thread:  latency %.3f ms input to present\n", pipeline.single_latency_ms / (double)pipeline.single_frames);
+    }
+    render_pipeline_free(headless_pipeline);
+    headless_pipeline.stats = Render_Pipeline_Stats();
+    printf("  font atlas:     %dx%d, built in %.1f ms\n", io.Fonts->TexWidth, io.Fonts->TexHeight, font_state.last_build_ms);
+    printf("  checksum:       %08x, %d link(s) opened\n", render_stats.checksum, links_opened);
+
+    if (options.trace_path) {
+        if (profiler_export_chrome_trace(options.trace_path)) printf("  trace:          %s\n", options.trace_path);
+        else fprintf(stderr, "[headless] can't write %s\n", options.trace_path);
+    }
+
+    headless_destroy_context(ui);
+    return png_failed || damage_mismatches ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+// Soak mode
+//-----------------------------------------------------------------------------
+
+// Deterministic, repeating every 1200 frames: mouse sweeps, wheel scrolling both ways and clicks along the tab bar
+static void soak_input(ImGuiIO& io, int frame) {
+    const float t = (float)(frame % 600) / 600.0f;
+    const float x = t * io.DisplaySize.x;
+    if (frame % 150 == 0) {
+        io.AddMousePosEvent(x, 0.07f * io.DisplaySize.y); // tab bar
+        io.AddMouseButtonEvent(ImGuiMouseButton_Left, true);
+    } else if (frame % 150 == 1) {
+        io.AddMouseButtonEvent(ImGuiMouseButton_Left, false);
+    } else {
+        io.AddMousePosEvent(x, (0.5f + 0.4f * (t - 0.5f)) * io.DisplaySize.y);
+    }
+    if (frame % 10 == 0)
+        io.AddMouseWheelEvent(0.0f, (frame / 300) % 2 ? 1.0f : -1.0f);
+}
+
+// NOTE(WALKER): A long session with the heap watched. After a warm-up (every input pattern seen a few times) everything has
+//               to be served from memory the allocator already holds: the run fails if the heap grew past its warm-up peak.
+//               The default is an hour of frames at 60 fps, which takes a small fraction of that headless.
+static int run_soak(const Headless_Options& options) {
+    Resume_UI ui;
+    if (!headless_create_context(options, ui)) return 1;
+    ImGuiIO& io = ImGui::GetIO();
+    Null_Renderer_Stats render_stats;
+
+    const int warmup          = options.frames / 10 < 3600 ? options.frames / 10 : 3600;
+    const int sample_interval = options.frames / 20 > 0 ? options.frames / 20 : 1;
+    size_t warm_peak_heap = 0;
+    unsigned long long malloc_frames = 0;
+
+    printf("resume_headless --soak: %d frames (%.1f minutes at 60 fps), warm-up %d frames\n", options.frames, options.frames / 3600.0, warmup);
+    printf("  %10s %12s %12s %12s %14s\n", "frame", "heap KB", "peak KB", "live KB", "malloc frames");
+    const auto run_start = bench_clock::now();
+    for (int frame = 0; frame < options.frames; ++frame) {
+        soak_input(io, frame);
+        headless_frame(ui, render_stats);
+
+        const Allocator_Stats& s = allocator_stats;
+        if (frame == warmup) warm_peak_heap = s.peak_heap_bytes;
+        if (frame > warmup && s.frame_heap_allocs) ++malloc_frames;
+        if (frame % sample_interval == 0 || frame == options.frames - 1)
+            printf("  %10d %12.1f %12.1f %12.1f %14llu\n", frame, s.heap_bytes / 1024.0, s.peak_heap_bytes / 1024.0, s.live_bytes / 1024.0, malloc_frames);
+    }
+    const double total_ms = elapsed_ms(run_start);
+
+    const Allocator_Stats& s = allocator_stats;
+    const bool grew = s.peak_heap_bytes > warm_peak_heap;
+    printf("  %.1f s, heap peak %.1f KB at warm-up -> %.1f KB at the end, %llu frames after warm-up reached malloc\n",
+           total_ms / 1000.0, warm_peak_heap / 1024.0, s.peak_heap_bytes / 1024.0, malloc_frames);
+    printf("  %s\n", grew ? "FAILED: the heap grew after warm-up" : "OK: no heap growth after warm-up");
+
+    headless_destroy_context(ui);
+    return grew ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+// Glyph emission
+//-----------------------------------------------------------------------------
+
+// NOTE(WALKER): --frames of the plain run first so every paragraph on screen is laid out (text_layout_cache.hpp), then both
+//               emission paths over all of those quads. Fails if they don't write the same bytes.
+static int run_emit_bench(const Headless_Options& options) {
+    Resume_UI ui;
+    if (!headless_create_context(options, ui)) return 1;
+    Null_Renderer_Stats render_stats;
+    for (int frame = 0; frame < options.frames; ++frame)
+        headless_frame(ui, render_stats);
+
+    ImVector<Glyph_Quad> quads;
+    text_layout_cache_collect_quads(quads);
+    const Glyph_Emit_Bench b = glyph_emit_bench(quads.Data, quads.Size, options.emit_passes);
+    printf("resume_headless --emit-bench %d: %d glyph quads from %d frames at %dx%d, SIMD path: %s\n", options.emit_passes, b.quads,
+           options.frames, options.width, options.height, glyph_emit_simd_name());
+    printf("  scalar:         %.3f ns/quad (%.4f ms for all of them)\n", b.scalar_ns, b.scalar_ns * b.quads / 1e6);
+    printf("  simd:           %.3f ns/quad (%.4f ms for all of them), %.2fx\n", b.simd_ns, b.simd_ns * b.quads / 1e6,
+           b.simd_ns > 0.0 ? b.scalar_ns / b.simd_ns : 0.0);
+    const bool ok = b.quads > 0 && b.identical;
+    printf("%s\n", ok ? "ok: both paths wrote the same vertices and indices" : b.quads ? "FAILED: the SIMD path wrote different bytes" : "FAILED: no text laid out");
+
+    headless_destroy_context(ui);
+    return ok ? 0 : 1;
+}
+
+//-----------------------------------------------------------------------------
+// Bench mode
+//-----------------------------------------------------------------------------
+
+// Per frame averages, the same columns as the baseline file
+struct Bench_Result {
+    std::string name;
+    int         frames   = 0;
+    double      cpu_ms   = 0.0;
+    double      cpu_p95  = 0.0;
+    double      vertices = 0.0;
+    double      indices  = 0.0;
+    double      draws    = 0.0;
+    double      allocs   = 0.0;
+    double      alloc_kb = 0.0;
+    double      heap     = 0.0; // allocations that reached malloc
+    double      raster_ms = 0.0; // --raster: soft_raster_render(), 0 when off
+    double      fill_kpx  = 0.0; // thousands of pixels blended
+    bool        golden_compared = false; // --golden: the last frame was held against an image (matching or not)
+    bool        failed   = false;
+    std::string error;
+};
+
+// NOTE(WALKER): The last frame of a scenario against <dir>/<scenario>.png. A few pixels may differ by more than the tolerance
+//               (a glyph edge rounding the other way on another compiler), a fraction past golden_max_diff fails the scenario and
+//               the frame is written next to the golden as <scenario>.actual.png to look at. A scenario with no golden image fails
+//               too: `make golden-images` writes them, commit them with any change that's meant to draw differently.
+static void check_golden(const Headless_Options& options, Bench_Result& result, const Soft_Raster& raster) {
+    char path[512];
+    if (options.write_golden_dir) {
+        snprintf(path, sizeof(path), "%s/%s.png", options.write_golden_dir, result.name.c_str());
+        if (!soft_raster_write_png(path, raster.pixels.Data, raster.width, raster.height)) {
+            result.failed = true;
+            result.error  = std::string("can't write ") + path;
+        }
+    }
+    if (!options.golden_dir) return;
+
+    snprintf(path, sizeof(path), "%s/%s.png", options.golden_dir, result.name.c_str());
+    ImVector<ImU32> golden;
+    int width = 0, height = 0;
+    if (!soft_raster_read_png(path, golden, width, height)) {
+        result.failed = true;
+        result.error  = std::string("no golden image ") + path + " (make golden-images)";
+        return;
+    }
+    result.golden_compared = true;
+    const Soft_Raster_Diff diff = soft_raster_compare(raster.pixels.Data, golden.Data, raster.width, raster.height, width, height, options.golden_tolerance);
+    char error[256] = "";
+    if (!diff.size_matches)
+        snprintf(error, sizeof(error), "frame is %dx%d, %s is %dx%d", raster.width, raster.height, path, width, height);
+    else if (diff.differing_ratio > options.golden_max_diff)
+        snprintf(error, sizeof(error), "%d pixels (%.3f%%) differ from %s by more than %d, up to %d", diff.differing_pixels,
+                 diff.differing_ratio * 100.0f, path, options.golden_tolerance, diff.max_channel_diff);
+    if (!error[0]) return;
+    result.failed = true;
+    result.error  = error;
+    snprintf(path, sizeof(path), "%s/%s.actual.png", options.golden_dir, result.name.c_str());
+    if (soft_raster_write_png(path, raster.pixels.Data, raster.width, raster.height)) result.error += std::string(", frame written to ") + path;
+}
+
+static Bench_Result run_scenario(const Headless_Options& options, const Script_Scenario& scenario) {
+    Bench_Result result;
+    result.name = scenario.name;
+
+    Resume_UI ui;
+    if (!headless_create_context(options, ui)) {
+        result.failed = true;
+        result.error  = "context creation failed";
+        return result;
+    }
+    ImGuiIO& io = ImGui::GetIO();
+
+    Script_Player player;
+    script_player_start(player, scenario);
+    Null_Renderer_Stats render_stats;
+    std::vector<double> frame_ms;
+    const Allocator_Stats allocs_before = allocator_stats;
+    Soft_Raster raster;
+    raster.threads = options.raster_threads;
+
+    // NOTE(WALKER): Feeding input is part of the frame on a real platform too (event callbacks), so it's timed
+    for (;;) {
+        const auto start = bench_clock::now();
+        if (!script_player_feed(player, io)) break;
+        headless_frame(ui, render_stats);
+        frame_ms.push_back(elapsed_ms(start));
+        if (options.raster) soft_raster_render(raster, ImGui::GetDrawData(), headless_raster_texture());
+    }
+
+    result.frames = (int)frame_ms.size();
+    result.failed = player.failed;
+    result.error  = player.error;
+    if (result.frames > 0) {
+        const double frames = (double)result.frames;
+        double total = 0.0;
+        for (double ms : frame_ms) total += ms;
+        result.cpu_ms   = total / frames;
+        result.cpu_p95  = percentile(frame_ms, 0.95);
+        result.vertices = (double)render_stats.vertices / frames;
+        result.indices  = (double)render_stats.indices / frames;
+        result.draws    = (double)render_stats.draw_cmds / frames;
+        result.allocs   = (double)(allocator_stats.total_allocs - allocs_before.total_allocs) / frames;
+        result.alloc_kb = (double)(allocator_stats.total_bytes - allocs_before.total_bytes) / 1024.0 / frames;
+        result.heap     = (double)(allocator_stats.total_heap_allocs - allocs_before.total_heap_allocs) / frames;
+        if (raster.stats.frames) {
+            result.raster_ms = raster.stats.total_ms / (double)raster.stats.frames;
+            result.fill_kpx  = (double)raster.stats.pixels / 1000.0 / (double)raster.stats.frames;
+        }
+    }
+    if (raster.stats.frames && !result.failed) check_golden(options, result, raster);
+
+    soft_raster_free(raster);
+    headless_destroy_context(ui);
+    return result;
+}
+
+static bool write_baseline(const char* path, const std::vector<Bench_Result>& results) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    fprintf(f, "# resume_headless --bench baseline (make bench-baseline), per frame averages\n");
+    fprintf(f, "# scenario frames cpu_ms vertices indices draw_calls allocations alloc_kb heap_allocs raster_ms fill_kpx\n");
+    for (const Bench_Result& r : results)
+        if (!r.failed)
+            fprintf(f, "%s %d %.4f %.1f %.1f %.2f %.2f %.3f %.3f %.4f %.1f\n", r.name.c_str(), r.frames, r.cpu_ms, r.vertices, r.indices, r.draws,
+                    r.allocs, r.alloc_kb, r.heap, r.raster_ms, r.fill_kpx);
+    fclose(f);
+    return true;
+}
+
+static bool read_baseline(const char* path, std::vector<Bench_Result>& baseline) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+        char name[256];
+        Bench_Result r;
+        // The two raster columns are optional, older baselines don't have them
+        if (sscanf(line, "%255s %d %lf %lf %lf %lf %lf %lf %lf %lf %lf", name, &r.frames, &r.cpu_ms, &r.vertices, &r.indices, &r.draws,
+                   &r.allocs, &r.alloc_kb, &r.heap, &r.raster_ms, &r.fill_kpx) >= 9) {
+            r.name = name;
+            baseline.push_back(r);
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+// Prints one line per metric that got worse, returns how many did
+static int compare_to_baseline(const Bench_Result& r, const Bench_Result& base, const Headless_Options& options) {
+    int regressions = 0;
+    auto check = [&](const char* metric, double current, double baseline, double tolerance) {
+        const double limit = baseline * (1.0 + tolerance) + 0.5; // + 0.5 so tiny counts (0 -> 1) don't need a percentage of nothing
+        if (current > limit) {
+            printf("  REGRESSION %-24s %-12s %.3f -> %.3f (limit %.3f)\n", r.name.c_str(), metric, baseline, current, limit);
+            ++regressions;
+        }
+    };
+    if (r.frames != base.frames)
+        printf("  note: %s ran %d frames, the baseline has %d (script changed? re-run make bench-baseline)\n", r.name.c_str(), r.frames, base.frames);
+    check("cpu_ms",      r.cpu_ms,   base.cpu_ms,   options.time_tolerance);
+    check("vertices",    r.vertices, base.vertices, options.count_tolerance);
+    check("indices",     r.indices,  base.indices,  options.count_tolerance);
+    check("draw_calls",  r.draws,    base.draws,    options.count_tolerance);
+    check("allocations", r.allocs,   base.allocs,   options.count_tolerance);
+    check("alloc_kb",    r.alloc_kb, base.alloc_kb, options.count_tolerance);
+    check("heap_allocs", r.heap,     base.heap,     options.count_tolerance);
+    if (r.raster_ms > 0.0 && base.raster_ms > 0.0) { // both runs rasterized
+        check("raster_ms", r.raster_ms, base.raster_ms, options.time_tolerance);
+        check("fill_kpx",  r.fill_kpx,  base.fill_kpx,  options.count_tolerance);
+    }
+    return regressions;
+}
+
+static int run_bench(const Headless_Options& options) {
+    // Key names need a context to parse the script
+    ImGui::CreateContext();
+    Input_Script script;
+    const bool loaded = input_script_load(script, options.bench_path);
+    const bool hooks  = script_items_enable();
+    ImGui::DestroyContext();
+    if (!loaded) return 1;
+    if (!hooks)
+        fprintf(stderr, "[bench] built without IMGUI_ENABLE_TEST_ENGINE, move/click steps can't find items\n");
+
+    printf("resume_headless --bench %s: %d scenario(s) at %dx%d\n", options.bench_path, (int)script.scenarios.size(), options.width, options.height);
+    printf("  %-24s %6s %9s %9s %10s %10s %8s %8s %9s %7s", "scenario", "frames", "cpu ms", "p95 ms", "vertices", "indices", "draws", "allocs", "alloc KB", "malloc");
+    if (options.raster) printf(" %9s %9s", "raster ms", "fill kpx");
+    printf("\n");
+    std::vector<Bench_Result> results;
+    int failures = 0, golden_compared = 0;
+    for (const Script_Scenario& scenario : script.scenarios) {
+        const Bench_Result r = run_scenario(options, scenario);
+        printf("  %-24s %6d %9.4f %9.4f %10.1f %10.1f %8.2f %8.2f %9.3f %7.3f", r.name.c_str(), r.frames, r.cpu_ms, r.cpu_p95,
+               r.vertices, r.indices, r.draws, r.allocs, r.alloc_kb, r.heap);
+        if (options.raster) printf(" %9.3f %9.1f", r.raster_ms, r.fill_kpx);
+        printf("%s\n", r.failed ? "  FAILED" : "");
+        if (r.failed) {
+            printf("    %s: %s\n", options.bench_path, r.error.c_str());
+            ++failures;
+        }
+        golden_compared += r.golden_compared ? 1 : 0;
+        results.push_back(r);
+    }
+    if (options.golden_dir) {
+        printf("%d of %d scenario(s) compared with the golden images in %s\n", golden_compared, (int)results.size(), options.golden_dir);
+        if (!golden_compared) ++failures; // a golden run that compared nothing checked nothing
+    }
+
+    if (options.write_baseline) {
+        if (!write_baseline(options.write_baseline, results)) {
+            fprintf(stderr, "[bench] can't write %s\n", options.write_baseline);
+            return 1;
+        }
+        printf("baseline written to %s\n", options.write_baseline);
+    }
+
+    int regressions = 0;
+    if (options.baseline_path) {
+        std::vector<Bench_Result> baseline;
+        if (!read_baseline(options.baseline_path, baseline)) {
+            fprintf(stderr, "[bench] can't read baseline %s\n", options.baseline_path);
+            return 1;
+        }
+        for (const Bench_Result& r : results) {
+            if (r.failed) continue;
+            const Bench_Result* base = nullptr;
+            for (const Bench_Result& b : baseline)
+                if (b.name == r.name) base = &b;
+            if (!base) { printf("  note: %s is not in the baseline\n", r.name.c_str()); continue; }
+            regressions += compare_to_baseline(r, *base, options);
+        }
+        printf("%d regression(s) against %s (cpu +%.0f%%, counts +%.0f%% allowed)\n", regressions, options.baseline_path,
+               options.time_tolerance * 100.0f, options.count_tolerance * 100.0f);
+    }
+    return failures || regressions ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+// Search benchmark
+//-----------------------------------------------------------------------------
+
+// Typed one character at a time, like the search box sees them: every prefix is a query
+static const char* SEARCH_BENCH_QUERIES[] = {
+    "C++", "golang", "distributed", "python", "embedded linux", "Jai", "networking c++", "kubernetes", "a", "zzzz",
+};
+
+// NOTE(WALKER): No ImGui context needed, the index and queries only touch the content buffer and ImVector.
+//               The real content is far too small to time, so it is repeated (content_load_repeated()) to get postings lists
+//               and node counts a much bigger resume would have. Fails when the p99 keystroke is over the budget.
+static int run_search_bench(const Headless_Options& options) {
+    Content base, content;
+    if (!content_load_file(base, options.content_path)) return 1;
+    const bool repeated = content_load_repeated(content, base, options.search_copies);
+    content_free(base);
+    if (!repeated) {
+        fprintf(stderr, "[search-bench] can't repeat the content %d times\n", options.search_copies);
+        return 1;
+    }
+
+    Search search;
+    search_index_build(search.index, content);
+    printf("resume_headless --search-bench %d: %u nodes, %u spans\n", options.search_copies, content.header->node_count, content.header->span_count);
+    printf("  index:          %d terms, %d postings, built in %.2f ms\n", search.index.terms.Size, search.index.postings.Size, search.index.build_ms);
+
+    constexpr int passes = 20;
+    std::vector<double> keystroke_ms;
+    unsigned long long matches = 0;
+    char query[SEARCH_MAX_QUERY];
+    for (int pass = 0; pass < passes; ++pass) {
+        for (const char* typed : SEARCH_BENCH_QUERIES) {
+            const size_t length = strlen(typed);
+            for (size_t n = 1; n <= length; ++n) {
+                memcpy(query, typed, n);
+                query[n] = '\0';
+                const auto start = bench_clock::now();
+                search_run(search, content, query);
+                keystroke_ms.push_back(elapsed_ms(start));
+                matches += (unsigned long long)search.total_matches;
+            }
+            search_run(search, content, ""); // cleared between queries, like Escape
+        }
+    }
+
+    const double p99 = percentile(keystroke_ms, 0.99);
+    double total = 0.0;
+    for (double ms : keystroke_ms) total += ms;
+    printf("  keystroke ms:   avg %.4f  p50 %.4f  p99 %.4f  max %.4f  (%zu keystrokes)\n", total / (double)keystroke_ms.size(),
+           percentile(keystroke_ms, 0.50), p99, percentile(keystroke_ms, 1.0), keystroke_ms.size());
+    printf("  matches:        %llu total over all keystrokes\n", matches);
+    const bool ok = p99 <= options.search_budget_ms;
+    printf("%s: p99 %.4f ms against a %.2f ms budget\n", ok ? "ok" : "FAILED", p99, options.search_budget_ms);
+
+    search_free(search);
+    content_free(content);
+    return ok ? 0 : 1;
+}
+
+//-----------------------------------------------------------------------------
+// Render scale controller
+//-----------------------------------------------------------------------------
+
+// A display and a UI whose full resolution frame takes work_ms to draw; drawing scales with the pixels (scale squared)
+struct Render_Scale_Case {
+    const char* name;
+    double      refresh_ms;
+    double      work_ms;
+    double      throttled_ms; // the refresh after the first sixth of the frames (requestAnimationFrame throttled), 0 = none
+};
+
+static const Render_Scale_Case RENDER_SCALE_CASES[] = {
+    {"60 Hz, light",                 1000.0 / 60.0,   8.0, 0.0},
+    {"60 Hz, 20 ms",                 1000.0 / 60.0,  20.0, 0.0},
+    {"60 Hz, 30 ms",                 1000.0 / 60.0,  30.0, 0.0}, // 0.875 and 0.75 both still miss every other vsync
+    {"60 Hz, 40 ms",                 1000.0 / 60.0,  40.0, 0.0},
+    {"60 Hz, 80 ms",                 1000.0 / 60.0,  80.0, 0.0}, // nothing fits, the floor doesn't beat 0.625
+    {"50 Hz, light",                 1000.0 / 50.0,   8.0, 0.0},
+    {"50 Hz, 30 ms",                 1000.0 / 50.0,  30.0, 0.0},
+    {"120 Hz, 12 ms",                1000.0 / 120.0, 12.0, 0.0},
+    {"30 Hz throttle, light",        1000.0 / 30.0,   8.0, 0.0},
+    {"30 Hz throttle, 40 ms",        1000.0 / 30.0,  40.0, 0.0},
+    {"60 Hz, throttled to 30 Hz",    1000.0 / 60.0,  14.0, 1000.0 / 30.0},
+};
+
+// Vsync: the frame is shown on the first refresh after it's drawn
+static double render_scale_case_interval(double refresh_ms, double work_ms, float scale) {
+    const double drawn = work_ms * (double)scale * (double)scale;
+    const double refreshes = ceil(drawn / refresh_ms - 1e-9);
+    return (refreshes > 1.0 ? refreshes : 1.0) * refresh_ms;
+}
+
+// NOTE(WALKER): The scale the controller should settle on: the largest step whose interval fits the budget on this refresh
+//               (never tighter than 60 Hz, like the controller's), or when none does, the largest one as fast as the floor
+static float render_scale_case_expected(const Render_Scale& rs, double refresh_ms, double work_ms) {
+    const double refresh = refresh_ms > 1000.0 / 60.0 ? refresh_ms : 1000.0 / 60.0;
+    const double floor_interval = render_scale_case_interval(refresh_ms, work_ms, rs.floor);
+    const double limit = refresh * rs.budget_factor > floor_interval ? refresh * rs.budget_factor : floor_interval;
+    for (float scale = 1.0f; scale > rs.floor; scale -= rs.step)
+        if (render_scale_case_interval(refresh_ms, work_ms, scale) <= limit) return scale;
+    return rs.floor;
+}
+
+// NOTE(WALKER): No ImGui context and no GL: feeds render_scale_frame() (render_scale.hpp) the intervals a vsynced display would
+//               give each case at DPR 2, with a deterministic +-0.5 ms of jitter, and checks the scale it spends most of the last
+//               quarter of the run at (a probe up can be in flight when the run ends) is the one that fits the budget.
+static int run_render_scale_check() {
+    constexpr int   frames = 6000;
+    constexpr float device_pixel_ratio = 2.0f;
+    constexpr int   steps = 9; // 1.0 down to the floor of 0.5 in 0.125 steps, and one spare
+    int failed = 0;
+    printf("resume_headless --render-scale-check: %d frames per case at devicePixelRatio %.0f\n", frames, device_pixel_ratio);
+    printf("  %-28s %8s %8s %6s %6s %6s %10s\n", "case", "expected", "settled", "drops", "raises", "futile", "refresh ms");
+    for (const Render_Scale_Case& c : RENDER_SCALE_CASES) {
+        Render_Scale rs;
+        rs.available = true;
+        rs.log       = false;
+        double   now_ms = 1000.0;
+        unsigned seed   = 1;
+        int      held[steps] = {};
+        for (int frame = 0; frame < frames; ++frame) {
+            const float scale = render_scale_frame(rs, now_ms, true, device_pixel_ratio);
+            if (frame >= frames - frames / 4) ++held[(int)((1.0f - scale) / rs.step + 0.5f)];
+            const double refresh_ms = c.throttled_ms > 0.0 && frame >= frames / 6 ? c.throttled_ms : c.refresh_ms;
+            seed = seed * 1103515245u + 12345u;
+            const double jitter = (double)((seed >> 16) % 1000) / 1000.0 - 0.5;
+            now_ms += render_scale_case_interval(refresh_ms, c.work_ms, scale) + jitter;
+        }
+        int most = 0;
+        for (int i = 1; i < steps; ++i)
+            if (held[i] > held[most]) most = i;
+        const float settled  = 1.0f - (float)most * rs.step;
+        const float expected = render_scale_case_expected(rs, c.throttled_ms > 0.0 ? c.throttled_ms : c.refresh_ms, c.work_ms);
+        const bool  ok       = settled == expected;
+        if (!ok) ++failed;
+        printf("  %-28s %8.3f %8.3f %6llu %6llu %6llu %10.2f%s\n", c.name, expected, settled, rs.drops, rs.raises, rs.futile,
+               rs.refresh_ms, ok ? "" : "  <- FAILED");
+    }
+    const int cases = (int)(sizeof(RENDER_SCALE_CASES) / sizeof(RENDER_SCALE_CASES[0]));
+    printf("%s: %d of %d cases settled on the scale that fits the budget\n", failed ? "FAILED" : "ok", cases - failed, cases);
+    return failed ? 1 : 0;
+}
+
+static bool parse_options(int argc, char** argv, Headless_Options& o) {
+    bool frames_set = false;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg  = argv[i];
+        const char* next = i + 1 < argc ? argv[i + 1] : nullptr;
+        if      (!strcmp(arg, "--frames")  && next) { o.frames = atoi(next); ++i; }
+        else if (!strcmp(arg, "--width")   && next) { o.width  = atoi(next); ++i; }
+        else if (!strcmp(arg, "--height")  && next) { o.height = atoi(next); ++i; }
+        else if (!strcmp(arg, "--content") && next) { o.content_path = next; ++i; }
+        else if (!strcmp(arg, "--fonts")   && next) {
+            if      (!strcmp(next, "sdf"))    o.font_mode = Font_Mode_SDF;
+            else if (!strcmp(next, "raster")) o.font_mode = Font_Mode_Raster;
+            else return false;
+            ++i;
+        }
+        else if (!strcmp(arg, "--baked-atlas")     && next) { o.baked_atlas = next; ++i; }
+        else if (!strcmp(arg, "--font-pack")       && next) { o.font_pack = next; ++i; }
+        else if (!strcmp(arg, "--trace")           && next) { o.trace_path = next; ++i; }
+        else if (!strcmp(arg, "--bench")           && next) { o.bench_path = next; ++i; }
+        else if (!strcmp(arg, "--baseline")        && next) { o.baseline_path = next; ++i; }
+        else if (!strcmp(arg, "--write-baseline")  && next) { o.write_baseline = next; ++i; }
+        else if (!strcmp(arg, "--time-tolerance")  && next) { o.time_tolerance = (float)atof(next); ++i; }
+        else if (!strcmp(arg, "--count-tolerance") && next) { o.count_tolerance = (float)atof(next); ++i; }
+        else if (!strcmp(arg, "--search-bench")    && next) { o.search_copies = atoi(next); ++i; if (o.search_copies < 1) return false; }
+        else if (!strcmp(arg, "--search-budget-ms") && next) { o.search_budget_ms = (float)atof(next); ++i; }
+        else if (!strcmp(arg, "--emit-bench")      && next) { o.emit_passes = atoi(next); ++i; if (o.emit_passes < 1) return false; }
+        else if (!strcmp(arg, "--render-scale-check")) { o.render_scale_check = true; }
+        else if (!strcmp(arg, "--content-copies")  && next) { o.content_copies = atoi(next); ++i; if (o.content_copies < 1) return false; }
+        else if (!strcmp(arg, "--no-virtualize")) { o.virtualize = false; }
+        else if (!strcmp(arg, "--glyph-batch"))   { o.glyph_batch = true; }
+        else if (!strcmp(arg, "--pipelined"))     { o.pipelined = true; }
+        else if (!strcmp(arg, "--render-cost-ms")  && next) { o.render_cost_ms = atof(next); ++i; }
+        else if (!strcmp(arg, "--raster"))        { o.raster = true; }
+        else if (!strcmp(arg, "--raster-threads")  && next) { o.raster_threads = atoi(next); ++i; }
+        else if (!strcmp(arg, "--png")             && next) { o.png_path = next; ++i; }
+        else if (!strcmp(arg, "--damage"))        { o.damage = true; }
+        else if (!strcmp(arg, "--damage-check"))  { o.damage = o.damage_check = o.raster = true; }
+        else if (!strcmp(arg, "--golden")          && next) { o.golden_dir = next; o.raster = true; ++i; }
+        else if (!strcmp(arg, "--write-golden")    && next) { o.write_golden_dir = next; o.raster = true; ++i; }
+        else if (!strcmp(arg, "--golden-tolerance") && next) { o.golden_tolerance = atoi(next); ++i; }
+        else if (!strcmp(arg, "--golden-max-diff")  && next) { o.golden_max_diff = (float)atof(next); ++i; }
+        else if (!strcmp(arg, "--move-mouse")) { o.move_mouse = true; }
+        else if (!strcmp(arg, "--soak"))       { o.soak = true; if (!frames_set) o.frames = 60 * 60 * 60; }
+        else return false;
+        if (!strcmp(arg, "--frames")) frames_set = true;
+    }
+    return o.frames > 0 && o.width > 0 && o.height > 0;
+}
+
+int main(int argc, char** argv) {
+    Headless_Options options;
+    if (!parse_options(argc, argv, options)) {
+        fprintf(stderr,
+            "usage: resume_headless [--frames N] [--width W] [--height H] [--content path] [--content-copies N] [--no-virtualize] [--fonts sdf|raster]\n"
+            "                       [--baked-atlas file] [--font-pack file] [--move-mouse] [--trace out.json] [--glyph-batch]\n"
+            "                       [--pipelined] [--render-cost-ms 2] [--raster] [--raster-threads N] [--png out.png] [--damage] [--damage-check]\n"
+            "       resume_headless --soak [--frames N]\n"
+            "       resume_headless --bench script.txt [--baseline file] [--write-baseline file] [--time-tolerance 0.30] [--count-tolerance 0.02]\n"
+            "                       [--raster] [--raster-threads N] [--golden dir] [--write-golden dir] [--golden-tolerance 2] [--golden-max-diff 0.001]\n"
+            "       resume_headless --search-bench copies [--search-budget-ms 1.0]\n"
+            "       resume_headless --emit-bench passes [--frames N] [--width W] [--height H]\n"
+            "       resume_headless --render-scale-check\n");
+        return 1;
+    }
+    if (options.bench_path)    return run_bench(options);
+    if (options.search_copies) return run_search_bench(options);
+    if (options.emit_passes)   return run_emit_bench(options);
+    if (options.render_scale_check) return run_render_scale_check();
+    if (options.soak)       return run_soak(options);
+    return run_frames(options);
+}
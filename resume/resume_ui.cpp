@@ -0,0 +1,111 @@
+#include "resume_ui.hpp"
+
+#include "imgui.h"
+
+#include "../Utilities/defer.hpp"
+#include "fonts.hpp"
+#include "text_layout_cache.hpp"
+#include "retained_draw.hpp"
+#include "profiler.hpp"
+#include "allocator.hpp"
+#include "style_module.hpp"
+
+void resume_ui_setup_style() {
+    ImGuiIO& io = ImGui::GetIO();
+
+    ImGui::StyleColorsDark();
+    ImGuiStyle& style = ImGui::GetStyle();
+    // Rounding:
+    style.WindowRounding = 0.0f;
+    style.ChildRounding = 6.0f;
+    style.FrameRounding = 6.0f;
+    style.PopupRounding = 6.0f;
+    style.ScrollbarRounding = 6.0f;
+    style.GrabRounding = 6.0f;
+    style.TabRounding = 12.0f;
+
+    // When viewports are enabled we tweak WindowRounding/WindowBg so platform windows can look identical to regular ones.
+    if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
+        style.WindowRounding = 0.0f;
+        style.Colors[ImGuiCol_WindowBg].w = 1.0f;
+    }
+}
+
+bool resume_ui_init(Resume_UI& ui, const char* content_path) {
+    // NOTE(WALKER): All the resume text/links live in content/resume.txt, compiled by tools/content_compiler (see Makefile)
+    if (!content_load_file(ui.content, content_path)) return false;
+    search_index_build(ui.search.index, ui.content);
+    return true;
+}
+
+void resume_ui_shutdown(Resume_UI& ui) {
+    search_free(ui.search);
+    content_free(ui.content);
+    content_view_clear();
+    text_layout_cache_clear();
+    retained_draw_clear();
+}
+
+void resume_ui_frame(Resume_UI& ui) {
+    text_layout_cache_new_frame();
+
+    {
+        const ImGuiViewport* viewport = ImGui::GetMainViewport();
+        ImGui::SetNextWindowPos(viewport->WorkPos);
+        ImGui::SetNextWindowSize(viewport->WorkSize);
+
+        ImGuiWindowFlags window_flags = 0;
+        // window_flags |= ImGuiWindowFlags_NoTitleBar;
+        window_flags |= ImGuiWindowFlags_NoMove;
+        window_flags |= ImGuiWindowFlags_NoResize;
+        window_flags |= ImGuiWindowFlags_NoCollapse;
+        window_flags |= ImGuiWindowFlags_MenuBar;
+        ImGui::Begin("Walker Williams Resume (Written in C++)", nullptr, window_flags);
+        defer { ImGui::End(); };
+
+        // Menu bar:
+        if (ImGui::BeginMenuBar()) {
+            defer { ImGui::EndMenuBar(); };
+            // Style editor (from the demo window, loaded on first use on the web, see style_module.hpp):
+            if (ImGui::BeginMenu("Style")) {
+                defer { ImGui::EndMenu(); };
+                style_module_show_editor(ui.request_frames);
+            }
+            ImGui::MenuItem("Profiler", nullptr, &profiler.show_overlay);
+            if (ImGui::BeginMenu("Performance")) {
+                defer { ImGui::EndMenu(); };
+                if (ui.platform_menu) {
+                    ui.platform_menu();
+                    ImGui::Separator();
+                }
+                fonts_show_menu();
+                ImGui::Separator();
+                text_layout_cache_show_menu();
+                ImGui::Separator();
+                content_view_show_menu();
+                ImGui::Separator();
+                retained_draw_show_menu();
+                ImGui::Separator();
+                allocator_show_menu();
+                ImGui::Separator();
+                search_show_menu(ui.search);
+                ImGui::Separator();
+                style_module_show_menu();
+            }
+            search_show_box(ui.search, ui.content);
+        }
+
+        // Sections:
+        if (ImGui::BeginTabBar("Sections")) {
+            defer { ImGui::EndTabBar(); };
+            content_draw_tab_items(ui.content, ui.open_link, &ui.search);
+        }
+    }
+
+    profiler_show_overlay();
+}
+
+void resume_ui_end_frame(Resume_UI&, ImDrawData* draw_data) {
+    retained_draw_end_frame(draw_data);
+    content_view_end_frame();
+}
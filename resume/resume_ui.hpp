@@ -0,0 +1,32 @@
+// NOTE(WALKER): The resume UI itself, with no idea what platform or renderer it runs on.
+//               resume.cpp (emscripten + GLFW + WebGL) and resume_headless.cpp (no window, no GL, for benchmarking/profiling)
+//               both create the ImGui context, then drive this between their own NewFrame()/Render() calls.
+//               Anything platform specific comes in through the hooks below.
+
+#pragma once
+
+#include "imgui.h"
+#include "content.hpp"
+#include "search.hpp"
+
+struct Resume_UI {
+    Content content;
+    Search  search;   // index built in resume_ui_init()
+
+    // Platform hooks, all optional
+    void (*open_link)(const char* url) = nullptr; // inline link buttons, window.open() on the web
+    void (*platform_menu)()            = nullptr; // extra items at the top of the "Performance" menu (e.g. frame pacing)
+    void (*request_frames)()           = nullptr; // async work finished (e.g. the style module loaded), render again
+};
+
+// After ImGui::CreateContext() and setting io.ConfigFlags
+void resume_ui_setup_style();
+
+bool resume_ui_init(Resume_UI& ui, const char* content_path);
+void resume_ui_shutdown(Resume_UI& ui);
+
+// Between ImGui::NewFrame() and ImGui::Render()
+void resume_ui_frame(Resume_UI& ui);
+
+// After ImGui::Render(), before handing the draw data to a renderer
+void resume_ui_end_frame(Resume_UI& ui, ImDrawData* draw_data);
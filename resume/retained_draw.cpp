@@ -0,0 +1,235 @@
+#include "retained_draw.hpp"
+#include "fonts.hpp"
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <string.h>
+
+Retained_Draw_Stats retained_draw_stats;
+
+struct Retained_Item {
+    ImGuiID id;
+    ImRect  rect;
+};
+
+struct Retained_Entry {
+    ImGuiID                 window_id = 0;
+    ImGuiID                 key       = 0;
+    bool                    valid     = false;
+    ImDrawCmdHeader         header;         // draw list state the geometry was recorded under
+    ImVector<ImDrawVert>    vtx;
+    ImVector<ImDrawIdx>     idx;            // rebased to 0
+    ImVector<Retained_Item> items;          // hover targets
+    ImVec2                  cursor_pos;     // layout state at the end of the content, restored on replay
+    ImVec2                  cursor_max_pos;
+    ImVec2                  ideal_max_pos;
+    ImVec2                  cursor_pos_prev_line;
+    ImVec2                  prev_line_size;
+};
+
+struct Retained_Recording {
+    Retained_Entry* entry     = nullptr;
+    ImGuiWindow*    window    = nullptr;
+    ImGuiID         extra_key = 0;
+    int             vtx_start = 0;
+    int             idx_start = 0;
+    int             cmd_count = 0;
+    unsigned int    vtx_current_start = 0;
+    bool            cachable  = false;
+};
+
+static ImVector<Retained_Entry*> entries;
+static ImGuiStorage              entry_index; // child window id -> Retained_Entry*
+static Retained_Recording        recording;
+
+static Retained_Entry* find_entry(ImGuiID window_id) {
+    Retained_Entry* e = (Retained_Entry*)entry_index.GetVoidPtr(window_id);
+    if (!e) {
+        e = IM_NEW(Retained_Entry)();
+        e->window_id = window_id;
+        entries.push_back(e);
+        entry_index.SetVoidPtr(window_id, e);
+    }
+    return e;
+}
+
+// Anything that needs the real widgets to run this frame
+static bool interaction_pending(const ImGuiContext& g, const ImGuiWindow* window) {
+    const ImGuiIO& io = g.IO;
+    for (int i = 0; i < IM_ARRAYSIZE(io.MouseDown); ++i)
+        if (io.MouseDown[i] || io.MouseReleased[i]) return true;
+    if (g.ActiveId != 0 || io.WantTextInput || g.MovingWindow) return true;
+    if (g.NavWindow == window && g.NavId != 0 && !g.NavDisableHighlight) return true; // keyboard/gamepad nav highlight
+    return false;
+}
+
+// Same rule for the recording and the replay frame: topmost recorded item under the mouse, inside the visible area
+static ImGuiID hovered_item(const ImGuiContext& g, const ImGuiWindow* window, const ImVector<Retained_Item>& items) {
+    if (g.HoveredWindow != window) return 0;
+    const ImVec2 mouse = g.IO.MousePos;
+    if (!window->InnerClipRect.Contains(mouse)) return 0;
+    for (int i = items.Size - 1; i >= 0; --i)
+        if (items[i].rect.Contains(mouse)) return items[i].id;
+    return 0;
+}
+
+static ImGuiID open_state_hash(const ImGuiWindow* window) {
+    ImGuiID hash = 0;
+    for (const auto& pair : window->StateStorage.Data) {
+        hash = ImHashData(&pair.key, sizeof(pair.key), hash);
+        hash = ImHashData(&pair.val_i, sizeof(pair.val_i), hash);
+    }
+    return hash;
+}
+
+static ImGuiID input_key(const ImGuiContext& g, const ImGuiWindow* window, ImGuiID hovered, ImGuiID extra_key) {
+    struct {
+        ImVec2  pos, size, scroll;
+        ImRect  clip;
+        ImGuiID open_state, style, hovered, extra;
+        ImFont* font;
+        float   font_size;
+        int     atlas_builds;
+    } key;
+    memset(&key, 0, sizeof(key)); // padding bytes must hash the same every time
+    key.pos          = window->Pos;
+    key.size         = window->Size;
+    key.scroll       = window->Scroll;
+    key.clip         = window->InnerClipRect;
+    key.open_state   = open_state_hash(window);
+    key.style        = ImHashData(&g.Style, sizeof(g.Style));
+    key.hovered      = hovered;
+    key.extra        = extra_key;
+    key.font         = g.Font;
+    key.font_size    = g.FontSize;
+    key.atlas_builds = font_state.atlas_builds;
+    return ImHashData(&key, sizeof(key));
+}
+
+static bool same_header(const ImDrawCmdHeader& a, const ImDrawCmdHeader& b) {
+    return memcmp(&a.ClipRect, &b.ClipRect, sizeof(a.ClipRect)) == 0 && a.TextureId == b.TextureId && a.VtxOffset == b.VtxOffset;
+}
+
+static void replay(ImGuiWindow* window, const Retained_Entry* e) {
+    ImDrawList* dl = window->DrawList;
+    if (e->idx.Size) {
+        dl->PrimReserve(e->idx.Size, e->vtx.Size);
+        const unsigned int base = dl->_VtxCurrentIdx;
+        memcpy(dl->_VtxWritePtr, e->vtx.Data, (size_t)e->vtx.Size * sizeof(ImDrawVert));
+        for (int i = 0; i < e->idx.Size; ++i)
+            dl->_IdxWritePtr[i] = (ImDrawIdx)(e->idx.Data[i] + base);
+        dl->_VtxWritePtr   += e->vtx.Size;
+        dl->_IdxWritePtr   += e->idx.Size;
+        dl->_VtxCurrentIdx += (unsigned int)e->vtx.Size;
+    }
+    window->DC.CursorPos         = e->cursor_pos;
+    window->DC.CursorMaxPos      = e->cursor_max_pos;
+    window->DC.IdealMaxPos       = e->ideal_max_pos;
+    window->DC.CursorPosPrevLine = e->cursor_pos_prev_line;
+    window->DC.PrevLineSize      = e->prev_line_size;
+}
+
+bool retained_draw_begin(ImGuiID extra_key) {
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    IM_ASSERT(recording.entry == nullptr && "retained_draw_begin() calls can't nest");
+    auto& stats = retained_draw_stats;
+
+    Retained_Entry* e = find_entry(window->ID);
+    const bool cachable = stats.enabled && !window->SkipItems && !interaction_pending(g, window);
+    if (cachable && e->valid && same_header(e->header, window->DrawList->_CmdHeader)
+        && e->key == input_key(g, window, hovered_item(g, window, e->items), extra_key)) {
+        replay(window, e);
+        ++stats.replays;
+        ++stats.total_replays;
+        stats.vtx_replayed += e->vtx.Size;
+        return true;
+    }
+
+    ImDrawList* dl = window->DrawList;
+    recording.entry             = e;
+    recording.window            = window;
+    recording.extra_key         = extra_key;
+    recording.vtx_start         = dl->VtxBuffer.Size;
+    recording.idx_start         = dl->IdxBuffer.Size;
+    recording.cmd_count         = dl->CmdBuffer.Size;
+    recording.vtx_current_start = dl->_VtxCurrentIdx;
+    recording.cachable          = cachable;
+    e->valid  = false;
+    e->header = dl->_CmdHeader;
+    e->items.resize(0);
+    return false;
+}
+
+void retained_draw_note_item() {
+    if (!recording.entry || !recording.cachable) return;
+    Retained_Item item;
+    item.id   = ImGui::GetItemID();
+    item.rect = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+    recording.entry->items.push_back(item);
+}
+
+void retained_draw_end() {
+    Retained_Entry* e = recording.entry;
+    if (!e) return;
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = recording.window;
+    ImDrawList* dl = window->DrawList;
+    auto& stats = retained_draw_stats;
+
+    const int vtx_count = dl->VtxBuffer.Size - recording.vtx_start;
+    const int idx_count = dl->IdxBuffer.Size - recording.idx_start;
+    ++stats.draws;
+    ++stats.total_draws;
+    stats.vtx_built += vtx_count;
+
+    // NOTE(WALKER): Only snapshot the simple (and normal) case: the content appended to the command that was open at
+    //               begin. A clip rect/texture change or a 64k vertex split would need the command list too, so just don't cache.
+    if (recording.cachable) {
+        if (dl->CmdBuffer.Size != recording.cmd_count || !same_header(e->header, dl->_CmdHeader)
+            || (sizeof(ImDrawIdx) == 2 && vtx_count >= (1 << 16))) {
+            ++stats.uncachable;
+        } else {
+            e->vtx.resize(vtx_count);
+            e->idx.resize(idx_count);
+            if (vtx_count) memcpy(e->vtx.Data, dl->VtxBuffer.Data + recording.vtx_start, (size_t)vtx_count * sizeof(ImDrawVert));
+            for (int i = 0; i < idx_count; ++i)
+                e->idx.Data[i] = (ImDrawIdx)(dl->IdxBuffer.Data[recording.idx_start + i] - recording.vtx_current_start);
+            e->cursor_pos           = window->DC.CursorPos;
+            e->cursor_max_pos       = window->DC.CursorMaxPos;
+            e->ideal_max_pos        = window->DC.IdealMaxPos;
+            e->cursor_pos_prev_line = window->DC.CursorPosPrevLine;
+            e->prev_line_size       = window->DC.PrevLineSize;
+            e->key   = input_key(g, window, hovered_item(g, window, e->items), recording.extra_key);
+            e->valid = true;
+        }
+    }
+    recording = Retained_Recording();
+}
+
+void retained_draw_end_frame(const ImDrawData* draw_data) {
+    auto& s = retained_draw_stats;
+    s.last_replays      = s.replays;
+    s.last_draws        = s.draws;
+    s.last_vtx_replayed = s.vtx_replayed;
+    s.last_vtx_built    = s.vtx_built;
+    s.last_vtx_total    = draw_data ? draw_data->TotalVtxCount : 0;
+    s.replays = s.draws = s.vtx_replayed = s.vtx_built = 0;
+}
+
+void retained_draw_clear() {
+    for (Retained_Entry* e : entries) IM_DELETE(e);
+    entries.clear();
+    entry_index.Clear();
+    recording = Retained_Recording();
+}
+
+void retained_draw_show_menu() {
+    auto& s = retained_draw_stats;
+    if (ImGui::Checkbox("Retained tab geometry", &s.enabled) && !s.enabled)
+        for (Retained_Entry* e : entries) e->valid = false;
+    const auto total = s.total_replays + s.total_draws;
+    ImGui::Text("Tab replays:     %llu of %llu (%.1f%%), %llu uncachable", s.total_replays, total, total ? 100.0 * (double)s.total_replays / (double)total : 0.0, s.uncachable);
+    ImGui::Text("Last frame:      %d vertices, tabs %d replayed (%d vtx) / %d built (%d vtx)",
+                s.last_vtx_total, s.last_replays, s.last_vtx_replayed, s.last_draws, s.last_vtx_built);
+}
@@ -0,0 +1,50 @@
+// NOTE(WALKER): Retained mode for the section tabs.
+//               ImGui is immediate mode: every frame the tab contents are walked again and produce the exact same vertices
+//               and indices as the frame before unless something actually changed. This snapshots the geometry a tab's scroll
+//               child produced and, while the inputs that could change it stay the same (scroll offset, tree node open state,
+//               hovered item, style, font, window size/position), replays it straight into the draw list instead of
+//               resubmitting the widgets.
+//               Anything interactive (mouse buttons, an active item, keyboard nav, text input) falls back to a normal draw so
+//               clicks, toggles and highlights behave exactly like before. Hover is handled by hit testing the item rects
+//               recorded with the snapshot: if the hovered item changes, the tab is redrawn and re-recorded.
+
+#pragma once
+
+#include "imgui.h"
+
+struct Retained_Draw_Stats {
+    bool enabled = true;
+
+    // current frame, rolled into last_* by retained_draw_end_frame()
+    int  replays       = 0;
+    int  draws         = 0;
+    int  vtx_replayed  = 0;
+    int  vtx_built     = 0;
+
+    int  last_replays      = 0;
+    int  last_draws        = 0;
+    int  last_vtx_replayed = 0;
+    int  last_vtx_built    = 0;
+    int  last_vtx_total    = 0; // whole frame, from ImDrawData
+
+    unsigned long long total_replays = 0;
+    unsigned long long total_draws   = 0;
+    unsigned long long uncachable    = 0; // recordings that could not be snapshot (draw command layout changed)
+};
+
+extern Retained_Draw_Stats retained_draw_stats;
+
+// Call right after BeginChild(). Returns true if the cached geometry was replayed, the caller must then skip its widgets.
+// Returns false if the caller has to draw normally, in which case it must call retained_draw_end() afterwards.
+// extra_key is mixed into the cache key for caller state that changes the output (e.g. a pending "open all").
+bool retained_draw_begin(ImGuiID extra_key);
+void retained_draw_end();
+
+// Call after every interactive widget drawn between begin/end so replay frames know where the hover targets are.
+void retained_draw_note_item();
+
+// Call after ImGui::Render() to roll the per-frame stats.
+void retained_draw_end_frame(const ImDrawData* draw_data);
+void retained_draw_clear();
+
+void retained_draw_show_menu();
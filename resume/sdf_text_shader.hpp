@@ -0,0 +1,168 @@
+// NOTE(WALKER): Distance field text shader on top of the stock OpenGL3 backend.
+//               The backend's shader just multiplies vertex color by the texture, which would show the raw distance field.
+//               Instead of forking imgui_impl_opengl3.cpp, we prepend a draw callback to the first draw list after ImGui::Render():
+//               the backend calls it before any geometry, we bind our program + attribute layout, and because the backend never
+//               rebinds its program mid-frame, every following draw (text AND shapes, the white pixel is a distance of 1.0) goes
+//               through the SDF shader.
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_impl_opengl3.h"
+#include "fonts.hpp"
+#include <stdio.h>
+#include <string.h>
+
+#if defined(IMGUI_IMPL_OPENGL_ES2)
+#include <GLES2/gl2.h>
+#elif defined(IMGUI_IMPL_OPENGL_ES3)
+#include <GLES3/gl3.h>
+#else
+#ifndef GL_GLEXT_PROTOTYPES
+#define GL_GLEXT_PROTOTYPES
+#endif
+#include <GL/gl.h>
+#include <GL/glext.h>
+#endif
+
+struct SDF_Text_Shader {
+    GLuint program      = 0;
+    GLint  loc_proj     = -1;
+    GLint  loc_texture  = -1;
+    GLint  loc_smoothing = -1;
+    GLint  loc_position = -1;
+    GLint  loc_uv       = -1;
+    GLint  loc_color    = -1;
+    const ImDrawData* draw_data = nullptr; // set every frame by sdf_text_shader_patch()
+    float  smoothing    = 0.1f;
+};
+
+static SDF_Text_Shader sdf_text_shader;
+
+static GLuint sdf_text_compile(GLenum type, const char* version, const char* body) {
+    const char* defines = type == GL_VERTEX_SHADER
+        ? "#if __VERSION__ >= 130\n#define attribute in\n#define varying out\n#endif\n"
+        : "#ifdef GL_ES\nprecision mediump float;\n#endif\n#if __VERSION__ >= 130\n#define varying in\n#define texture2D texture\nout vec4 Out_Color;\n#define gl_FragColor Out_Color\n#endif\n";
+    const char* sources[] = { version, "\n", defines, body };
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 4, sources, nullptr);
+    glCompileShader(shader);
+    GLint ok = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        char log[1024];
+        glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        fprintf(stderr, "[sdf_text_shader] compile failed: %s\n", log);
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+// glsl_version is the same string handed to ImGui_ImplOpenGL3_Init() ("#version 100", "#version 130", ...)
+static bool sdf_text_shader_init(const char* glsl_version) {
+    static const char* vertex_body =
+        "uniform mat4 ProjMtx;\n"
+        "attribute vec2 Position;\n"
+        "attribute vec2 UV;\n"
+        "attribute vec4 Color;\n"
+        "varying vec2 Frag_UV;\n"
+        "varying vec4 Frag_Color;\n"
+        "void main() {\n"
+        "    Frag_UV = UV;\n"
+        "    Frag_Color = Color;\n"
+        "    gl_Position = ProjMtx * vec4(Position.xy, 0.0, 1.0);\n"
+        "}\n";
+    static const char* fragment_body =
+        "uniform sampler2D Texture;\n"
+        "uniform float Smoothing;\n"
+        "varying vec2 Frag_UV;\n"
+        "varying vec4 Frag_Color;\n"
+        "void main() {\n"
+        "    float dist = texture2D(Texture, Frag_UV).a;\n"
+        "    float coverage = smoothstep(0.5 - Smoothing, 0.5 + Smoothing, dist);\n"
+        "    gl_FragColor = vec4(Frag_Color.rgb, Frag_Color.a * coverage);\n"
+        "}\n";
+
+    if (!glsl_version) glsl_version = "#version 100";
+    GLuint vs = sdf_text_compile(GL_VERTEX_SHADER, glsl_version, vertex_body);
+    GLuint fs = sdf_text_compile(GL_FRAGMENT_SHADER, glsl_version, fragment_body);
+    if (!vs || !fs) return false;
+
+    auto& s = sdf_text_shader;
+    s.program = glCreateProgram();
+    glAttachShader(s.program, vs);
+    glAttachShader(s.program, fs);
+    glLinkProgram(s.program);
+    glDetachShader(s.program, vs);
+    glDetachShader(s.program, fs);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    GLint ok = 0;
+    glGetProgramiv(s.program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        fprintf(stderr, "[sdf_text_shader] link failed\n");
+        glDeleteProgram(s.program);
+        s.program = 0;
+        return false;
+    }
+    s.loc_proj      = glGetUniformLocation(s.program, "ProjMtx");
+    s.loc_texture   = glGetUniformLocation(s.program, "Texture");
+    s.loc_smoothing = glGetUniformLocation(s.program, "Smoothing");
+    s.loc_position  = glGetAttribLocation(s.program, "Position");
+    s.loc_uv        = glGetAttribLocation(s.program, "UV");
+    s.loc_color     = glGetAttribLocation(s.program, "Color");
+    return true;
+}
+
+static void sdf_text_shader_shutdown() {
+    if (sdf_text_shader.program) glDeleteProgram(sdf_text_shader.program);
+    sdf_text_shader.program = 0;
+}
+
+// NOTE(WALKER): Runs inside ImGui_ImplOpenGL3_RenderDrawData() with the backend's vertex/index buffers already bound
+static void sdf_text_shader_callback(const ImDrawList*, const ImDrawCmd*) {
+    const auto& s = sdf_text_shader;
+    const ImDrawData* dd = s.draw_data;
+    const float L = dd->DisplayPos.x;
+    const float R = dd->DisplayPos.x + dd->DisplaySize.x;
+    const float T = dd->DisplayPos.y;
+    const float B = dd->DisplayPos.y + dd->DisplaySize.y;
+    const float ortho[4][4] = {
+        { 2.0f/(R-L),   0.0f,         0.0f, 0.0f },
+        { 0.0f,         2.0f/(T-B),   0.0f, 0.0f },
+        { 0.0f,         0.0f,        -1.0f, 0.0f },
+        { (R+L)/(L-R),  (T+B)/(B-T),  0.0f, 1.0f },
+    };
+    glUseProgram(s.program);
+    glUniformMatrix4fv(s.loc_proj, 1, GL_FALSE, &ortho[0][0]);
+    glUniform1i(s.loc_texture, 0);
+    glUniform1f(s.loc_smoothing, s.smoothing);
+
+    glEnableVertexAttribArray(s.loc_position);
+    glEnableVertexAttribArray(s.loc_uv);
+    glEnableVertexAttribArray(s.loc_color);
+    glVertexAttribPointer(s.loc_position, 2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, pos));
+    glVertexAttribPointer(s.loc_uv,       2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, uv));
+    glVertexAttribPointer(s.loc_color,    4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col));
+}
+
+// NOTE(WALKER): Call between ImGui::Render() and ImGui_ImplOpenGL3_RenderDrawData(). font_global_scale is io.FontGlobalScale
+//               of the frame, passed in because on the render thread (render_pipeline.hpp) io belongs to the next frame.
+static void sdf_text_shader_patch(ImDrawData* draw_data, float font_global_scale) {
+    auto& s = sdf_text_shader;
+    if (!s.program || font_state.mode != Font_Mode_SDF || draw_data->CmdListsCount == 0) return;
+    s.draw_data = draw_data;
+    s.smoothing = fonts_sdf_smoothing(font_global_scale);
+
+    ImDrawList* first = draw_data->CmdLists[0];
+    ImDrawCmd cmd;
+    if (first->CmdBuffer.Size > 0) {
+        cmd.ClipRect  = first->CmdBuffer[0].ClipRect;
+        cmd.TextureId = first->CmdBuffer[0].TextureId;
+    }
+    cmd.UserCallback     = sdf_text_shader_callback;
+    cmd.UserCallbackData = nullptr;
+    first->CmdBuffer.push_front(cmd);
+}
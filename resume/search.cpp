@@ -0,0 +1,234 @@
+#include "search.hpp"
+#include "profiler.hpp"
+
+#include "imgui.h"
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+// Word characters: letters, digits, '+' and '#' (so "C++" and "C#" stay whole terms), and any UTF-8 byte. ASCII is lowercased.
+static bool search_word_char(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '+' || c == '#' || c >= 0x80;
+}
+static char search_lower(char c) { return c >= 'A' && c <= 'Z' ? (char)(c - 'A' + 'a') : c; }
+
+// Calls emit(word, length) for every word in [text, text_end), word points into a lowercased copy in scratch
+template <typename Emit> static void search_split_words(const char* text, const char* text_end, ImVector<char>& scratch, Emit emit) {
+    const char* p = text;
+    while (p < text_end) {
+        while (p < text_end && !search_word_char((unsigned char)*p)) ++p;
+        const char* word = p;
+        while (p < text_end && search_word_char((unsigned char)*p)) ++p;
+        if (p == word) break;
+        scratch.resize(0);
+        for (const char* c = word; c < p; ++c) scratch.push_back(search_lower(*c));
+        emit(scratch.Data, (uint32_t)(p - word));
+    }
+}
+
+static int search_compare(const char* a, uint32_t a_length, const char* b, uint32_t b_length) {
+    const int cmp = memcmp(a, b, a_length < b_length ? a_length : b_length);
+    return cmp != 0 ? cmp : (a_length < b_length ? -1 : a_length > b_length ? 1 : 0);
+}
+
+//-----------------------------------------------------------------------------
+// Index
+//-----------------------------------------------------------------------------
+
+struct Search_Occurrence {
+    uint32_t text;   // into the occurrence chars
+    uint32_t length;
+    uint32_t node;
+};
+
+void search_index_build(Search_Index& index, const Content& c) {
+    const double start = profiler_now_ms();
+    index = Search_Index();
+    if (!c.header) return;
+    index.node_count = c.header->node_count;
+
+    // Every (word, node) pair in the content, then sorted so equal words are adjacent with their nodes in order
+    ImVector<char>              chars;
+    ImVector<Search_Occurrence> occurrences;
+    ImVector<char>              scratch;
+    auto add = [&](const char* word, uint32_t length, uint32_t node) {
+        occurrences.push_back({ (uint32_t)chars.Size, length, node });
+        for (uint32_t k = 0; k < length; ++k) chars.push_back(word[k]);
+    };
+    for (uint32_t i = 0; i < c.header->node_count; ++i) {
+        const Content_Node& node = c.nodes[i];
+        if (node.kind == Content_Kind_Node) {
+            const char* label = content_string(c, node.label);
+            search_split_words(label, label + node.label.length, scratch, [&](const char* w, uint32_t n) { add(w, n, i); });
+        }
+        for (uint32_t k = 0; k < node.span_count; ++k) {
+            const Content_Span& span = c.spans[node.first_span + k];
+            const char* text = content_string(c, span.text);
+            search_split_words(text, text + span.text.length, scratch, [&](const char* w, uint32_t n) { add(w, n, i); });
+        }
+    }
+    std::sort(occurrences.begin(), occurrences.end(), [&](const Search_Occurrence& a, const Search_Occurrence& b) {
+        const int cmp = search_compare(chars.Data + a.text, a.length, chars.Data + b.text, b.length);
+        return cmp != 0 ? cmp < 0 : a.node < b.node;
+    });
+
+    for (int i = 0; i < occurrences.Size;) {
+        const Search_Occurrence& first = occurrences[i];
+        Search_Term term = { (uint32_t)index.chars.Size, first.length, (uint32_t)index.postings.Size, 0 };
+        index.chars.resize(index.chars.Size + (int)first.length + 1);
+        memcpy(index.chars.Data + term.text, chars.Data + first.text, first.length);
+        index.chars[term.text + first.length] = '\0';
+        for (; i < occurrences.Size && search_compare(chars.Data + occurrences[i].text, occurrences[i].length,
+                                                      chars.Data + first.text, first.length) == 0; ++i) {
+            if (term.posting_count == 0 || index.postings.back() != occurrences[i].node) {
+                index.postings.push_back(occurrences[i].node);
+                ++term.posting_count;
+            }
+        }
+        index.terms.push_back(term);
+    }
+    index.build_ms = profiler_now_ms() - start;
+}
+
+void search_free(Search& search) {
+    search = Search();
+}
+
+// [first, last) terms a query word selects: every term it prefixes, or only an equal term for very short words
+static void search_term_range(const Search_Index& index, const char* word, uint32_t length, int& first, int& last) {
+    const Search_Term* begin = index.terms.begin();
+    const Search_Term* end   = index.terms.end();
+    const Search_Term* lo = std::lower_bound(begin, end, 0, [&](const Search_Term& t, int) {
+        return search_compare(index.chars.Data + t.text, t.length, word, length) < 0;
+    });
+    const Search_Term* hi;
+    if (length < (uint32_t)SEARCH_MIN_PREFIX) {
+        hi = lo != end && lo->length == length && memcmp(index.chars.Data + lo->text, word, length) == 0 ? lo + 1 : lo;
+    } else {
+        hi = std::partition_point(lo, end, [&](const Search_Term& t) {
+            return t.length >= length && memcmp(index.chars.Data + t.text, word, length) == 0;
+        });
+    }
+    first = (int)(lo - begin);
+    last  = (int)(hi - begin);
+}
+
+//-----------------------------------------------------------------------------
+// Query
+//-----------------------------------------------------------------------------
+
+void search_run(Search& s, const Content& c, const char* query) {
+    const double start = profiler_now_ms();
+    const uint32_t node_count    = c.header ? c.header->node_count : 0;
+    const uint32_t section_count = c.header ? c.header->section_count : 0;
+    s.node_flags.resize((int)node_count);
+    s.node_marks.resize((int)node_count);
+    s.section_matches.resize((int)section_count);
+    s.section_open.resize((int)section_count);
+    memset(s.node_marks.Data, 0, s.node_marks.size_in_bytes());
+    memset(s.section_matches.Data, 0, s.section_matches.size_in_bytes());
+    ++s.generation;
+
+    // Mark every node that has each query word, word i sets bit i
+    ImVector<char> scratch;
+    scratch.reserve(SEARCH_MAX_QUERY);
+    int word_count = 0;
+    if (node_count == s.index.node_count) {
+        search_split_words(query, query + strlen(query), scratch, [&](const char* word, uint32_t length) {
+            if (word_count == SEARCH_MAX_WORDS) return;
+            const uint8_t bit = (uint8_t)(1u << word_count++);
+            int first, last;
+            search_term_range(s.index, word, length, first, last);
+            for (int t = first; t < last; ++t) {
+                const Search_Term& term = s.index.terms[t];
+                for (uint32_t p = 0; p < term.posting_count; ++p)
+                    s.node_marks[(int)s.index.postings[term.first_posting + p]] |= bit;
+            }
+        });
+    }
+    s.active = word_count > 0;
+    s.total_matches = 0;
+    if (!s.active) {
+        memset(s.node_flags.Data, Search_Node_Visible, s.node_flags.size_in_bytes());
+        for (bool& open : s.section_open) open = false;
+        s.select_section = -1;
+        s.stats.last_ms = profiler_now_ms() - start;
+        ++s.stats.queries;
+        return;
+    }
+
+    // NOTE(WALKER): Nodes are in pre-order and a subtree is [i, end), so two linear passes are enough:
+    //               backwards, remembering the next match, tells whether a subtree holds one (visible, and open for tree nodes),
+    //               forwards, remembering how far the last matching node's subtree reaches, shows everything under a match.
+    const uint8_t all_words = (uint8_t)((1u << word_count) - 1);
+    uint32_t next_match = node_count;
+    for (uint32_t i = node_count; i-- > 0;) {
+        const Content_Node& node = c.nodes[i];
+        const uint32_t next_below = next_match;
+        uint8_t flags = 0;
+        if (s.node_marks[(int)i] == all_words) {
+            flags |= Search_Node_Match;
+            next_match = i;
+        }
+        if (next_match < node.end)                                    flags |= Search_Node_Visible;
+        if (node.kind == Content_Kind_Node && next_below < node.end)  flags |= Search_Node_Open;
+        s.node_flags[(int)i] = flags;
+    }
+    uint32_t matched_until = 0;
+    for (uint32_t i = 0; i < node_count; ++i) {
+        if (i < matched_until) s.node_flags[(int)i] |= Search_Node_Visible;
+        if (s.node_flags[(int)i] & Search_Node_Match) matched_until = c.nodes[i].end > matched_until ? c.nodes[i].end : matched_until;
+    }
+
+    for (uint32_t sec = 0; sec < section_count; ++sec) {
+        const Content_Section& section = c.sections[sec];
+        for (uint32_t i = section.first_node; i < section.end_node; ++i)
+            if (s.node_flags[(int)i] & Search_Node_Match) ++s.section_matches[(int)sec];
+        s.total_matches += (int)s.section_matches[(int)sec];
+        s.section_open[(int)sec] = true;
+    }
+
+    // Stay on the current tab if it has results, else jump to the first one that does
+    s.select_section = -1;
+    if (s.current_section < 0 || s.current_section >= (int)section_count || s.section_matches[s.current_section] == 0)
+        for (uint32_t sec = 0; sec < section_count && s.select_section < 0; ++sec)
+            if (s.section_matches[(int)sec] > 0) s.select_section = (int)sec;
+
+    s.stats.last_ms = profiler_now_ms() - start;
+    s.stats.max_ms  = s.stats.last_ms > s.stats.max_ms ? s.stats.last_ms : s.stats.max_ms;
+    ++s.stats.queries;
+}
+
+//-----------------------------------------------------------------------------
+// UI
+//-----------------------------------------------------------------------------
+
+void search_show_box(Search& s, const Content& c) {
+    PROFILE_ZONE("search_show_box");
+    const ImGuiIO&    io    = ImGui::GetIO();
+    const ImGuiStyle& style = ImGui::GetStyle();
+
+    char count[32] = "";
+    if (s.active) snprintf(count, sizeof(count), "%d match%s", s.total_matches, s.total_matches == 1 ? "" : "es");
+    const float box_width   = ImGui::GetFontSize() * 14.0f;
+    const float count_width = count[0] ? ImGui::CalcTextSize(count).x + style.ItemSpacing.x : 0.0f;
+    const float x = ImGui::GetWindowContentRegionMax().x - box_width - count_width;
+    if (x > ImGui::GetCursorPosX()) ImGui::SetCursorPosX(x); // right aligned when there is room
+    if (count[0]) ImGui::TextUnformatted(count);
+
+    if (!io.WantTextInput && ((io.KeyCtrl && ImGui::IsKeyPressed(ImGuiKey_F, false)) || ImGui::IsKeyPressed(ImGuiKey_Slash, false)))
+        ImGui::SetKeyboardFocusHere();
+    ImGui::SetNextItemWidth(box_width);
+    if (ImGui::InputTextWithHint("##Search", "Search (Ctrl+F)", s.query, sizeof(s.query), ImGuiInputTextFlags_EscapeClearsAll)) {
+        PROFILE_ZONE("search_run");
+        search_run(s, c, s.query);
+    }
+}
+
+void search_show_menu(const Search& s) {
+    const Search_Index& index = s.index;
+    const size_t bytes = (size_t)index.chars.size_in_bytes() + index.terms.size_in_bytes() + index.postings.size_in_bytes();
+    ImGui::Text("Search index:    %d terms, %d postings (%.1f KB), built in %.2f ms", index.terms.Size, index.postings.Size,
+                bytes / 1024.0, index.build_ms);
+    ImGui::Text("Search queries:  %llu, last %.3f ms, max %.3f ms", s.stats.queries, s.stats.last_ms, s.stats.max_ms);
+}
@@ -0,0 +1,74 @@
+// NOTE(WALKER): Full-text search over the resume content (the box at the right of the menu bar).
+//               An inverted index is built once from the content buffer at startup: every node's label and span text is cut
+//               into lowercase words ("C/C++" -> "c", "c++"), and each distinct word (term) keeps the sorted list of nodes it
+//               appears in (postings). Terms are sorted, so a query word is a binary search for the range of terms it prefixes
+//               ("dist" -> "distributed", "distribution"), and a keystroke costs the postings of those terms plus one linear
+//               pass over the nodes, no string compares against the text. Every query word has to match (AND).
+//
+//               The result is one flags byte per node that content_draw_tab_items() uses to skip what didn't match, highlight
+//               the nodes that did and open the tree nodes they sit in.
+
+#pragma once
+
+#include "imgui.h"
+#include "content.hpp"
+#include <stdint.h>
+
+constexpr int SEARCH_MAX_QUERY   = 128;
+constexpr int SEARCH_MAX_WORDS   = 8;  // one bit each in the per-node match mask
+constexpr int SEARCH_MIN_PREFIX  = 2;  // shorter query words only match whole terms ("c", not everything starting with c)
+
+struct Search_Term {
+    uint32_t text;          // into Search_Index::chars, NUL terminated
+    uint32_t length;
+    uint32_t first_posting; // into Search_Index::postings
+    uint32_t posting_count;
+};
+
+struct Search_Index {
+    ImVector<char>        chars;
+    ImVector<Search_Term> terms;    // sorted by text
+    ImVector<uint32_t>    postings; // node indices, sorted and unique per term
+    uint32_t              node_count = 0;
+    double                build_ms   = 0.0;
+};
+
+enum Search_Node_Flags : uint8_t {
+    Search_Node_Visible = 1 << 0, // matches, has a match below it, or sits under a matching node
+    Search_Node_Match   = 1 << 1, // every query word is in this node's own text
+    Search_Node_Open    = 1 << 2, // tree node with a match below it
+};
+
+struct Search_Stats {
+    double             last_ms   = 0.0;
+    double             max_ms    = 0.0;
+    unsigned long long queries   = 0;
+};
+
+struct Search {
+    Search_Index       index;
+    char               query[SEARCH_MAX_QUERY] = {};
+    bool               active     = false; // the query has at least one word
+    uint32_t           generation = 0;     // bumped whenever the results change, part of the retained draw key
+    ImVector<uint8_t>  node_flags;         // Search_Node_Flags per content node
+    ImVector<uint8_t>  node_marks;         // scratch: bit i = query word i is in the node
+    ImVector<uint32_t> section_matches;    // matching nodes per section
+    ImVector<bool>     section_open;       // the section still has to open its tree nodes for the current results
+    int                total_matches = 0;
+    int                current_section = -1; // tab drawn last frame, set by content_draw_tab_items()
+    int                select_section  = -1; // tab to switch to on the next frame (the current one has no matches)
+    Search_Stats       stats;
+};
+
+// Once, after the content is loaded. Nodes are indexed by their position in content.nodes.
+void search_index_build(Search_Index& index, const Content& content);
+void search_free(Search& search);
+
+// Runs the query against the index and fills search.node_flags. Cheap enough for every keystroke.
+void search_run(Search& search, const Content& content, const char* query);
+
+// The search box, call inside BeginMenuBar(). Ctrl+F or '/' focuses it, Escape clears it.
+void search_show_box(Search& search, const Content& content);
+
+// Stats for the "Performance" menu
+void search_show_menu(const Search& search);
@@ -0,0 +1,430 @@
+#include "soft_raster.hpp"
+
+#include "imgui.h"
+#include "imgui_internal.h" // ImClamp(), ImSaturate(), ImSwap()
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <zlib.h>
+
+#include "../Utilities/defer.hpp"
+
+// NOTE(WALKER): Vertices are snapped to 1/16 pixel, like a GPU's subpixel grid, and the edge functions are evaluated in
+//               64 bit integers: exact, so the two triangles on either side of an edge agree on every pixel of it.
+constexpr int     SUBPIXEL_BITS = 4;
+constexpr int     SUBPIXEL      = 1 << SUBPIXEL_BITS;
+constexpr int64_t HALF_PIXEL    = SUBPIXEL / 2;
+
+static double raster_now_ms() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void soft_raster_resize(Soft_Raster& r, int width, int height) {
+    r.width   = width > 0 ? width : 0;
+    r.height  = height > 0 ? height : 0;
+    r.tiles_x = (r.width + SOFT_RASTER_TILE - 1) / SOFT_RASTER_TILE;
+    r.tiles_y = (r.height + SOFT_RASTER_TILE - 1) / SOFT_RASTER_TILE;
+    r.pixels.resize(r.width * r.height);
+    for (ImU32& p : r.pixels) p = r.clear;
+}
+
+void soft_raster_clear_rect(Soft_Raster& r, int x0, int y0, int x1, int y1) {
+    x0 = ImMax(x0, 0); y0 = ImMax(y0, 0);
+    x1 = ImMin(x1, r.width); y1 = ImMin(y1, r.height);
+    for (int y = y0; y < y1; ++y)
+        for (int x = x0; x < x1; ++x) r.pixels[y * r.width + x] = r.clear;
+}
+
+void soft_raster_free(Soft_Raster& r) {
+    r.pixels.clear();
+    r.triangles.clear();
+    r.bin_start.clear();
+    r.bin_items.clear();
+    r.width = r.height = r.tiles_x = r.tiles_y = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Setup (calling thread)
+//-----------------------------------------------------------------------------
+
+static inline int64_t edge(int64_t ax, int64_t ay, int64_t bx, int64_t by, int64_t px, int64_t py) {
+    return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+}
+
+// Top-left rule for an edge of a triangle that's positive inside (y down): a top edge goes right, a left edge goes up
+static inline bool top_left(int64_t ax, int64_t ay, int64_t bx, int64_t by) {
+    return by < ay || (by == ay && bx > ax);
+}
+
+static inline int64_t snap(float v) { return (int64_t)(v * (float)SUBPIXEL + (v >= 0.0f ? 0.5f : -0.5f)); }
+
+static void unpack_color(ImU32 c, float out[4]) {
+    out[0] = (float)((c >> IM_COL32_R_SHIFT) & 0xFF) / 255.0f;
+    out[1] = (float)((c >> IM_COL32_G_SHIFT) & 0xFF) / 255.0f;
+    out[2] = (float)((c >> IM_COL32_B_SHIFT) & 0xFF) / 255.0f;
+    out[3] = (float)((c >> IM_COL32_A_SHIFT) & 0xFF) / 255.0f;
+}
+
+static void setup_triangle(Soft_Raster& r, const ImDrawVert* v[3], ImVec2 offset, ImVec2 scale, int clip_x0, int clip_y0, int clip_x1, int clip_y1, bool textured) {
+    Soft_Raster_Triangle t;
+    for (int k = 0; k < 3; ++k) {
+        t.x[k] = snap((v[k]->pos.x - offset.x) * scale.x);
+        t.y[k] = snap((v[k]->pos.y - offset.y) * scale.y);
+    }
+    int64_t area = edge(t.x[0], t.y[0], t.x[1], t.y[1], t.x[2], t.y[2]);
+    if (area == 0) return;
+    int order[3] = { 0, 1, 2 };
+    if (area < 0) { // ImGui doesn't promise a winding, flip to the one the edge functions want
+        order[1] = 2; order[2] = 1;
+        ImSwap(t.x[1], t.x[2]);
+        ImSwap(t.y[1], t.y[2]);
+        area = -area;
+    }
+
+    // Pixels whose center (x + 0.5) is inside the bounds, cut to the scissor
+    const int64_t min_x = ImMin(t.x[0], ImMin(t.x[1], t.x[2])), max_x = ImMax(t.x[0], ImMax(t.x[1], t.x[2]));
+    const int64_t min_y = ImMin(t.y[0], ImMin(t.y[1], t.y[2])), max_y = ImMax(t.y[0], ImMax(t.y[1], t.y[2]));
+    t.min_x = ImMax(clip_x0, (int)((min_x - HALF_PIXEL + SUBPIXEL - 1) >> SUBPIXEL_BITS));
+    t.min_y = ImMax(clip_y0, (int)((min_y - HALF_PIXEL + SUBPIXEL - 1) >> SUBPIXEL_BITS));
+    t.max_x = ImMin(clip_x1 - 1, (int)((max_x - HALF_PIXEL) >> SUBPIXEL_BITS));
+    t.max_y = ImMin(clip_y1 - 1, (int)((max_y - HALF_PIXEL) >> SUBPIXEL_BITS));
+    if (t.min_x > t.max_x || t.min_y > t.max_y) return;
+
+    for (int k = 0; k < 3; ++k) {
+        const ImDrawVert* src = v[order[k]];
+        t.u[k] = src->uv.x;
+        t.v[k] = src->uv.y;
+        unpack_color(src->col, t.col[k]);
+    }
+    t.inv_area    = 1.0f / (float)area;
+    t.textured    = textured;
+    t.flat        = v[0]->col == v[1]->col && v[0]->col == v[2]->col;
+    t.constant_uv = t.u[0] == t.u[1] && t.u[0] == t.u[2] && t.v[0] == t.v[1] && t.v[0] == t.v[2];
+    r.triangles.push_back(t);
+}
+
+// Two passes over the bounds: count per tile, then fill, so the bins are one flat array and stay in submission order
+static void bin_triangles(Soft_Raster& r) {
+    const int tiles = r.tiles_x * r.tiles_y;
+    r.bin_start.resize(tiles + 1);
+    memset(r.bin_start.Data, 0, (size_t)r.bin_start.size_in_bytes());
+    for (const Soft_Raster_Triangle& t : r.triangles)
+        for (int ty = t.min_y / SOFT_RASTER_TILE; ty <= t.max_y / SOFT_RASTER_TILE; ++ty)
+            for (int tx = t.min_x / SOFT_RASTER_TILE; tx <= t.max_x / SOFT_RASTER_TILE; ++tx)
+                ++r.bin_start[ty * r.tiles_x + tx + 1];
+    for (int i = 0; i < tiles; ++i) r.bin_start[i + 1] += r.bin_start[i];
+
+    r.bin_items.resize(r.bin_start[tiles]);
+    ImVector<int> cursor;
+    cursor.resize(tiles);
+    memcpy(cursor.Data, r.bin_start.Data, (size_t)cursor.size_in_bytes());
+    for (int i = 0; i < r.triangles.Size; ++i) {
+        const Soft_Raster_Triangle& t = r.triangles[i];
+        for (int ty = t.min_y / SOFT_RASTER_TILE; ty <= t.max_y / SOFT_RASTER_TILE; ++ty)
+            for (int tx = t.min_x / SOFT_RASTER_TILE; tx <= t.max_x / SOFT_RASTER_TILE; ++tx)
+                r.bin_items[cursor[ty * r.tiles_x + tx]++] = i;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Tiles (worker threads)
+//-----------------------------------------------------------------------------
+
+// GL_LINEAR with GL_CLAMP_TO_EDGE
+static float sample_alpha8(const Soft_Raster_Texture& tex, float u, float v) {
+    const float fx = u * (float)tex.width - 0.5f, fy = v * (float)tex.height - 0.5f;
+    const float flx = ImFloor(fx), fly = ImFloor(fy);
+    const float ax = fx - flx, ay = fy - fly;
+    const int x0 = ImClamp((int)flx, 0, tex.width - 1),  x1 = ImClamp((int)flx + 1, 0, tex.width - 1);
+    const int y0 = ImClamp((int)fly, 0, tex.height - 1), y1 = ImClamp((int)fly + 1, 0, tex.height - 1);
+    const unsigned char* row0 = tex.alpha8 + (size_t)y0 * tex.width;
+    const unsigned char* row1 = tex.alpha8 + (size_t)y1 * tex.width;
+    const float top    = row0[x0] + (row0[x1] - row0[x0]) * ax;
+    const float bottom = row1[x0] + (row1[x1] - row1[x0]) * ax;
+    return (top + (bottom - top) * ay) / 255.0f;
+}
+
+// The fragment shader's coverage: the texel's alpha, or the SDF ramp around the 0.5 iso line
+static float coverage(const Soft_Raster_Texture& tex, const Soft_Raster_Triangle& t, float u, float v) {
+    if (!t.textured) return 1.0f;
+    const float a = sample_alpha8(tex, u, v);
+    if (!tex.sdf) return a;
+    const float lo = 0.5f - tex.smoothing, hi = 0.5f + tex.smoothing;
+    const float k = ImSaturate((a - lo) / (hi - lo));
+    return k * k * (3.0f - 2.0f * k);
+}
+
+// SRC_ALPHA, ONE_MINUS_SRC_ALPHA for color, ONE, ONE_MINUS_SRC_ALPHA for alpha (imgui_impl_opengl3)
+static inline ImU32 blend(ImU32 dst, const float src[4], float alpha) {
+    float d[4];
+    unpack_color(dst, d);
+    const float keep = 1.0f - alpha;
+    const int r = (int)((src[0] * alpha + d[0] * keep) * 255.0f + 0.5f);
+    const int g = (int)((src[1] * alpha + d[1] * keep) * 255.0f + 0.5f);
+    const int b = (int)((src[2] * alpha + d[2] * keep) * 255.0f + 0.5f);
+    const int a = (int)((alpha + d[3] * keep) * 255.0f + 0.5f);
+    return IM_COL32(ImMin(r, 255), ImMin(g, 255), ImMin(b, 255), ImMin(a, 255));
+}
+
+static int raster_tile(Soft_Raster& r, const Soft_Raster_Texture& tex, int tile) {
+    const int tx0 = (tile % r.tiles_x) * SOFT_RASTER_TILE, ty0 = (tile / r.tiles_x) * SOFT_RASTER_TILE;
+    const int tx1 = ImMin(tx0 + SOFT_RASTER_TILE, r.width), ty1 = ImMin(ty0 + SOFT_RASTER_TILE, r.height);
+    if (!r.preserve)
+        for (int y = ty0; y < ty1; ++y)
+            for (int x = tx0; x < tx1; ++x) r.pixels[y * r.width + x] = r.clear;
+
+    int filled = 0;
+    for (int b = r.bin_start[tile]; b < r.bin_start[tile + 1]; ++b) {
+        const Soft_Raster_Triangle& t = r.triangles[r.bin_items[b]];
+        const int x0 = ImMax(t.min_x, tx0), x1 = ImMin(t.max_x, tx1 - 1);
+        const int y0 = ImMax(t.min_y, ty0), y1 = ImMin(t.max_y, ty1 - 1);
+
+        // Per edge: value at the first pixel center of a row, step per pixel, +1 where the top-left rule keeps w == 0
+        const int64_t step0 = -(t.y[2] - t.y[1]) * SUBPIXEL, step1 = -(t.y[0] - t.y[2]) * SUBPIXEL, step2 = -(t.y[1] - t.y[0]) * SUBPIXEL;
+        const int64_t bias0 = top_left(t.x[1], t.y[1], t.x[2], t.y[2]) ? 1 : 0;
+        const int64_t bias1 = top_left(t.x[2], t.y[2], t.x[0], t.y[0]) ? 1 : 0;
+        const int64_t bias2 = top_left(t.x[0], t.y[0], t.x[1], t.y[1]) ? 1 : 0;
+
+        float color[4] = { t.col[0][0], t.col[0][1], t.col[0][2], t.col[0][3] };
+        const float flat_coverage = t.constant_uv ? coverage(tex, t, t.u[0], t.v[0]) : 0.0f;
+        if (t.flat && t.constant_uv && color[3] * flat_coverage <= 0.0f) continue; // fully transparent
+
+        for (int y = y0; y <= y1; ++y) {
+            const int64_t px = ((int64_t)x0 << SUBPIXEL_BITS) + HALF_PIXEL, py = ((int64_t)y << SUBPIXEL_BITS) + HALF_PIXEL;
+            int64_t w0 = edge(t.x[1], t.y[1], t.x[2], t.y[2], px, py) + bias0;
+            int64_t w1 = edge(t.x[2], t.y[2], t.x[0], t.y[0], px, py) + bias1;
+            int64_t w2 = edge(t.x[0], t.y[0], t.x[1], t.y[1], px, py) + bias2;
+            ImU32* out = &r.pixels[y * r.width + x0];
+            for (int x = x0; x <= x1; ++x, ++out, w0 += step0, w1 += step1, w2 += step2) {
+                if (w0 <= 0 || w1 <= 0 || w2 <= 0) continue;
+                ++filled;
+                const float l1 = (float)(w1 - bias1) * t.inv_area, l2 = (float)(w2 - bias2) * t.inv_area, l0 = 1.0f - l1 - l2;
+                if (!t.flat)
+                    for (int c = 0; c < 4; ++c) color[c] = t.col[0][c] * l0 + t.col[1][c] * l1 + t.col[2][c] * l2;
+                const float cov = t.constant_uv ? flat_coverage
+                                                : coverage(tex, t, t.u[0] * l0 + t.u[1] * l1 + t.u[2] * l2, t.v[0] * l0 + t.v[1] * l1 + t.v[2] * l2);
+                const float alpha = color[3] * cov;
+                if (alpha > 0.0f) *out = blend(*out, color, alpha);
+            }
+        }
+    }
+    return filled;
+}
+
+void soft_raster_render(Soft_Raster& r, const ImDrawData* draw_data, const Soft_Raster_Texture& texture) {
+    const double start = raster_now_ms();
+    const ImVec2 scale  = draw_data->FramebufferScale;
+    const ImVec2 offset = draw_data->DisplayPos;
+    const int width  = (int)(draw_data->DisplaySize.x * scale.x);
+    const int height = (int)(draw_data->DisplaySize.y * scale.y);
+    if (width != r.width || height != r.height) soft_raster_resize(r, width, height);
+    if (r.width == 0 || r.height == 0) return;
+
+    r.triangles.resize(0);
+    for (int n = 0; n < draw_data->CmdListsCount; ++n) {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        for (const ImDrawCmd& cmd : cmd_list->CmdBuffer) {
+            if (cmd.UserCallback) continue;
+            // The backend's glScissor() rectangle, y counted from the bottom there
+            const ImVec2 clip_min((cmd.ClipRect.x - offset.x) * scale.x, (cmd.ClipRect.y - offset.y) * scale.y);
+            const ImVec2 clip_max((cmd.ClipRect.z - offset.x) * scale.x, (cmd.ClipRect.w - offset.y) * scale.y);
+            if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y) continue;
+            const int clip_x0 = ImMax(0, (int)clip_min.x), clip_x1 = ImMin(r.width,  (int)clip_min.x + (int)(clip_max.x - clip_min.x));
+            const int scissor_y1 = r.height - (int)((float)r.height - clip_max.y);
+            const int clip_y0 = ImMax(0, scissor_y1 - (int)(clip_max.y - clip_min.y)), clip_y1 = ImMin(r.height, scissor_y1);
+            if (clip_x1 <= clip_x0 || clip_y1 <= clip_y0) continue;
+
+            const bool textured = texture.alpha8 && cmd.GetTexID() == texture.id;
+            const ImDrawIdx* idx = cmd_list->IdxBuffer.Data + cmd.IdxOffset;
+            const ImDrawVert* vtx = cmd_list->VtxBuffer.Data + cmd.VtxOffset;
+            for (unsigned int i = 0; i + 2 < cmd.ElemCount; i += 3) {
+                const ImDrawVert* v[3] = { &vtx[idx[i]], &vtx[idx[i + 1]], &vtx[idx[i + 2]] };
+                setup_triangle(r, v, offset, scale, clip_x0, clip_y0, clip_x1, clip_y1, textured);
+            }
+        }
+    }
+    bin_triangles(r);
+
+    // NOTE(WALKER): Threads are started per frame, a few dozen microseconds next to milliseconds of fill. Whole tiles are the
+    //               unit of work, claimed off a counter, so a busy tile (the text heavy middle of the page) doesn't hold the rest.
+    const int tiles = r.tiles_x * r.tiles_y;
+    int threads = r.threads > 0 ? r.threads : (int)std::thread::hardware_concurrency();
+    threads = ImClamp(threads, 1, tiles);
+    std::atomic<int>       next_tile(0);
+    std::atomic<long long> filled(0);
+    auto work = [&]() {
+        long long local = 0;
+        for (int tile = next_tile++; tile < tiles; tile = next_tile++) local += raster_tile(r, texture, tile);
+        filled += local;
+    };
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threads; ++i) workers.emplace_back(work);
+    work();
+    for (std::thread& t : workers) t.join();
+
+    r.stats.last_ms         = raster_now_ms() - start;
+    r.stats.total_ms       += r.stats.last_ms;
+    r.stats.last_triangles  = r.triangles.Size;
+    r.stats.last_pixels     = (int)filled.load();
+    r.stats.triangles      += (unsigned long long)r.triangles.Size;
+    r.stats.pixels         += (unsigned long long)filled.load();
+    ++r.stats.frames;
+}
+
+//-----------------------------------------------------------------------------
+// PNG
+//-----------------------------------------------------------------------------
+
+static void put_u32_be(unsigned char* p, uint32_t v) {
+    p[0] = (unsigned char)(v >> 24); p[1] = (unsigned char)(v >> 16); p[2] = (unsigned char)(v >> 8); p[3] = (unsigned char)v;
+}
+static uint32_t get_u32_be(const unsigned char* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static bool png_chunk(FILE* f, const char* type, const unsigned char* data, uint32_t size) {
+    unsigned char header[8];
+    put_u32_be(header, size);
+    memcpy(header + 4, type, 4);
+    uLong crc = crc32(0L, (const Bytef*)type, 4);
+    if (size) crc = crc32(crc, data, size);
+    unsigned char trailer[4];
+    put_u32_be(trailer, (uint32_t)crc);
+    return fwrite(header, 1, 8, f) == 8 && (size == 0 || fwrite(data, 1, size, f) == size) && fwrite(trailer, 1, 4, f) == 4;
+}
+
+static const unsigned char PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+bool soft_raster_write_png(const char* path, const ImU32* pixels, int width, int height) {
+    if (width <= 0 || height <= 0) return false;
+    // Filter type 0 on every row: the compressor does fine on flat UI colors without the per row filter search
+    const size_t row = (size_t)width * 4 + 1;
+    std::vector<unsigned char> raw(row * (size_t)height);
+    for (int y = 0; y < height; ++y) {
+        unsigned char* out = &raw[row * (size_t)y];
+        out[0] = 0;
+        for (int x = 0; x < width; ++x) {
+            const ImU32 c = pixels[(size_t)y * width + x];
+            out[1 + 4 * x + 0] = (unsigned char)(c >> IM_COL32_R_SHIFT);
+            out[1 + 4 * x + 1] = (unsigned char)(c >> IM_COL32_G_SHIFT);
+            out[1 + 4 * x + 2] = (unsigned char)(c >> IM_COL32_B_SHIFT);
+            out[1 + 4 * x + 3] = (unsigned char)(c >> IM_COL32_A_SHIFT);
+        }
+    }
+    uLongf packed_size = compressBound((uLong)raw.size());
+    std::vector<unsigned char> packed(packed_size);
+    if (compress2(packed.data(), &packed_size, raw.data(), (uLong)raw.size(), 6) != Z_OK) return false;
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    defer { fclose(f); };
+    unsigned char ihdr[13];
+    put_u32_be(ihdr, (uint32_t)width);
+    put_u32_be(ihdr + 4, (uint32_t)height);
+    ihdr[8]  = 8; // bits per channel
+    ihdr[9]  = 6; // RGBA
+    ihdr[10] = ihdr[11] = ihdr[12] = 0; // deflate, adaptive filtering, not interlaced
+    return fwrite(PNG_SIGNATURE, 1, 8, f) == 8 && png_chunk(f, "IHDR", ihdr, 13) && png_chunk(f, "IDAT", packed.data(), (uint32_t)packed_size)
+        && png_chunk(f, "IEND", nullptr, 0);
+}
+
+static int paeth(int a, int b, int c) {
+    const int p = a + b - c, pa = ImAbs(p - a), pb = ImAbs(p - b), pc = ImAbs(p - c);
+    return pa <= pb && pa <= pc ? a : pb <= pc ? b : c;
+}
+
+bool soft_raster_read_png(const char* path, ImVector<ImU32>& pixels, int& width, int& height) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    defer { fclose(f); };
+    std::vector<unsigned char> file;
+    unsigned char buffer[65536];
+    for (size_t n; (n = fread(buffer, 1, sizeof(buffer), f)) > 0;) file.insert(file.end(), buffer, buffer + n);
+    if (file.size() < 8 || memcmp(file.data(), PNG_SIGNATURE, 8) != 0) {
+        fprintf(stderr, "[soft_raster] %s is not a PNG\n", path);
+        return false;
+    }
+
+    int channels = 0;
+    std::vector<unsigned char> packed;
+    width = height = 0;
+    for (size_t at = 8; at + 12 <= file.size();) {
+        const uint32_t size = get_u32_be(&file[at]);
+        const unsigned char* type = &file[at + 4];
+        const unsigned char* data = &file[at + 8];
+        if (size > file.size() - at - 12) break;
+        if (!memcmp(type, "IHDR", 4) && size == 13) {
+            width  = (int)get_u32_be(data);
+            height = (int)get_u32_be(data + 4);
+            channels = data[9] == 6 ? 4 : data[9] == 2 ? 3 : 0;
+            if (data[8] != 8 || !channels || data[12] != 0 || width <= 0 || height <= 0) {
+                fprintf(stderr, "[soft_raster] %s: only 8 bit RGB/RGBA non-interlaced PNGs are read\n", path);
+                return false;
+            }
+        } else if (!memcmp(type, "IDAT", 4)) {
+            packed.insert(packed.end(), data, data + size);
+        } else if (!memcmp(type, "IEND", 4)) {
+            break;
+        }
+        at += 12 + size;
+    }
+    if (!channels) return false;
+
+    const size_t stride = (size_t)width * channels;
+    std::vector<unsigned char> raw((stride + 1) * (size_t)height);
+    uLongf raw_size = (uLongf)raw.size();
+    if (uncompress(raw.data(), &raw_size, packed.data(), (uLong)packed.size()) != Z_OK || raw_size != raw.size()) {
+        fprintf(stderr, "[soft_raster] %s: bad image data\n", path);
+        return false;
+    }
+
+    // Undo the row filters in place, each row against the already unfiltered one above
+    for (int y = 0; y < height; ++y) {
+        unsigned char* line = &raw[(stride + 1) * (size_t)y];
+        const unsigned char* prior = y ? &raw[(stride + 1) * (size_t)(y - 1)] + 1 : nullptr;
+        const int filter = line[0];
+        unsigned char* cur = line + 1;
+        for (size_t i = 0; i < stride; ++i) {
+            const int a = i >= (size_t)channels ? cur[i - channels] : 0;
+            const int b = prior ? prior[i] : 0;
+            const int c = prior && i >= (size_t)channels ? prior[i - channels] : 0;
+            switch (filter) {
+            case 0: break;
+            case 1: cur[i] = (unsigned char)(cur[i] + a); break;
+            case 2: cur[i] = (unsigned char)(cur[i] + b); break;
+            case 3: cur[i] = (unsigned char)(cur[i] + ((a + b) >> 1)); break;
+            case 4: cur[i] = (unsigned char)(cur[i] + paeth(a, b, c)); break;
+            default:
+                fprintf(stderr, "[soft_raster] %s: unknown row filter %d\n", path, filter);
+                return false;
+            }
+        }
+    }
+
+    pixels.resize(width * height);
+    for (int y = 0; y < height; ++y) {
+        const unsigned char* in = &raw[(stride + 1) * (size_t)y + 1];
+        for (int x = 0; x < width; ++x, in += channels)
+            pixels[y * width + x] = IM_COL32(in[0], in[1], in[2], channels == 4 ? in[3] : 255);
+    }
+    return true;
+}
+
+Soft_Raster_Diff soft_raster_compare(const ImU32* a, const ImU32* b, int width, int height, int b_width, int b_height, int tolerance) {
+    Soft_Raster_Diff diff;
+    diff.size_matches = width == b_width && height == b_height;
+    if (!diff.size_matches || width <= 0 || height <= 0) return diff;
+    for (int i = 0; i < width * height; ++i) {
+        if (a[i] == b[i]) continue;
+        int worst = 0;
+        for (int shift = 0; shift < 32; shift += 8)
+            worst = ImMax(worst, ImAbs((int)((a[i] >> shift) & 0xFF) - (int)((b[i] >> shift) & 0xFF)));
+        diff.max_channel_diff = ImMax(diff.max_channel_diff, worst);
+        if (worst > tolerance) ++diff.differing_pixels;
+    }
+    diff.differing_ratio = (float)diff.differing_pixels / (float)(width * height);
+    return diff;
+}
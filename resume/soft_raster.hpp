@@ -0,0 +1,94 @@
+// NOTE(WALKER): CPU rasterizer for ImDrawData, for the headless build: frames and golden images on machines with no GPU and
+//               no browser. Does what imgui_impl_opengl3 does with the same draw data: textured, vertex colored triangles,
+//               scissored by ImDrawCmd::ClipRect, alpha blended (SRC_ALPHA, ONE_MINUS_SRC_ALPHA) into an RGBA8 framebuffer,
+//               the font atlas sampled bilinearly. In SDF mode the atlas is a distance field and coverage goes through the same
+//               smoothstep as sdf_text_shader.hpp.
+//
+//               Tile parallel: triangles are set up and binned into SOFT_RASTER_TILE sized tiles on the calling thread (in
+//               submission order), then worker threads take whole tiles. A tile only ever belongs to one thread and draws its
+//               triangles in order, so blending comes out the same whatever the thread count: the image is deterministic.
+//               Pixel centers at +0.5 with a top-left fill rule, shared edges are never drawn twice.
+//
+//               PNG in and out through zlib, for `make golden` (resume_headless --golden): every bench scenario's last frame is
+//               compared with a stored image, a pixel differs when any channel is off by more than the tolerance.
+
+#pragma once
+
+#include "imgui.h"
+#include <stdint.h>
+
+constexpr int SOFT_RASTER_TILE = 64;
+
+// The one texture this UI draws with. Texels are white, the atlas only holds coverage (or distance).
+struct Soft_Raster_Texture {
+    ImTextureID          id      = 0;
+    const unsigned char* alpha8  = nullptr;
+    int                  width   = 0;
+    int                  height  = 0;
+    bool                 sdf     = false;
+    float                smoothing = 0.1f; // fonts_sdf_smoothing() at the current scale
+};
+
+struct Soft_Raster_Stats {
+    double             last_ms        = 0.0; // soft_raster_render(), last frame
+    double             total_ms       = 0.0;
+    unsigned long long frames         = 0;
+    unsigned long long triangles      = 0;   // set up (after clip rect rejection)
+    unsigned long long pixels         = 0;   // fragments blended: the fill cost
+    int                last_triangles = 0;
+    int                last_pixels    = 0;
+};
+
+// Set up once on the calling thread, read by every tile it touches
+struct Soft_Raster_Triangle {
+    int64_t x[3], y[3];        // framebuffer position in 1/16 pixels, wound so the edge functions are positive inside
+    float inv_area;
+    float u[3], v[3];
+    float col[3][4];           // 0..1 straight alpha
+    int   min_x, min_y, max_x, max_y; // inclusive, already cut to the clip rect and the framebuffer
+    bool  textured;            // samples the atlas (anything else draws as a white texel)
+    bool  flat;                // one color for the three vertices
+    bool  constant_uv;         // one uv for the three vertices: solid fills on the white pixel, one texel fetch per triangle
+};
+
+struct Soft_Raster {
+    int             width   = 0;
+    int             height  = 0;
+    int             threads = 0;              // 0 = every hardware thread
+    ImU32           clear   = IM_COL32(115, 140, 153, 255); // resume.cpp's clear_color
+    ImVector<ImU32> pixels;                   // IM_COL32 layout (R in the low byte), row major, width * height
+    bool            preserve = false;         // keep the last frame, only what the draw data covers is drawn over (damage.hpp)
+
+    Soft_Raster_Stats stats;
+
+    // scratch, kept between frames
+    ImVector<Soft_Raster_Triangle> triangles;
+    ImVector<int>                  bin_start; // tile t's triangles are bin_items[bin_start[t]..bin_start[t + 1]), in submission order
+    ImVector<int>                  bin_items;
+    int                            tiles_x = 0, tiles_y = 0;
+};
+
+// Resizes (and clears) the framebuffer
+void soft_raster_resize(Soft_Raster& r, int width, int height);
+
+// Fills a rectangle (max exclusive) with the clear color, for redrawing part of a preserved frame
+void soft_raster_clear_rect(Soft_Raster& r, int x0, int y0, int x1, int y1);
+
+// Draws a whole frame: clear (unless preserve), then every command list. Callbacks other than ImDrawCallback_ResetRenderState are skipped
+// (the only ones this UI adds are GL state for the SDF shader, which texture.sdf stands in for).
+void soft_raster_render(Soft_Raster& r, const ImDrawData* draw_data, const Soft_Raster_Texture& texture);
+void soft_raster_free(Soft_Raster& r);
+
+// RGBA8 PNGs (alpha written as stored). Reading takes any 8 bit RGB/RGBA non-interlaced PNG, which covers images that went
+// through optimizers.
+bool soft_raster_write_png(const char* path, const ImU32* pixels, int width, int height);
+bool soft_raster_read_png(const char* path, ImVector<ImU32>& pixels, int& width, int& height);
+
+struct Soft_Raster_Diff {
+    bool  size_matches     = false;
+    int   differing_pixels = 0; // any channel off by more than the tolerance
+    int   max_channel_diff = 0;
+    float differing_ratio  = 0.0f;
+};
+
+Soft_Raster_Diff soft_raster_compare(const ImU32* a, const ImU32* b, int width, int height, int b_width, int b_height, int tolerance);
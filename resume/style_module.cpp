@@ -0,0 +1,85 @@
+#include "style_module.hpp"
+
+#include "imgui.h"
+#include "profiler.hpp"
+
+#if defined(__EMSCRIPTEN__) && defined(RESUME_SPLIT_MODULES)
+#include <dlfcn.h>
+#include <stdio.h>
+#include <emscripten.h>
+#endif
+
+Style_Module_Stats style_module_stats;
+
+static void (*style_editor)() = nullptr;
+
+#if defined(__EMSCRIPTEN__) && defined(RESUME_SPLIT_MODULES)
+static constexpr const char* STYLE_MODULE_PATH = "resume_style.wasm";
+
+static double load_start_ms = 0.0;
+static void (*loaded_callback)() = nullptr;
+
+// NOTE(WALKER): Resource timing knows what actually went over the wire for both modules, no need to guess
+EM_JS(double, resource_transfer_bytes, (const char* name), {
+    const suffix = UTF8ToString(name);
+    const entry = performance.getEntriesByType("resource").find(e => e.name.endsWith(suffix));
+    return entry ? (entry.encodedBodySize || entry.transferSize || 0) : 0;
+});
+
+static void style_module_loaded(void*, void* handle) {
+    style_editor = (void (*)())dlsym(handle, "resume_style_editor");
+    style_module_stats.state   = style_editor ? Style_Module_Ready : Style_Module_Failed;
+    style_module_stats.load_ms = profiler_now_ms() - load_start_ms;
+    style_module_stats.bytes   = resource_transfer_bytes(STYLE_MODULE_PATH);
+    printf("[style] %s linked in %.1f ms (%.1f KB)\n", STYLE_MODULE_PATH, style_module_stats.load_ms, style_module_stats.bytes / 1024.0);
+    if (loaded_callback) loaded_callback();
+}
+
+static void style_module_load_failed(void*) {
+    style_module_stats.state = Style_Module_Failed;
+    printf("[style] can't load %s: %s\n", STYLE_MODULE_PATH, dlerror());
+    if (loaded_callback) loaded_callback();
+}
+
+static void style_module_request(void (*on_loaded)()) {
+    style_module_stats.state = Style_Module_Loading;
+    loaded_callback = on_loaded;
+    load_start_ms   = profiler_now_ms();
+    emscripten_dlopen(STYLE_MODULE_PATH, RTLD_NOW, nullptr, style_module_loaded, style_module_load_failed);
+}
+#else
+static void show_style_editor() { ImGui::ShowStyleEditor(); }
+
+static void style_module_request(void (*)()) {
+    style_editor = show_style_editor;
+    style_module_stats.state = Style_Module_Ready;
+}
+#endif
+
+void style_module_show_editor(void (*on_loaded)()) {
+    if (style_module_stats.state == Style_Module_Not_Loaded)
+        style_module_request(on_loaded);
+
+    switch (style_module_stats.state) {
+    case Style_Module_Ready:   style_editor(); break;
+    case Style_Module_Failed:  ImGui::TextUnformatted("The style editor failed to load."); break;
+    default:                   ImGui::TextUnformatted("Loading the style editor..."); break;
+    }
+}
+
+void style_module_show_menu() {
+    Style_Module_Stats& s = style_module_stats;
+#if defined(__EMSCRIPTEN__) && defined(RESUME_SPLIT_MODULES)
+    if (s.main_bytes == 0.0) s.main_bytes = resource_transfer_bytes("resume.wasm");
+    ImGui::Text("resume.wasm:     %.1f KB", s.main_bytes / 1024.0);
+    switch (s.state) {
+    case Style_Module_Not_Loaded: ImGui::TextUnformatted("Style module:    not loaded (opens with the Style menu)"); break;
+    case Style_Module_Loading:    ImGui::TextUnformatted("Style module:    loading..."); break;
+    case Style_Module_Ready:      ImGui::Text("Style module:    %.1f KB, linked in %.1f ms", s.bytes / 1024.0, s.load_ms); break;
+    case Style_Module_Failed:     ImGui::TextUnformatted("Style module:    failed to load"); break;
+    }
+#else
+    (void)s;
+    ImGui::TextUnformatted("Style module:    linked into the main module");
+#endif
+}
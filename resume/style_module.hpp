@@ -0,0 +1,30 @@
+// NOTE(WALKER): The "Style" menu's editor is ImGui::ShowStyleEditor(), which lives in imgui_demo.cpp: the biggest file in
+//               the build and something most visitors never open. In the split web build (SPLIT_MODULES=1 in the Makefile)
+//               imgui_demo.cpp is not part of resume.wasm at all, it's the side module resume_style.wasm
+//               (style_side_module.cpp), fetched and linked with emscripten_dlopen() the first time the menu is opened.
+//               Everywhere else (native, headless, SPLIT_MODULES=0) the editor is linked in and this is a direct call.
+
+#pragma once
+
+enum Style_Module_State {
+    Style_Module_Not_Loaded,
+    Style_Module_Loading,
+    Style_Module_Ready,
+    Style_Module_Failed,
+};
+
+struct Style_Module_Stats {
+    Style_Module_State state      = Style_Module_Not_Loaded;
+    double             load_ms    = 0.0; // request -> linked
+    double             bytes      = 0.0; // side module download size (resource timing), 0 when unknown
+    double             main_bytes = 0.0; // resume.wasm download size, same source
+};
+
+extern Style_Module_Stats style_module_stats;
+
+// Draws the style editor, starting the load on first use. Until the module is linked it draws a placeholder.
+// on_loaded is called once when an async load finishes (e.g. to wake the frame pacer so the editor shows up).
+void style_module_show_editor(void (*on_loaded)());
+
+// Module sizes and load time for the "Performance" menu
+void style_module_show_menu();
@@ -0,0 +1,8 @@
+// NOTE(WALKER): Entry point of the resume_style.wasm side module (see style_module.hpp), linked together with imgui_demo.cpp.
+//               Everything ImGui comes from the main module at dlopen() time, this only has to export one C symbol.
+
+#include "imgui.h"
+
+extern "C" void resume_style_editor() {
+    ImGui::ShowStyleEditor();
+}
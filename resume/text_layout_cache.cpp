@@ -0,0 +1,275 @@
+#include "text_layout_cache.hpp"
+#include "fonts.hpp"
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <float.h>
+#include <string.h>
+
+Text_Layout_Cache_Stats text_layout_cache_stats;
+
+struct Cached_Line {
+    float y;          // top of the line relative to the text origin
+    int   first_quad;
+    int   quad_count;
+};
+
+struct Cached_Layout {
+    // key
+    const char* text;
+    int         length;
+    ImFont*     font;
+    float       font_size;
+    float       wrap_width;
+    // value
+    ImVec2      size;
+    float       line_height;
+    ImVector<Cached_Line> lines;
+    ImVector<Glyph_Quad>  quads;  // relative to the (truncated) text origin, at the cached font size
+    int         last_used_frame;
+};
+
+static ImVector<Cached_Layout*> layouts;
+static ImGuiStorage             layout_index; // key hash -> index into layouts
+static int                      atlas_generation = -1;
+
+static constexpr int EVICT_AFTER_FRAMES = 120;
+static constexpr int SWEEP_INTERVAL     = 60;
+
+static ImGuiID layout_hash(const char* text, int length, ImFont* font, float font_size, float wrap_width) {
+    struct { const char* text; int length; ImFont* font; float font_size; float wrap_width; } key;
+    memset(&key, 0, sizeof(key)); // padding bytes must hash the same every time
+    key.text = text; key.length = length; key.font = font; key.font_size = font_size; key.wrap_width = wrap_width;
+    return ImHashData(&key, sizeof(key));
+}
+
+static size_t layout_bytes(const Cached_Layout* l) {
+    return sizeof(Cached_Layout) + (size_t)l->lines.Capacity * sizeof(Cached_Line) + (size_t)l->quads.Capacity * sizeof(Glyph_Quad);
+}
+
+static void rebuild_index() {
+    layout_index.Clear();
+    for (int i = 0; i < layouts.Size; ++i) {
+        const Cached_Layout* l = layouts[i];
+        layout_index.SetInt(layout_hash(l->text, l->length, l->font, l->font_size, l->wrap_width), i);
+    }
+}
+
+void text_layout_cache_clear() {
+    for (Cached_Layout* l : layouts) IM_DELETE(l);
+    layouts.clear();
+    layout_index.Clear();
+    text_layout_cache_stats.entries = 0;
+    text_layout_cache_stats.bytes   = 0;
+}
+
+void text_layout_cache_new_frame() {
+    // Atlas rebuilt -> every cached UV/glyph metric is garbage
+    if (atlas_generation != font_state.atlas_builds) {
+        if (layouts.Size) ++text_layout_cache_stats.invalidations;
+        text_layout_cache_clear();
+        atlas_generation = font_state.atlas_builds;
+    }
+
+    const int frame = ImGui::GetFrameCount();
+    if (frame % SWEEP_INTERVAL != 0) return;
+    int kept = 0;
+    size_t bytes = 0;
+    for (int i = 0; i < layouts.Size; ++i) {
+        Cached_Layout* l = layouts[i];
+        if (frame - l->last_used_frame > EVICT_AFTER_FRAMES) {
+            IM_DELETE(l);
+            ++text_layout_cache_stats.evictions;
+            continue;
+        }
+        bytes += layout_bytes(l);
+        layouts[kept++] = l;
+    }
+    if (kept != layouts.Size) {
+        layouts.resize(kept);
+        rebuild_index();
+    }
+    text_layout_cache_stats.entries = layouts.Size;
+    text_layout_cache_stats.bytes   = bytes;
+}
+
+// NOTE(WALKER): Same walk as ImFont::RenderText() with word wrapping, minus the drawing: record where every glyph goes
+static void build_layout(Cached_Layout* l) {
+    ImFont* font = l->font;
+    const float scale = l->font_size / font->FontSize;
+    const float line_height = font->FontSize * scale;
+    const char* s = l->text;
+    const char* text_end = l->text + l->length;
+    const char* word_wrap_eol = nullptr;
+
+    l->line_height = line_height;
+    l->size = font->CalcTextSizeA(l->font_size, FLT_MAX, l->wrap_width, l->text, text_end, nullptr);
+    l->size.x = (float)(int)(l->size.x + 0.99999f); // same rounding as ImGui::CalcTextSize()
+
+    float x = 0.0f, y = 0.0f;
+    Cached_Line line = { 0.0f, 0, 0 };
+    auto new_line = [&]() {
+        line.quad_count = l->quads.Size - line.first_quad;
+        l->lines.push_back(line);
+        x = 0.0f;
+        y += line_height;
+        line.y = y;
+        line.first_quad = l->quads.Size;
+    };
+
+    while (s < text_end) {
+        if (l->wrap_width > 0.0f) {
+            if (!word_wrap_eol)
+                word_wrap_eol = font->CalcWordWrapPositionA(scale, s, text_end, l->wrap_width - x);
+            if (s >= word_wrap_eol) {
+                new_line();
+                word_wrap_eol = nullptr;
+                // Wrapping skips upcoming blanks (and one newline), same as RenderText()
+                while (s < text_end) {
+                    const char c = *s;
+                    if (c == ' ' || c == '\t') { s++; }
+                    else if (c == '\n')        { s++; break; }
+                    else                       { break; }
+                }
+                continue;
+            }
+        }
+
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80) s += 1;
+        else          s += ImTextCharFromUtf8(&c, s, text_end);
+
+        if (c < 32) {
+            if (c == '\n') { new_line(); continue; }
+            if (c == '\r') continue;
+        }
+
+        const ImFontGlyph* glyph = font->FindGlyph((ImWchar)c);
+        if (!glyph) continue;
+        if (glyph->Visible) {
+            Glyph_Quad q;
+            q.x0 = x + glyph->X0 * scale; q.y0 = y + glyph->Y0 * scale;
+            q.x1 = x + glyph->X1 * scale; q.y1 = y + glyph->Y1 * scale;
+            q.u0 = glyph->U0; q.v0 = glyph->V0; q.u1 = glyph->U1; q.v1 = glyph->V1;
+            l->quads.push_back(q);
+        }
+        x += glyph->AdvanceX * scale;
+    }
+    line.quad_count = l->quads.Size - line.first_quad;
+    l->lines.push_back(line);
+}
+
+static void emit_layout(ImDrawList* draw_list, const Cached_Layout* l, ImVec2 pos, ImU32 col) {
+    if ((col & IM_COL32_A_MASK) == 0 || l->quads.Size == 0) return;
+    const ImVec4& clip = draw_list->_CmdHeader.ClipRect;
+    const float ox = (float)(int)pos.x, oy = (float)(int)pos.y; // RenderText() truncates the origin
+
+    const bool push_texture = l->font->ContainerAtlas->TexID != draw_list->_CmdHeader.TextureId;
+    if (push_texture) draw_list->PushTextureID(l->font->ContainerAtlas->TexID);
+
+    for (const Cached_Line& line : l->lines) {
+        const float line_y = oy + line.y;
+        if (line_y + l->line_height < clip.y) continue; // above the clip rect
+        if (line_y > clip.w) break;                      // below it, nothing after can be visible either
+        if (line.quad_count == 0) continue;
+
+        draw_list->PrimReserve(line.quad_count * 6, line.quad_count * 4);
+        glyph_emit_quads(l->quads.Data + line.first_quad, line.quad_count, ImVec2(ox, oy), col,
+                         draw_list->_VtxWritePtr, draw_list->_IdxWritePtr, draw_list->_VtxCurrentIdx);
+        draw_list->_VtxWritePtr   += line.quad_count * 4;
+        draw_list->_IdxWritePtr   += line.quad_count * 6;
+        draw_list->_VtxCurrentIdx += (unsigned int)line.quad_count * 4;
+    }
+
+    if (push_texture) draw_list->PopTextureID();
+}
+
+void text_layout_cache_text_wrapped(const char* text, const char* text_end) {
+    if (!text_layout_cache_stats.enabled) {
+        ImGui::PushTextWrapPos(0.0f);
+        ImGui::TextUnformatted(text, text_end);
+        ImGui::PopTextWrapPos();
+        return;
+    }
+
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    if (window->SkipItems) return;
+    if (!text_end) text_end = text + strlen(text);
+
+    // Same item logic as TextWrapped() -> TextEx()
+    const float wrap_pos_x = window->DC.TextWrapPos >= 0.0f ? window->DC.TextWrapPos : 0.0f;
+    const ImVec2 text_pos(window->DC.CursorPos.x, window->DC.CursorPos.y + window->DC.CurrLineTextBaseOffset);
+    const float wrap_width = ImGui::CalcWrapWidthForPos(window->DC.CursorPos, wrap_pos_x);
+
+    const int length = (int)(text_end - text);
+    const ImGuiID key = layout_hash(text, length, g.Font, g.FontSize, wrap_width);
+    Cached_Layout* layout = nullptr;
+    const int found = layout_index.GetInt(key, -1);
+    if (found >= 0) {
+        Cached_Layout* l = layouts[found];
+        if (l->text == text && l->length == length && l->font == g.Font && l->font_size == g.FontSize && l->wrap_width == wrap_width)
+            layout = l;
+    }
+    if (layout) {
+        ++text_layout_cache_stats.hits;
+    } else {
+        ++text_layout_cache_stats.misses;
+        layout = IM_NEW(Cached_Layout)();
+        layout->text       = text;
+        layout->length     = length;
+        layout->font       = g.Font;
+        layout->font_size  = g.FontSize;
+        layout->wrap_width = wrap_width;
+        build_layout(layout);
+        if (found >= 0) {
+            // Hash collision with a different key: the newer one wins the slot
+            text_layout_cache_stats.bytes -= layout_bytes(layouts[found]);
+            IM_DELETE(layouts[found]);
+            layouts[found] = layout;
+        } else {
+            layout_index.SetInt(key, layouts.Size);
+            layouts.push_back(layout);
+        }
+        text_layout_cache_stats.entries = layouts.Size;
+        text_layout_cache_stats.bytes  += layout_bytes(layout);
+    }
+    layout->last_used_frame = ImGui::GetFrameCount();
+
+    const ImRect bb(text_pos, ImVec2(text_pos.x + layout->size.x, text_pos.y + layout->size.y));
+    ImGui::ItemSize(layout->size, 0.0f);
+    if (!ImGui::ItemAdd(bb, 0))
+        return;
+    emit_layout(window->DrawList, layout, bb.Min, ImGui::GetColorU32(ImGuiCol_Text));
+}
+
+void text_layout_cache_collect_quads(ImVector<Glyph_Quad>& out) {
+    out.resize(0);
+    for (const Cached_Layout* l : layouts)
+        for (const Glyph_Quad& q : l->quads) out.push_back(q);
+}
+
+void text_layout_cache_show_menu() {
+    auto& s = text_layout_cache_stats;
+    ImGui::Checkbox("Cache wrapped text layout", &s.enabled);
+    const auto lookups = s.hits + s.misses;
+    ImGui::Text("Layout cache:    %llu hits, %llu misses (%.1f%% hit)", s.hits, s.misses, lookups ? 100.0 * (double)s.hits / (double)lookups : 0.0);
+    ImGui::Text("Layout entries:  %d (%.1f KB), %llu evicted, %llu invalidations", s.entries, s.bytes / 1024.0, s.evictions, s.invalidations);
+
+    // NOTE(WALKER): Scalar vs SIMD quad emission on whatever text is cached right now, the same numbers `make emit-bench` prints natively
+    static Glyph_Emit_Bench bench;
+    if (GLYPH_EMIT_SIMD)
+        ImGui::Checkbox("SIMD glyph quads", &glyph_emit_stats.simd);
+    else
+        ImGui::TextDisabled("SIMD glyph quads: not in this build (make SIMD=1)");
+    ImGui::SameLine();
+    if (ImGui::SmallButton("Benchmark")) {
+        ImVector<Glyph_Quad> quads;
+        text_layout_cache_collect_quads(quads);
+        bench = glyph_emit_bench(quads.Data, quads.Size, 50);
+    }
+    ImGui::Text("Glyph emission:  %s, %llu quads so far", glyph_emit_simd_name(), glyph_emit_stats.quads);
+    if (bench.passes)
+        ImGui::Text("Emit benchmark:  %d quads, scalar %.2f ns/quad, SIMD %.2f ns/quad (%.2fx)%s", bench.quads, bench.scalar_ns, bench.simd_ns,
+                    bench.simd_ns > 0.0 ? bench.scalar_ns / bench.simd_ns : 0.0, bench.identical ? "" : ", OUTPUT DIFFERS");
+}
@@ -0,0 +1,38 @@
+// NOTE(WALKER): Cached layout for wrapped text.
+//               ImGui re-runs word wrapping and glyph lookups for every wrapped paragraph every frame (CalcTextSize() for the
+//               item size, then ImFont::RenderText() wraps the whole thing again to draw it), even though the text and the wrap
+//               width almost never change. This caches the result per (text, font, font size, wrap width): the item size,
+//               the line breaks, and the positioned glyph quads, so a hit is just a memcpy-ish emit of vertices.
+//               Entries are invalidated when the font atlas is rebuilt and evicted when they have not been used for a while
+//               (e.g. old wrap widths after a resize).
+
+#pragma once
+
+#include "imgui.h"
+#include "glyph_emit.hpp"
+
+struct Text_Layout_Cache_Stats {
+    unsigned long long hits          = 0;
+    unsigned long long misses        = 0;
+    unsigned long long invalidations = 0; // whole cache dropped (atlas rebuilt)
+    unsigned long long evictions     = 0; // entries dropped for not being used
+    int                entries       = 0;
+    size_t             bytes         = 0;
+    bool               enabled       = true;
+};
+
+extern Text_Layout_Cache_Stats text_layout_cache_stats;
+
+// Drop-in for ImGui::TextWrapped("%s", ...) / PushTextWrapPos(0)+TextUnformatted()+PopTextWrapPos().
+// The text must stay alive and unchanged at the same address while it is cached (e.g. strings in the content buffer).
+void text_layout_cache_text_wrapped(const char* text, const char* text_end);
+
+// Call once per frame (after ImGui::NewFrame()), handles atlas rebuild invalidation and eviction of stale entries.
+void text_layout_cache_new_frame();
+void text_layout_cache_clear();
+
+// Every glyph quad of every cached layout, the resume's real text for glyph_emit_bench()
+void text_layout_cache_collect_quads(ImVector<Glyph_Quad>& out);
+
+// Stats for the "Performance" menu
+void text_layout_cache_show_menu();
@@ -0,0 +1,174 @@
+// NOTE(WALKER): Build-time tool, compiled natively (not with emscripten).
+//               Writes an asset pack (layout in asset_pack_format.hpp): every file compressed on its own with the pack's LZ
+//               codec, stored as is when that doesn't make it smaller, behind an index of name, offset, sizes and checksum.
+//               Every entry is decompressed again and checked against its checksum before the tool reports success.
+//
+// Usage: asset_packer <output.pack> <name> <file> [<name> <file> ...]
+//        name is what the runtime looks the entry up by (asset_pack_find()), e.g. fonts/ProggyClean.ttf
+
+#include "asset_pack_format.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+struct Input {
+    const char* name;
+    const char* path;
+    std::string data;
+    std::string packed;
+    uint8_t     codec = Pack_Codec_Stored;
+};
+
+static bool read_file(const char* path, std::string& out) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.append(buf, n);
+    fclose(f);
+    return true;
+}
+
+static void lz_put_length(std::string& out, size_t length) {
+    while (length >= 255) {
+        out += (char)255;
+        length -= 255;
+    }
+    out += (char)length;
+}
+
+static void lz_put_sequence(std::string& out, const uint8_t* literals, size_t literal_count, size_t offset, size_t match) {
+    const size_t match_code = match ? match - PACK_LZ_MIN_MATCH : 0;
+    out += (char)(((literal_count < 15 ? literal_count : 15) << 4) | (match_code < 15 ? match_code : 15));
+    if (literal_count >= 15) lz_put_length(out, literal_count - 15);
+    out.append((const char*)literals, literal_count);
+    if (!match) return; // last sequence
+    out += (char)(offset & 0xFF);
+    out += (char)(offset >> 8);
+    if (match_code >= 15) lz_put_length(out, match_code - 15);
+}
+
+static uint32_t lz_read32(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+// Greedy, one candidate per hash bucket: a build step, speed doesn't matter much, decode speed does and that's fixed
+static std::string lz_compress(const std::string& input) {
+    constexpr int HASH_BITS = 16;
+    std::vector<int64_t> table((size_t)1 << HASH_BITS, -1);
+    const uint8_t* src = (const uint8_t*)input.data();
+    const size_t size = input.size();
+    std::string out;
+    size_t anchor = 0, i = 0;
+    while (i + PACK_LZ_MIN_MATCH <= size) {
+        const uint32_t seq = lz_read32(src + i);
+        const uint32_t h = (seq * 2654435761u) >> (32 - HASH_BITS);
+        const int64_t candidate = table[h];
+        table[h] = (int64_t)i;
+        if (candidate < 0 || i - (size_t)candidate > PACK_LZ_MAX_OFFSET || lz_read32(src + candidate) != seq) {
+            ++i;
+            continue;
+        }
+        size_t match = PACK_LZ_MIN_MATCH;
+        while (i + match < size && src[candidate + match] == src[i + match]) ++match;
+        lz_put_sequence(out, src + anchor, i - anchor, i - (size_t)candidate, match);
+        i += match;
+        anchor = i;
+    }
+    lz_put_sequence(out, src + anchor, size - anchor, 0, 0);
+    return out;
+}
+
+static void align4(std::string& out) {
+    while (out.size() % 4) out += '\0';
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4 || (argc - 2) % 2 != 0) {
+        fprintf(stderr, "usage: asset_packer <output.pack> <name> <file> [<name> <file> ...]\n");
+        return 1;
+    }
+    std::vector<Input> inputs;
+    for (int i = 2; i < argc; i += 2) {
+        Input in;
+        in.name = argv[i];
+        in.path = argv[i + 1];
+        if (!read_file(in.path, in.data)) { fprintf(stderr, "asset_packer: can't read %s\n", in.path); return 1; }
+        if (strlen(in.name) > 0xFFFF)     { fprintf(stderr, "asset_packer: name too long: %s\n", in.name); return 1; }
+        in.packed = lz_compress(in.data);
+        in.codec  = Pack_Codec_LZ;
+        if (in.packed.size() >= in.data.size()) {
+            in.packed = in.data;
+            in.codec  = Pack_Codec_Stored;
+        }
+        inputs.push_back(std::move(in));
+    }
+    if (inputs.size() > 0xFFFF) { fprintf(stderr, "asset_packer: too many entries\n"); return 1; }
+
+    // Header and index first, then the names, then the entry data
+    std::string names;
+    for (const Input& in : inputs) names += in.name;
+    Pack_Header header = {};
+    header.magic        = PACK_MAGIC;
+    header.version      = PACK_VERSION;
+    header.entry_count  = (uint16_t)inputs.size();
+    header.names_offset = (uint32_t)(sizeof(Pack_Header) + inputs.size() * sizeof(Pack_Entry));
+
+    std::string data;
+    std::vector<Pack_Entry> entries;
+    uint32_t name_offset = 0;
+    size_t   data_start  = header.names_offset + names.size();
+    data_start = (data_start + 3) & ~(size_t)3;
+    for (const Input& in : inputs) {
+        Pack_Entry e = {};
+        e.name_offset = name_offset;
+        e.name_length = (uint16_t)strlen(in.name);
+        e.codec       = in.codec;
+        e.offset      = (uint32_t)(data_start + data.size());
+        e.packed_size = (uint32_t)in.packed.size();
+        e.size        = (uint32_t)in.data.size();
+        e.checksum    = pack_checksum(in.data.data(), in.data.size());
+        entries.push_back(e);
+        name_offset += e.name_length;
+        data += in.packed;
+        align4(data);
+    }
+
+    std::string pack((const char*)&header, sizeof(header));
+    pack.append((const char*)entries.data(), entries.size() * sizeof(Pack_Entry));
+    pack += names;
+    align4(pack);
+    pack += data;
+    if (pack.size() > 0xFFFFFFFFu) { fprintf(stderr, "asset_packer: pack over 4 GB\n"); return 1; }
+    ((Pack_Header*)&pack[0])->total_size = (uint32_t)pack.size();
+
+    // Read it back the way the runtime will
+    size_t raw_total = 0;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const Pack_Entry& e = entries[i];
+        std::string check(e.size, '\0');
+        const uint8_t* src = (const uint8_t*)pack.data() + e.offset;
+        const bool ok = e.codec == Pack_Codec_Stored ? (memcpy(&check[0], src, e.size), true)
+                                                     : pack_lz_decompress(src, e.packed_size, (uint8_t*)&check[0], e.size);
+        if (!ok || pack_checksum(check.data(), check.size()) != e.checksum) {
+            fprintf(stderr, "asset_packer: %s doesn't read back\n", inputs[i].name);
+            return 1;
+        }
+        raw_total += e.size;
+        printf("  %-40s %9u -> %9u bytes (%5.1f%%) %s\n", inputs[i].name, e.size, e.packed_size,
+               e.size ? 100.0 * e.packed_size / e.size : 100.0, e.codec == Pack_Codec_LZ ? "lz" : "stored");
+    }
+
+    FILE* f = fopen(argv[1], "wb");
+    if (!f) { fprintf(stderr, "asset_packer: can't write %s\n", argv[1]); return 1; }
+    fwrite(pack.data(), 1, pack.size(), f);
+    fclose(f);
+
+    printf("asset_packer: %zu entries, %zu bytes -> %zu bytes (%.1f%%) in %s\n", inputs.size(), raw_total, pack.size(),
+           raw_total ? 100.0 * pack.size() / raw_total : 100.0, argv[1]);
+    return 0;
+}
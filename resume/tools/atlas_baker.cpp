@@ -0,0 +1,175 @@
+// NOTE(WALKER): Build-time tool, compiled natively (not with emscripten) and linked with ImGui, FreeType and fonts.cpp.
+//               Runs the same fonts_load() the runtime would for every bucket (the SDF atlas, and raster atlases baked at a
+//               few display sizes) and writes them into one blob (layout in font_atlas_format.hpp) that fonts_load_baked()
+//               puts straight into an ImFontAtlas on the client. Every bucket is read back through fonts_load_baked() and
+//               compared with what was baked before the tool reports success. Run it from resume/ (faces come from fonts/).
+//
+// Usage: atlas_baker [--sdf] [--raster 13]... gen/atlas/fonts.atlas
+
+#include "fonts.hpp"
+#include "font_atlas_format.hpp"
+
+#include "imgui.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+struct Baked_Bucket {
+    Atlas_Bucket             bucket = {};
+    std::vector<Atlas_Font>  fonts;
+    std::vector<Atlas_Glyph> glyphs;
+    std::vector<uint8_t>     pixels;
+};
+
+static bool bake_bucket(Font_Mode mode, float display_size, Baked_Bucket& out) {
+    ImGuiIO& io = ImGui::GetIO();
+    if (!fonts_load(io, mode, display_size)) return false;
+    fonts_finish_streaming(io); // every face, not just the first-frame one
+
+    ImFontAtlas* atlas = io.Fonts;
+    unsigned char* pixels = nullptr;
+    int tex_w = 0, tex_h = 0;
+    atlas->GetTexDataAsAlpha8(&pixels, &tex_w, &tex_h);
+    if (!pixels || tex_w > 0xFFFF || tex_h > 0xFFFF) return false;
+
+    Atlas_Bucket& b = out.bucket;
+    b.mode       = (uint8_t)mode;
+    b.bake_size  = font_state.bake_size;
+    b.tex_width  = (uint16_t)tex_w;
+    b.tex_height = (uint16_t)tex_h;
+    b.white_u    = atlas->TexUvWhitePixel.x;
+    b.white_v    = atlas->TexUvWhitePixel.y;
+    out.pixels.assign(pixels, pixels + (size_t)tex_w * tex_h);
+
+    for (const ImFont* font : atlas->Fonts) {
+        Atlas_Font f = {};
+        snprintf(f.name, sizeof(f.name), "%s", font->GetDebugName());
+        f.size        = font->FontSize;
+        f.ascent      = font->Ascent;
+        f.descent     = font->Descent;
+        f.first_glyph = (uint32_t)out.glyphs.size();
+        f.glyph_count = (uint32_t)font->Glyphs.Size;
+        for (const ImFontGlyph& glyph : font->Glyphs) {
+            Atlas_Glyph g;
+            g.codepoint = glyph.Codepoint;
+            g.advance_x = glyph.AdvanceX;
+            g.x0 = glyph.X0; g.y0 = glyph.Y0; g.x1 = glyph.X1; g.y1 = glyph.Y1;
+            g.u0 = glyph.U0; g.v0 = glyph.V0; g.u1 = glyph.U1; g.v1 = glyph.V1;
+            out.glyphs.push_back(g);
+        }
+        out.fonts.push_back(f);
+    }
+    b.font_count  = (uint16_t)out.fonts.size();
+    b.glyph_count = (uint32_t)out.glyphs.size();
+    return true;
+}
+
+template <typename T> static void append(std::vector<uint8_t>& out, const T* data, size_t count) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    out.insert(out.end(), bytes, bytes + sizeof(T) * count);
+}
+
+static std::vector<uint8_t> serialize(std::vector<Baked_Bucket>& buckets) {
+    std::vector<uint8_t> data;
+    size_t offset = sizeof(Atlas_Header) + sizeof(Atlas_Bucket) * buckets.size();
+    for (Baked_Bucket& b : buckets) {
+        b.bucket.offset = (uint32_t)offset;
+        b.bucket.size   = (uint32_t)(sizeof(Atlas_Font) * b.fonts.size() + sizeof(Atlas_Glyph) * b.glyphs.size() + b.pixels.size());
+        offset += (b.bucket.size + 3) & ~3u;
+    }
+
+    Atlas_Header header = {};
+    header.magic         = ATLAS_MAGIC;
+    header.version       = ATLAS_VERSION;
+    header.bucket_count  = (uint16_t)buckets.size();
+    header.total_size    = (uint32_t)offset;
+    header.bucket_offset = sizeof(Atlas_Header);
+    append(data, &header, 1);
+    for (const Baked_Bucket& b : buckets) append(data, &b.bucket, 1);
+    for (const Baked_Bucket& b : buckets) {
+        append(data, b.fonts.data(), b.fonts.size());
+        append(data, b.glyphs.data(), b.glyphs.size());
+        append(data, b.pixels.data(), b.pixels.size());
+        data.resize((data.size() + 3) & ~(size_t)3, 0);
+    }
+    return data;
+}
+
+// Loads the bucket back the way the client will and checks it's the atlas we baked
+static bool verify_bucket(const char* path, const Baked_Bucket& b) {
+    ImGuiIO& io = ImGui::GetIO();
+    if (!fonts_load_baked(io, path, (Font_Mode)b.bucket.mode, b.bucket.bake_size)) return false;
+    const ImFontAtlas* atlas = io.Fonts;
+    if (atlas->TexWidth != b.bucket.tex_width || atlas->TexHeight != b.bucket.tex_height ||
+        memcmp(atlas->TexPixelsAlpha8, b.pixels.data(), b.pixels.size()) != 0 || atlas->Fonts.Size != (int)b.fonts.size())
+        return false;
+    for (int i = 0; i < atlas->Fonts.Size; ++i) {
+        const ImFont* font = atlas->Fonts[i];
+        if (font->Glyphs.Size != (int)b.fonts[i].glyph_count || font->FontSize != b.fonts[i].size) return false;
+        for (int g = 0; g < font->Glyphs.Size; ++g) {
+            const ImFontGlyph& glyph = font->Glyphs[g];
+            const Atlas_Glyph& baked = b.glyphs[b.fonts[i].first_glyph + g];
+            if (glyph.Codepoint != baked.codepoint || glyph.U0 != baked.u0 || glyph.X0 != baked.x0 || glyph.AdvanceX != baked.advance_x)
+                return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const char* out_path = nullptr;
+    bool sdf = false;
+    std::vector<float> raster_sizes;
+    for (int i = 1; i < argc; ++i) {
+        if      (!strcmp(argv[i], "--sdf"))                     sdf = true;
+        else if (!strcmp(argv[i], "--raster") && i + 1 < argc) raster_sizes.push_back((float)atof(argv[++i]));
+        else out_path = argv[i];
+    }
+    if (!out_path || (!sdf && raster_sizes.empty())) {
+        fprintf(stderr, "usage: atlas_baker [--sdf] [--raster 13]... out.atlas\n");
+        return 1;
+    }
+
+    ImGui::CreateContext();
+    std::vector<Baked_Bucket> buckets;
+    bool ok = true;
+    if (sdf) {
+        buckets.emplace_back();
+        ok &= bake_bucket(Font_Mode_SDF, SDF_BAKE_SIZE, buckets.back());
+    }
+    for (float size : raster_sizes) {
+        buckets.emplace_back();
+        ok &= size > 0.0f && bake_bucket(Font_Mode_Raster, size, buckets.back());
+    }
+    if (!ok || buckets.size() > 16) { // fonts.cpp keeps at most 16 bucket entries
+        fprintf(stderr, "%s: error: atlas build failed\n", out_path);
+        ImGui::DestroyContext();
+        return 1;
+    }
+
+    const std::vector<uint8_t> data = serialize(buckets);
+    FILE* f = fopen(out_path, "wb");
+    if (!f) {
+        fprintf(stderr, "%s: error: can't write file\n", out_path);
+        ImGui::DestroyContext();
+        return 1;
+    }
+    fwrite(data.data(), 1, data.size(), f);
+    fclose(f);
+
+    for (const Baked_Bucket& b : buckets) {
+        if (!verify_bucket(out_path, b)) {
+            fprintf(stderr, "%s: error: the %s %.0fpx bucket doesn't load back identically\n", out_path,
+                    b.bucket.mode == Atlas_Mode_SDF ? "SDF" : "raster", b.bucket.bake_size);
+            remove(out_path);
+            ImGui::DestroyContext();
+            return 1;
+        }
+        printf("atlas_baker: %-6s %4.0fpx  %4dx%-4d %d fonts %5u glyphs\n", b.bucket.mode == Atlas_Mode_SDF ? "SDF" : "raster",
+               b.bucket.bake_size, b.bucket.tex_width, b.bucket.tex_height, b.bucket.font_count, b.bucket.glyph_count);
+    }
+    printf("atlas_baker: %zu bucket(s), %zu bytes -> %s\n", buckets.size(), data.size(), out_path);
+    ImGui::DestroyContext();
+    return 0;
+}
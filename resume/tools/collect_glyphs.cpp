@@ -0,0 +1,200 @@
+// NOTE(WALKER): Build-time tool, compiled natively (not with emscripten).
+//               Scans source files for every string literal, decodes them as UTF-8, adds the configured safety ranges,
+//               and writes out:
+//                 - a unicodes file for pyftsubset (one "U+XXXX-YYYY" range per line)
+//                 - a header with the same ranges as an ImWchar array for AddFontFromFileTTF()
+//               So the fonts we ship and the glyphs we ask FreeType for are always the exact same set.
+//
+// Usage: collect_glyphs --ranges 0x20-0x7E,0xA0-0xFF --unicodes out.txt --header out.h source_files...
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <string>
+#include <vector>
+#include <set>
+
+static std::set<unsigned> codepoints;
+
+static bool read_file(const char* path, std::string& out) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.append(buf, n);
+    fclose(f);
+    return true;
+}
+
+static void add_utf8(const std::string& bytes) {
+    for (size_t i = 0; i < bytes.size();) {
+        const unsigned char c = (unsigned char)bytes[i];
+        unsigned cp = c;
+        int extra = 0;
+        if      (c >= 0xF0) { cp = c & 0x07; extra = 3; }
+        else if (c >= 0xE0) { cp = c & 0x0F; extra = 2; }
+        else if (c >= 0xC0) { cp = c & 0x1F; extra = 1; }
+        ++i;
+        for (int k = 0; k < extra && i < bytes.size(); ++k, ++i)
+            cp = (cp << 6) | ((unsigned char)bytes[i] & 0x3F);
+        if (cp >= 0x20) codepoints.insert(cp);
+    }
+}
+
+static void add_codepoint_utf8(std::string& out, unsigned cp) {
+    if (cp < 0x80) { out += (char)cp; }
+    else if (cp < 0x800)   { out += (char)(0xC0 | (cp >> 6));  out += (char)(0x80 | (cp & 0x3F)); }
+    else if (cp < 0x10000) { out += (char)(0xE0 | (cp >> 12)); out += (char)(0x80 | ((cp >> 6) & 0x3F)); out += (char)(0x80 | (cp & 0x3F)); }
+    else { out += (char)(0xF0 | (cp >> 18)); out += (char)(0x80 | ((cp >> 12) & 0x3F)); out += (char)(0x80 | ((cp >> 6) & 0x3F)); out += (char)(0x80 | (cp & 0x3F)); }
+}
+
+// NOTE(WALKER): Just enough of a C++ lexer to find string literals: skips comments and char literals, handles escapes and raw strings
+static void scan_cpp(const std::string& src) {
+    const size_t n = src.size();
+    size_t i = 0;
+    while (i < n) {
+        const char c = src[i];
+        if (c == '/' && i + 1 < n && src[i + 1] == '/') {
+            while (i < n && src[i] != '\n') ++i;
+        } else if (c == '/' && i + 1 < n && src[i + 1] == '*') {
+            i += 2;
+            while (i + 1 < n && !(src[i] == '*' && src[i + 1] == '/')) ++i;
+            i += 2;
+        } else if (c == '\'') {
+            ++i;
+            while (i < n && src[i] != '\'') { if (src[i] == '\\') ++i; ++i; }
+            ++i;
+        } else if (c == 'R' && i + 1 < n && src[i + 1] == '"') {
+            const size_t open = src.find('(', i + 2);
+            if (open == std::string::npos) break;
+            const std::string close = ")" + src.substr(i + 2, open - (i + 2)) + "\"";
+            const size_t end = src.find(close, open + 1);
+            if (end == std::string::npos) break;
+            add_utf8(src.substr(open + 1, end - (open + 1)));
+            i = end + close.size();
+        } else if (c == '"') {
+            std::string lit;
+            ++i;
+            while (i < n && src[i] != '"') {
+                if (src[i] == '\\' && i + 1 < n) {
+                    const char e = src[++i];
+                    switch (e) {
+                    case 'n': case 't': case 'r': case '0': ++i; break; // control characters never need a glyph
+                    case 'x': {
+                        unsigned v = 0; ++i;
+                        while (i < n && isxdigit((unsigned char)src[i])) { const char h = src[i]; v = v * 16 + (unsigned)(h <= '9' ? h - '0' : (h | 0x20) - 'a' + 10); ++i; }
+                        lit += (char)v;
+                    } break;
+                    case 'u': case 'U': {
+                        const int digits = e == 'u' ? 4 : 8;
+                        const unsigned v = (unsigned)strtoul(src.substr(i + 1, digits).c_str(), nullptr, 16);
+                        add_codepoint_utf8(lit, v);
+                        i += 1 + digits;
+                    } break;
+                    default: lit += e; ++i; break;
+                    }
+                } else {
+                    lit += src[i++];
+                }
+            }
+            ++i;
+            add_utf8(lit);
+        } else {
+            ++i;
+        }
+    }
+}
+
+// NOTE(WALKER): Non C++ inputs (content source files, etc.) are taken verbatim, every character counts
+static void scan_text(const std::string& src) {
+    add_utf8(src);
+}
+
+static bool ends_with(const char* s, const char* suffix) {
+    const size_t ls = strlen(s), lx = strlen(suffix);
+    return ls >= lx && strcmp(s + ls - lx, suffix) == 0;
+}
+
+// "0x20-0x7E,0xA0-0xFF,0x2026"
+static bool add_ranges(const char* spec) {
+    std::string s = spec;
+    size_t start = 0;
+    while (start < s.size()) {
+        size_t comma = s.find(',', start);
+        if (comma == std::string::npos) comma = s.size();
+        const std::string item = s.substr(start, comma - start);
+        if (!item.empty()) {
+            char* end = nullptr;
+            const unsigned lo = (unsigned)strtoul(item.c_str(), &end, 0);
+            unsigned hi = lo;
+            if (*end == '-') hi = (unsigned)strtoul(end + 1, &end, 0);
+            if (*end != '\0' || hi < lo) {
+                fprintf(stderr, "collect_glyphs: bad range '%s'\n", item.c_str());
+                return false;
+            }
+            for (unsigned cp = lo; cp <= hi; ++cp) codepoints.insert(cp);
+        }
+        start = comma + 1;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const char* unicodes_path = nullptr;
+    const char* header_path   = nullptr;
+    std::vector<const char*> inputs;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--ranges") && i + 1 < argc) {
+            if (!add_ranges(argv[++i])) return 1;
+        } else if (!strcmp(argv[i], "--unicodes") && i + 1 < argc) {
+            unicodes_path = argv[++i];
+        } else if (!strcmp(argv[i], "--header") && i + 1 < argc) {
+            header_path = argv[++i];
+        } else {
+            inputs.push_back(argv[i]);
+        }
+    }
+    if (!unicodes_path || !header_path || inputs.empty()) {
+        fprintf(stderr, "usage: collect_glyphs [--ranges 0x20-0x7E,...] --unicodes out.txt --header out.h sources...\n");
+        return 1;
+    }
+
+    for (const char* path : inputs) {
+        std::string src;
+        if (!read_file(path, src)) {
+            fprintf(stderr, "collect_glyphs: can't read %s\n", path);
+            return 1;
+        }
+        if (ends_with(path, ".cpp") || ends_with(path, ".hpp") || ends_with(path, ".h")) scan_cpp(src);
+        else                                                                              scan_text(src);
+    }
+
+    // Collapse into [lo, hi] ranges. ImWchar is 16-bit unless IMGUI_USE_WCHAR32, so anything above the BMP is dropped.
+    std::vector<std::pair<unsigned, unsigned>> ranges;
+    for (unsigned cp : codepoints) {
+        if (cp > 0xFFFF) { fprintf(stderr, "collect_glyphs: dropping U+%X (outside 16-bit ImWchar)\n", cp); continue; }
+        if (!ranges.empty() && ranges.back().second + 1 == cp) ranges.back().second = cp;
+        else                                                   ranges.push_back({ cp, cp });
+    }
+
+    FILE* f = fopen(unicodes_path, "wb");
+    if (!f) { fprintf(stderr, "collect_glyphs: can't write %s\n", unicodes_path); return 1; }
+    for (auto& r : ranges) {
+        if (r.first == r.second) fprintf(f, "U+%04X\n", r.first);
+        else                     fprintf(f, "U+%04X-%04X\n", r.first, r.second);
+    }
+    fclose(f);
+
+    f = fopen(header_path, "wb");
+    if (!f) { fprintf(stderr, "collect_glyphs: can't write %s\n", header_path); return 1; }
+    fprintf(f, "// Generated by tools/collect_glyphs.cpp, do not edit. %zu codepoints in %zu ranges.\n", codepoints.size(), ranges.size());
+    fprintf(f, "#pragma once\n\n");
+    fprintf(f, "static const ImWchar RESUME_GLYPH_RANGES[] = {\n");
+    for (auto& r : ranges) fprintf(f, "    0x%04X, 0x%04X,\n", r.first, r.second);
+    fprintf(f, "    0,\n};\n");
+    fclose(f);
+
+    printf("collect_glyphs: %zu codepoints in %zu ranges from %zu files\n", codepoints.size(), ranges.size(), inputs.size());
+    return 0;
+}
@@ -0,0 +1,227 @@
+// NOTE(WALKER): Build-time tool, compiled natively (not with emscripten).
+//               Compiles the human editable content source (content/resume.txt, syntax documented at the top of that file)
+//               into the binary layout in content_format.hpp.
+//
+// Usage: content_compiler content/resume.txt gen/content/resume.bin
+
+#include "content_format.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+struct Compiler {
+    const char*                  path = nullptr;
+    std::vector<Content_Section> sections;
+    std::vector<Content_Node>    nodes;
+    std::vector<Content_Span>    spans;
+    std::string                  strings;
+    std::vector<uint32_t>        open_stack; // node indices whose subtree is still open, by depth
+    int                          errors = 0;
+};
+
+static void error(Compiler& c, int line, const char* msg, const std::string& context = "") {
+    fprintf(stderr, "%s:%d: error: %s%s%s\n", c.path, line, msg, context.empty() ? "" : ": ", context.c_str());
+    ++c.errors;
+}
+
+static Content_String add_string(Compiler& c, const std::string& s) {
+    Content_String result;
+    result.offset = (uint32_t)c.strings.size();
+    result.length = (uint32_t)s.size();
+    c.strings += s;
+    c.strings += '\0';
+    return result;
+}
+
+static std::string trim(const std::string& s) {
+    size_t b = 0, e = s.size();
+    while (b < e && (s[b] == ' ' || s[b] == '\t')) ++b;
+    while (e > b && (s[e - 1] == ' ' || s[e - 1] == '\t' || s[e - 1] == '\r')) --e;
+    return s.substr(b, e - b);
+}
+
+// Closes every open subtree at depth >= depth: their end is the next node we are about to add
+static void close_to_depth(Compiler& c, size_t depth) {
+    while (c.open_stack.size() > depth) {
+        c.nodes[c.open_stack.back()].end = (uint32_t)c.nodes.size();
+        c.open_stack.pop_back();
+    }
+}
+
+static void close_section(Compiler& c) {
+    close_to_depth(c, 0);
+    if (!c.sections.empty()) c.sections.back().end_node = (uint32_t)c.nodes.size();
+}
+
+// "plain text [label](url) more text" -> spans
+static bool parse_spans(Compiler& c, int line, const std::string& text, Content_Node& node) {
+    node.first_span = (uint32_t)c.spans.size();
+    std::string pending;
+    auto flush_text = [&]() {
+        if (pending.empty()) return;
+        Content_Span span = {};
+        span.kind = Content_Span_Text;
+        span.text = add_string(c, pending);
+        c.spans.push_back(span);
+        pending.clear();
+    };
+    for (size_t i = 0; i < text.size();) {
+        if (text[i] == '\\' && i + 1 < text.size() && (text[i + 1] == '[' || text[i + 1] == '\\')) {
+            pending += text[i + 1];
+            i += 2;
+            continue;
+        }
+        if (text[i] == '[') {
+            const size_t close = text.find("](", i);
+            const size_t end   = close == std::string::npos ? std::string::npos : text.find(')', close + 2);
+            if (end == std::string::npos) {
+                error(c, line, "unterminated link, expected [label](url)", text.substr(i));
+                return false;
+            }
+            flush_text();
+            Content_Span span = {};
+            span.kind = Content_Span_Link;
+            span.text = add_string(c, text.substr(i + 1, close - (i + 1)));
+            span.url  = add_string(c, text.substr(close + 2, end - (close + 2)));
+            c.spans.push_back(span);
+            i = end + 1;
+            continue;
+        }
+        pending += text[i++];
+    }
+    flush_text();
+    const size_t count = c.spans.size() - node.first_span;
+    if (count > 0xFFFF) {
+        error(c, line, "too many spans on one line");
+        return false;
+    }
+    node.span_count = (uint16_t)count;
+    return true;
+}
+
+static void compile_line(Compiler& c, int line, const std::string& raw) {
+    if (trim(raw).empty() || trim(raw)[0] == '#') return;
+
+    size_t indent = 0;
+    while (indent < raw.size() && raw[indent] == ' ') ++indent;
+    if (indent < raw.size() && raw[indent] == '\t') {
+        error(c, line, "tabs are not allowed for indentation, use 4 spaces");
+        return;
+    }
+    if (indent % 4 != 0) {
+        error(c, line, "indentation must be a multiple of 4 spaces");
+        return;
+    }
+    const size_t depth = indent / 4;
+
+    // keyword, then exactly one separator, the rest is taken verbatim (minus the line ending)
+    std::string rest = raw.substr(indent);
+    if (!rest.empty() && rest.back() == '\r') rest.pop_back();
+    const size_t space = rest.find(' ');
+    const std::string keyword = rest.substr(0, space);
+    const std::string body    = space == std::string::npos ? "" : rest.substr(space + 1);
+
+    if (keyword == "tab") {
+        if (depth != 0) { error(c, line, "tab must not be indented"); return; }
+        close_section(c);
+        Content_Section section = {};
+        size_t bar = body.find('|');
+        section.name = add_string(c, trim(body.substr(0, bar)));
+        while (bar != std::string::npos) {
+            const size_t next = body.find('|', bar + 1);
+            const std::string flag = trim(body.substr(bar + 1, next == std::string::npos ? std::string::npos : next - bar - 1));
+            if      (flag == "scroll")   section.flags |= Content_Section_Scroll;
+            else if (flag == "open_all") section.flags |= Content_Section_OpenAll;
+            else error(c, line, "unknown tab flag", flag);
+            bar = next;
+        }
+        section.first_node = section.end_node = (uint32_t)c.nodes.size();
+        c.sections.push_back(section);
+        return;
+    }
+
+    if (c.sections.empty()) { error(c, line, "content before the first tab"); return; }
+    if (depth > c.open_stack.size()) { error(c, line, "indented deeper than its parent"); return; }
+    if (depth > 255) { error(c, line, "nested too deep"); return; }
+    close_to_depth(c, depth);
+
+    Content_Node node = {};
+    node.depth = (uint8_t)depth;
+    if (keyword == "node") {
+        node.kind  = Content_Kind_Node;
+        node.label = add_string(c, body);
+        if (body.empty()) error(c, line, "node needs a label");
+    } else if (keyword == "text" || keyword == "bullet") {
+        node.kind = keyword == "text" ? Content_Kind_Text : Content_Kind_Bullet;
+        if (!parse_spans(c, line, body, node)) return;
+    } else if (keyword == "newline") {
+        node.kind = Content_Kind_NewLine;
+    } else {
+        error(c, line, "unknown keyword", keyword);
+        return;
+    }
+    node.end = (uint32_t)c.nodes.size() + 1;
+    c.nodes.push_back(node);
+    if (node.kind != Content_Kind_NewLine) c.open_stack.push_back((uint32_t)c.nodes.size() - 1);
+}
+
+static uint32_t align4(uint32_t v) { return (v + 3u) & ~3u; }
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: content_compiler <source.txt> <output.bin>\n");
+        return 1;
+    }
+    Compiler c;
+    c.path = argv[1];
+
+    FILE* in = fopen(c.path, "rb");
+    if (!in) { fprintf(stderr, "content_compiler: can't read %s\n", c.path); return 1; }
+    std::string src;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0) src.append(buf, n);
+    fclose(in);
+
+    int line = 1;
+    for (size_t start = 0; start < src.size();) {
+        size_t end = src.find('\n', start);
+        if (end == std::string::npos) end = src.size();
+        compile_line(c, line++, src.substr(start, end - start));
+        start = end + 1;
+    }
+    close_section(c);
+    if (c.errors) return 1;
+    if (c.sections.empty()) { fprintf(stderr, "%s: error: no tabs\n", c.path); return 1; }
+
+    Content_Header header = {};
+    header.magic          = CONTENT_MAGIC;
+    header.version        = CONTENT_VERSION;
+    header.section_count  = (uint32_t)c.sections.size();
+    header.node_count     = (uint32_t)c.nodes.size();
+    header.span_count     = (uint32_t)c.spans.size();
+    header.string_bytes   = (uint32_t)c.strings.size();
+    header.section_offset = align4(sizeof(Content_Header));
+    header.node_offset    = align4(header.section_offset + header.section_count * sizeof(Content_Section));
+    header.span_offset    = align4(header.node_offset + header.node_count * sizeof(Content_Node));
+    header.string_offset  = align4(header.span_offset + header.span_count * sizeof(Content_Span));
+    header.total_size     = align4(header.string_offset + header.string_bytes);
+
+    std::vector<unsigned char> out(header.total_size, 0);
+    memcpy(&out[0], &header, sizeof(header));
+    if (!c.sections.empty()) memcpy(&out[header.section_offset], c.sections.data(), c.sections.size() * sizeof(Content_Section));
+    if (!c.nodes.empty())    memcpy(&out[header.node_offset],    c.nodes.data(),    c.nodes.size()    * sizeof(Content_Node));
+    if (!c.spans.empty())    memcpy(&out[header.span_offset],    c.spans.data(),    c.spans.size()    * sizeof(Content_Span));
+    memcpy(&out[header.string_offset], c.strings.data(), c.strings.size());
+
+    FILE* f = fopen(argv[2], "wb");
+    if (!f) { fprintf(stderr, "content_compiler: can't write %s\n", argv[2]); return 1; }
+    fwrite(out.data(), 1, out.size(), f);
+    fclose(f);
+
+    printf("content_compiler: %u tabs, %u nodes, %u spans, %u string bytes -> %u bytes\n",
+           header.section_count, header.node_count, header.span_count, header.string_bytes, header.total_size);
+    return 0;
+}
@@ -0,0 +1,170 @@
+// NOTE(WALKER): Build-time tool, compiled natively (not with emscripten).
+//               Renders the compiled content (gen/content/resume.bin, content_format.hpp) as plain HTML and splices it into the
+//               shell page, so the visitor reads the resume while resume.js/.wasm/.data are still downloading. resume.cpp
+//               removes it once the first ImGui frame is presented (static_content_swap()).
+//               Same structure as content.cpp draws: every tab is a <section> (stacked, with a list of anchors on top instead
+//               of a tab bar), node -> <details>, bullet -> <li>, links -> <a>. No script, no images, no web fonts: the page
+//               paints as soon as the HTML is parsed.
+//
+// Usage: content_html <resume.bin> <shell.html> <output.html>
+//        The HTML goes where the shell has STATIC_CONTENT_MARKER.
+
+#include "content_format.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+static const char* STATIC_CONTENT_MARKER = "<!-- STATIC_CONTENT -->";
+
+struct Content_View {
+    const Content_Header*  header   = nullptr;
+    const Content_Section* sections = nullptr;
+    const Content_Node*    nodes    = nullptr;
+    const Content_Span*    spans    = nullptr;
+    const char*            strings  = nullptr;
+};
+
+static bool read_file(const char* path, std::string& out) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.append(buf, n);
+    fclose(f);
+    return true;
+}
+
+// Header checks like the runtime loader in content.cpp
+static bool content_view(const std::string& file, Content_View& v) {
+    if (file.size() < sizeof(Content_Header)) return false;
+    v.header = (const Content_Header*)file.data();
+    const Content_Header& h = *v.header;
+    if (h.magic != CONTENT_MAGIC || h.version != CONTENT_VERSION || h.total_size > file.size()) return false;
+    if (h.section_offset + (uint64_t)h.section_count * sizeof(Content_Section) > h.total_size) return false;
+    if (h.node_offset    + (uint64_t)h.node_count    * sizeof(Content_Node)    > h.total_size) return false;
+    if (h.span_offset    + (uint64_t)h.span_count    * sizeof(Content_Span)    > h.total_size) return false;
+    if (h.string_offset  + (uint64_t)h.string_bytes                            > h.total_size) return false;
+    v.sections = (const Content_Section*)(file.data() + h.section_offset);
+    v.nodes    = (const Content_Node*)(file.data() + h.node_offset);
+    v.spans    = (const Content_Span*)(file.data() + h.span_offset);
+    v.strings  = file.data() + h.string_offset;
+    return true;
+}
+
+static void escape(std::string& out, const Content_View& v, Content_String s) {
+    for (const char* c = v.strings + s.offset, *end = c + s.length; c < end; ++c) {
+        switch (*c) {
+        case '&': out += "&amp;";  break;
+        case '<': out += "&lt;";   break;
+        case '>': out += "&gt;";   break;
+        case '"': out += "&quot;"; break;
+        default:  out += *c;       break;
+        }
+    }
+}
+
+static void emit_spans(std::string& out, const Content_View& v, const Content_Node& node) {
+    for (uint32_t i = node.first_span; i < node.first_span + node.span_count; ++i) {
+        const Content_Span& span = v.spans[i];
+        if (span.kind == Content_Span_Link) {
+            out += "<a href=\"";
+            escape(out, v, span.url);
+            out += "\" target=\"_blank\" rel=\"noopener\">";
+            escape(out, v, span.text);
+            out += "</a>";
+        } else {
+            escape(out, v, span.text);
+        }
+    }
+}
+
+// Nodes [first, end) are siblings (and their subtrees), consecutive bullets share one <ul>
+static void emit_nodes(std::string& out, const Content_View& v, uint32_t first, uint32_t end) {
+    bool in_list = false;
+    for (uint32_t i = first; i < end;) {
+        const Content_Node& node = v.nodes[i];
+        if (node.kind == Content_Kind_Bullet && !in_list) out += "<ul>\n";
+        if (node.kind != Content_Kind_Bullet && in_list)  out += "</ul>\n";
+        in_list = node.kind == Content_Kind_Bullet;
+
+        switch (node.kind) {
+        case Content_Kind_Text:
+            out += "<p>";
+            emit_spans(out, v, node);
+            out += "</p>\n";
+            if (node.end > i + 1) {
+                out += "<div class=\"indent\">\n";
+                emit_nodes(out, v, i + 1, node.end);
+                out += "</div>\n";
+            }
+            break;
+        case Content_Kind_Bullet:
+            out += "<li><p>";
+            emit_spans(out, v, node);
+            out += "</p>\n";
+            emit_nodes(out, v, i + 1, node.end);
+            out += "</li>\n";
+            break;
+        case Content_Kind_Node:
+            out += "<details><summary>";
+            escape(out, v, node.label);
+            out += "</summary>\n<div class=\"indent\">\n";
+            emit_nodes(out, v, i + 1, node.end);
+            out += "</div></details>\n";
+            break;
+        case Content_Kind_NewLine:
+            out += "<br>\n";
+            break;
+        }
+        i = node.end > i ? node.end : i + 1;
+    }
+    if (in_list) out += "</ul>\n";
+}
+
+static void emit_content(std::string& out, const Content_View& v) {
+    const Content_Header& h = *v.header;
+    out += "<div id=\"static-resume\">\n<nav>";
+    for (uint32_t s = 0; s < h.section_count; ++s) {
+        out += "<a href=\"#static-section-" + std::to_string(s) + "\">";
+        escape(out, v, v.sections[s].name);
+        out += "</a>";
+    }
+    out += "</nav>\n";
+    for (uint32_t s = 0; s < h.section_count; ++s) {
+        const Content_Section& section = v.sections[s];
+        out += "<section id=\"static-section-" + std::to_string(s) + "\"><h2>";
+        escape(out, v, section.name);
+        out += "</h2>\n";
+        emit_nodes(out, v, section.first_node, section.end_node);
+        out += "</section>\n";
+    }
+    out += "</div>";
+}
+
+int main(int argc, char** argv) {
+    if (argc != 4) {
+        fprintf(stderr, "usage: content_html <resume.bin> <shell.html> <output.html>\n");
+        return 1;
+    }
+    std::string content, shell;
+    if (!read_file(argv[1], content)) { fprintf(stderr, "content_html: can't read %s\n", argv[1]); return 1; }
+    if (!read_file(argv[2], shell))   { fprintf(stderr, "content_html: can't read %s\n", argv[2]); return 1; }
+
+    Content_View v;
+    if (!content_view(content, v)) { fprintf(stderr, "content_html: %s is not a version %u content file\n", argv[1], CONTENT_VERSION); return 1; }
+    const size_t marker = shell.find(STATIC_CONTENT_MARKER);
+    if (marker == std::string::npos) { fprintf(stderr, "content_html: %s has no %s\n", argv[2], STATIC_CONTENT_MARKER); return 1; }
+
+    std::string html;
+    emit_content(html, v);
+    shell.replace(marker, strlen(STATIC_CONTENT_MARKER), html);
+
+    FILE* f = fopen(argv[3], "wb");
+    if (!f) { fprintf(stderr, "content_html: can't write %s\n", argv[3]); return 1; }
+    fwrite(shell.data(), 1, shell.size(), f);
+    fclose(f);
+
+    printf("content_html: %u tabs, %u nodes -> %zu bytes of HTML in %s\n", v.header->section_count, v.header->node_count, html.size(), argv[3]);
+    return 0;
+}
@@ -0,0 +1,138 @@
+// NOTE(WALKER): Build-time tool, compiled natively (not with emscripten).
+//               Reads the import section of a wasm side module and writes every symbol it needs from the main module as a
+//               JSON list for -sEXPORTED_FUNCTIONS=@file. That lets the main module link with -sMAIN_MODULE=2 (dead code
+//               elimination on, only listed symbols exported) and still satisfy the side module when it's dlopen()ed later.
+//               Function imports come from "env", data and function addresses from "GOT.mem"/"GOT.func".
+//
+// Usage: wasm_imports --json out.json [--always _main]... side_module.wasm
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <set>
+
+static bool read_file(const char* path, std::vector<uint8_t>& out) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.insert(out.end(), buf, buf + n);
+    fclose(f);
+    return true;
+}
+
+struct Reader {
+    const uint8_t* p;
+    const uint8_t* end;
+    bool           ok = true;
+
+    uint8_t byte() {
+        if (p >= end) { ok = false; return 0; }
+        return *p++;
+    }
+    uint32_t leb() {
+        uint32_t result = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            const uint8_t b = byte();
+            result |= (uint32_t)(b & 0x7F) << shift;
+            if (!(b & 0x80)) return result;
+        }
+        ok = false;
+        return 0;
+    }
+    std::string name() {
+        const uint32_t length = leb();
+        if (!ok || (size_t)(end - p) < length) { ok = false; return ""; }
+        std::string s((const char*)p, length);
+        p += length;
+        return s;
+    }
+    void limits() {
+        const uint32_t flags = leb();
+        leb();
+        if (flags & 1) leb();
+    }
+};
+
+enum Import_Kind { Import_Func = 0, Import_Table = 1, Import_Memory = 2, Import_Global = 3, Import_Tag = 4 };
+
+static bool collect_imports(const std::vector<uint8_t>& wasm, std::set<std::string>& symbols) {
+    static const uint8_t header[8] = { 0x00, 'a', 's', 'm', 0x01, 0x00, 0x00, 0x00 };
+    if (wasm.size() < 8 || memcmp(wasm.data(), header, 8) != 0) return false;
+
+    Reader r = { wasm.data() + 8, wasm.data() + wasm.size() };
+    while (r.ok && r.p < r.end) {
+        const uint8_t  id   = r.byte();
+        const uint32_t size = r.leb();
+        if (!r.ok || (size_t)(r.end - r.p) < size) return false;
+        if (id != 2) { r.p += size; continue; } // only the import section matters
+
+        Reader s = { r.p, r.p + size };
+        const uint32_t count = s.leb();
+        for (uint32_t i = 0; i < count && s.ok; ++i) {
+            const std::string module = s.name();
+            const std::string field  = s.name();
+            const uint8_t     kind   = s.byte();
+            switch (kind) {
+            case Import_Func:   s.leb(); break;
+            case Import_Table:  s.byte(); s.limits(); break;
+            case Import_Memory: s.limits(); break;
+            case Import_Global: s.byte(); s.byte(); break;
+            case Import_Tag:    s.byte(); s.leb(); break;
+            default:            return false;
+            }
+            // env globals/memory/table are the dynamic linking ABI (__memory_base, __stack_pointer, ...), not symbols
+            const bool symbol = (module == "env" && kind == Import_Func) || module == "GOT.mem" || module == "GOT.func";
+            if (symbol) symbols.insert("_" + field);
+        }
+        return s.ok;
+    }
+    return r.ok;
+}
+
+int main(int argc, char** argv) {
+    const char* json_path = nullptr;
+    const char* wasm_path = nullptr;
+    std::set<std::string> symbols;
+    for (int i = 1; i < argc; ++i) {
+        if      (!strcmp(argv[i], "--json")   && i + 1 < argc) json_path = argv[++i];
+        else if (!strcmp(argv[i], "--always") && i + 1 < argc) symbols.insert(argv[++i]);
+        else wasm_path = argv[i];
+    }
+    if (!json_path || !wasm_path) {
+        fprintf(stderr, "usage: wasm_imports --json out.json [--always _main]... side_module.wasm\n");
+        return 1;
+    }
+
+    std::vector<uint8_t> wasm;
+    if (!read_file(wasm_path, wasm)) {
+        fprintf(stderr, "%s: error: can't read file\n", wasm_path);
+        return 1;
+    }
+    std::set<std::string> imports;
+    if (!collect_imports(wasm, imports)) {
+        fprintf(stderr, "%s: error: not a wasm module, or a malformed import section\n", wasm_path);
+        return 1;
+    }
+    const size_t always = symbols.size();
+    symbols.insert(imports.begin(), imports.end());
+
+    FILE* f = fopen(json_path, "wb");
+    if (!f) {
+        fprintf(stderr, "%s: error: can't write file\n", json_path);
+        return 1;
+    }
+    fprintf(f, "[");
+    bool first = true;
+    for (const std::string& s : symbols) {
+        fprintf(f, "%s\n\"%s\"", first ? "" : ",", s.c_str());
+        first = false;
+    }
+    fprintf(f, "\n]\n");
+    fclose(f);
+    printf("wasm_imports: %zu symbols imported by %s (+%zu always exported) -> %s\n", imports.size(), wasm_path, always, json_path);
+    return 0;
+}